@@ -0,0 +1,68 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#pragma once
+
+#ifndef SIGDIG_BATCH_HPP
+#define SIGDIG_BATCH_HPP
+
+#include "significant_column.hpp"
+
+namespace sigdig {
+
+class defined_value;
+
+// ----------------------------------------------------------------------------
+
+/** @class batch This class provides functions that do arithmetic and
+ comparisons on entire columns of significant values at once. Each function
+ follows the same significant digit rules as the operators in
+ significant_value, but without creating a calculated_value per element. Both
+ input columns must have the same size, and the result column is resized to
+ match them.
+ */
+
+class batch
+{
+public:
+
+    static void add( const column_view & augend, const column_view & addend,
+        significant_column & result );
+
+    static void add( const column_view & augend, const defined_value & addend,
+        significant_column & result );
+
+    static void subtract( const column_view & minuend,
+        const column_view & subtrahend, significant_column & result );
+
+    static void multiply( const column_view & multiplicand,
+        const column_view & factor, significant_column & result );
+
+    static void multiply( const column_view & multiplicand,
+        const defined_value & factor, significant_column & result );
+
+    static void divide( const column_view & dividend,
+        const column_view & divisor, significant_column & result );
+
+    /** Each result is true if the tolerance ranges of the two values overlap.
+     The results array must have room for as many values as are in the columns.
+     */
+    static void equals( const column_view & left, const column_view & right,
+        bool * results );
+
+    static void less_than( const column_view & left, const column_view & right,
+        bool * results );
+
+    static void greater_than( const column_view & left,
+        const column_view & right, bool * results );
+
+};
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
+
+#endif
@@ -10,6 +10,7 @@
 #define SIGDIG_CALCULATED_VALUE_HPP
 
 #include <string>
+#include <type_traits>
 
 #include "significant_value.hpp"
 
@@ -27,22 +28,36 @@ public:
     explicit calculated_value( long double value = 0.0L );
     explicit calculated_value( long value );
     explicit calculated_value( unsigned long value );
+    explicit calculated_value( long long value );
+    explicit calculated_value( unsigned long long value );
+#ifdef __SIZEOF_INT128__
+    explicit calculated_value( __int128 value );
+    explicit calculated_value( unsigned __int128 value );
+#endif
     explicit calculated_value( const char * value );
     explicit calculated_value( const std::string & value );
 
     calculated_value( long double value, unsigned int digits );
+    calculated_value( long double value, deferred_metadata deferred );
     calculated_value( long value, unsigned int digits );
     calculated_value( unsigned long value, unsigned int digits );
+    calculated_value( long long value, unsigned int digits );
+    calculated_value( unsigned long long value, unsigned int digits );
+#ifdef __SIZEOF_INT128__
+    calculated_value( __int128 value, unsigned int digits );
+    calculated_value( unsigned __int128 value, unsigned int digits );
+#endif
     calculated_value( const char * value, unsigned int digits );
     calculated_value( const std::string & value, unsigned int digits );
-    calculated_value( const calculated_value & that );
+    calculated_value( const calculated_value & that ) = default;
 
-    ~calculated_value();
+    ~calculated_value() = default;
 
     calculated_value & swap( calculated_value & that );
 
     calculated_value & assign( long double value );
     calculated_value & assign( long double value, unsigned int digits );
+    calculated_value & assign( long double value, deferred_metadata deferred );
     calculated_value & assign( long value );
     calculated_value & assign( long value, unsigned int digits );
     calculated_value & assign( unsigned long value );
@@ -59,7 +74,7 @@ public:
     calculated_value & operator = ( const char * value );
     calculated_value & operator = ( const std::string & value );
 
-    calculated_value & operator = ( const calculated_value & that );
+    calculated_value & operator = ( const calculated_value & that ) = default;
     calculated_value & operator = ( const defined_value & that );
 
     /// Declare the operator- function in base class as usable for this class to prevent shadowing.
@@ -75,15 +90,51 @@ public:
 
     calculated_value & operator += ( const significant_value & addend );
     calculated_value & operator += ( const defined_value & addend );
+    calculated_value & operator += ( long double addend );
+
+    template
+    <
+        typename T,
+        typename =
+            typename std::enable_if< std::is_arithmetic< T >::value, T >::type
+    > calculated_value & operator += ( T addend )
+    { return operator += ( static_cast< long double >( addend ) ); }
 
     calculated_value & operator -= ( const significant_value & subtrahend );
     calculated_value & operator -= ( const defined_value & subtrahend );
+    calculated_value & operator -= ( long double subtrahend );
+
+    template
+    <
+        typename T,
+        typename =
+            typename std::enable_if< std::is_arithmetic< T >::value, T >::type
+    > calculated_value & operator -= ( T subtrahend )
+    { return operator -= ( static_cast< long double >( subtrahend ) ); }
 
     calculated_value & operator *= ( const significant_value & factor );
     calculated_value & operator *= ( const defined_value & factor );
+    calculated_value & operator *= ( long double factor );
+
+    template
+    <
+        typename T,
+        typename =
+            typename std::enable_if< std::is_arithmetic< T >::value, T >::type
+    > calculated_value & operator *= ( T factor )
+    { return operator *= ( static_cast< long double >( factor ) ); }
 
     calculated_value & operator /= ( const significant_value & divisor );
     calculated_value & operator /= ( const defined_value & divisor );
+    calculated_value & operator /= ( long double divisor );
+
+    template
+    <
+        typename T,
+        typename =
+            typename std::enable_if< std::is_arithmetic< T >::value, T >::type
+    > calculated_value & operator /= ( T divisor )
+    { return operator /= ( static_cast< long double >( divisor ) ); }
 
     calculated_value & operator ++ ();
     calculated_value & operator -- ();
@@ -123,12 +174,53 @@ public:
 
 private:
 
-    friend class significant_value;
+    /// Only helper::make_calculated uses the private constructor from outside this class.
+    friend class helper;
 
     calculated_value( long double value, unsigned int digits, int exponent, int leastSigDig );
 
 };
 
+static_assert( std::is_trivially_copyable< calculated_value >::value, "calculated_value must be trivially copyable." );
+static_assert( std::is_standard_layout< calculated_value >::value, "calculated_value must have standard layout." );
+
+// ----------------------------------------------------------------------------
+
+// The scalar operator templates are declared in significant_value.hpp, but need
+// calculated_value to be a complete type, so they are defined here.
+
+template < typename T, typename >
+calculated_value significant_value::operator / ( T divisor ) const
+{ return operator / ( static_cast< long double >( divisor ) ); }
+
+template < typename T, typename >
+calculated_value significant_value::operator * ( T factor ) const
+{ return operator * ( static_cast< long double >( factor ) ); }
+
+template < typename T, typename >
+calculated_value significant_value::operator - ( T subtrahend ) const
+{ return operator - ( static_cast< long double >( subtrahend ) ); }
+
+template < typename T, typename >
+calculated_value significant_value::operator + ( T addend ) const
+{ return operator + ( static_cast< long double >( addend ) ); }
+
+template < typename T, typename >
+calculated_value operator / ( T dividend, const significant_value & divisor )
+{ return static_cast< long double >( dividend ) / divisor; }
+
+template < typename T, typename >
+calculated_value operator * ( T multiplier, const significant_value & factor )
+{ return static_cast< long double >( multiplier ) * factor; }
+
+template < typename T, typename >
+calculated_value operator - ( T minuend, const significant_value & subtrahend )
+{ return static_cast< long double >( minuend ) - subtrahend; }
+
+template < typename T, typename >
+calculated_value operator + ( T augend, const significant_value & addend )
+{ return static_cast< long double >( augend ) + addend; }
+
 // ----------------------------------------------------------------------------
 
 } // end namespace
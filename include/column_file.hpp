@@ -0,0 +1,105 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#pragma once
+
+#ifndef SIGDIG_COLUMN_FILE_HPP
+#define SIGDIG_COLUMN_FILE_HPP
+
+#include <cstddef>
+
+#include <string>
+#include <vector>
+
+#include "significant_column.hpp"
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+/// Statistics stored in a column file for each block of values.
+struct column_block_stats
+{
+    std::size_t first;                ///< Index of first value in the block.
+    std::size_t count;                ///< Number of values in the block.
+    long double min_value;
+    long double max_value;
+    unsigned int min_digits;
+    unsigned int max_digits;
+    unsigned int most_common_digits;  ///< Digit count shared by the most values in the block.
+    int min_exponent;                 ///< Lowest exponent of a most significant digit.
+    int max_exponent;                 ///< Highest exponent of a most significant digit.
+};
+
+// ----------------------------------------------------------------------------
+
+/** @class column_file This class writes significant values to a columnar
+ binary file. The file has a header, then one record per block of values, then
+ a section of values, a section of digit counts, and a section of exponents.
+ Each block record stores where its part of each section starts along with the
+ statistics for that block. Numbers are stored in the native byte order and
+ native long double format, so a file can only be read on the same kind of
+ platform that wrote it.
+ */
+
+class column_file
+{
+public:
+
+    static const std::size_t default_block_size = 65536;
+
+    static void write( const std::string & path, const column_view & column,
+        std::size_t block_size = default_block_size );
+
+};
+
+// ----------------------------------------------------------------------------
+
+/** @class mapped_column_file This maps a file written by column_file into
+ memory and provides read-only views of it. Nothing is parsed or copied, so the
+ views can be given directly to the batch functions. The views are only valid
+ while this object exists.
+ */
+
+class mapped_column_file
+{
+public:
+
+    explicit mapped_column_file( const std::string & path );
+
+    ~mapped_column_file();
+
+    inline std::size_t size() const { return view_.size(); }
+
+    inline std::size_t get_block_count() const { return blocks_.size(); }
+
+    const column_block_stats & get_block_stats( std::size_t block ) const;
+
+    /// Returns a view of every value in the file.
+    inline const column_view & view() const { return view_; }
+
+    /// Returns a view of just the values within one block.
+    column_view get_block( std::size_t block ) const;
+
+private:
+
+    mapped_column_file( const mapped_column_file & ) = delete;
+    mapped_column_file & operator = ( const mapped_column_file & ) = delete;
+
+    void unmap();
+
+    void * address_;
+    std::size_t length_;
+    column_view view_;
+    std::vector< column_block_stats > blocks_;
+
+};
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
+
+#endif
@@ -0,0 +1,90 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#pragma once
+
+#ifndef SIGDIG_COMPRESSED_COLUMN_HPP
+#define SIGDIG_COMPRESSED_COLUMN_HPP
+
+#include <cstddef>
+
+#include <vector>
+
+#include "packed_integers.hpp"
+#include "significant_column.hpp"
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+/** @class compressed_column Stores a column of significant values with the
+ digit counts and exponents encoded by packed_integers. The exact values are
+ stored as is. Digit counts and exponents barely vary within most columns, so
+ this usually needs a bit more than half the memory of a significant_column.
+ Single values can be read without decoding, and whole ranges can be decoded
+ into a significant_column for use with the batch functions.
+ */
+
+class compressed_column
+{
+public:
+
+    compressed_column();
+
+    explicit compressed_column( const column_view & column );
+
+    compressed_column( const compressed_column & that ) = default;
+
+    compressed_column & operator = ( const compressed_column & that ) = default;
+
+    inline std::size_t size() const { return values_.size(); }
+
+    inline bool empty() const { return values_.empty(); }
+
+    inline const long double * get_values() const { return values_.data(); }
+
+    inline long double get_exact_value( std::size_t index ) const
+    { return values_[ index ]; }
+
+    inline unsigned int get_digit_count( std::size_t index ) const
+    { return static_cast< unsigned int >( digits_.view().get( index ) ); }
+
+    inline int get_most_sigdig_exponent( std::size_t index ) const
+    { return exponents_.view().get( index ); }
+
+    /// Creates a calculated_value from the value at index.
+    calculated_value get( std::size_t index ) const;
+
+    /// Returns the encoded digit counts so they can be examined without decoding.
+    inline const packed_integers_view & get_digit_counts() const
+    { return digits_.view(); }
+
+    /// Returns the encoded exponents of the most significant digits.
+    inline const packed_integers_view & get_most_sigdig_exponents() const
+    { return exponents_.view(); }
+
+    /// Decodes count values starting at first into target, replacing its contents.
+    void decode( std::size_t first, std::size_t count, significant_column & target ) const;
+
+    /// Decodes every value into target, replacing its contents.
+    void decode( significant_column & target ) const;
+
+    /// Returns number of bytes used by the values and encoded metadata.
+    std::size_t get_byte_count() const;
+
+private:
+
+    std::vector< long double > values_;
+    packed_integers digits_;
+    packed_integers exponents_;
+
+};
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
+
+#endif
@@ -0,0 +1,166 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#pragma once
+
+#ifndef SIGDIG_DECIMAL_NUMBER_HPP
+#define SIGDIG_DECIMAL_NUMBER_HPP
+
+#include <string>
+
+#include "utility.hpp"
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+/// Layout of the IEEE 754 decimal64 format using binary integer decimal (BID) encoding.
+struct decimal64_traits
+{
+    typedef unsigned long long bits_type;
+    static const unsigned int total_bits = 64;
+    static const unsigned int exponent_bits = 10;
+    static const unsigned int max_digits = 16;
+    static const int exponent_bias = 398;
+};
+
+#ifdef __SIZEOF_INT128__
+
+/// Layout of the IEEE 754 decimal128 format using binary integer decimal (BID) encoding.
+struct decimal128_traits
+{
+    typedef unsigned __int128 bits_type;
+    static const unsigned int total_bits = 128;
+    static const unsigned int exponent_bits = 14;
+    static const unsigned int max_digits = 34;
+    static const int exponent_bias = 6176;
+};
+
+#endif
+
+// ----------------------------------------------------------------------------
+
+/** @class decimal_number A decimal floating point number stored in the IEEE 754
+ BID encoding: an integer coefficient and a power of ten. Unlike long double,
+ these store decimal values such as 0.1 exactly, and keep trailing zeros, so
+ 1.20 and 1.2 are equal but do not look the same. That makes counting
+ significant digits a matter of counting the digits in the coefficient, and
+ rounding to a number of digits a matter of integer division.
+ This is a self-contained software implementation. It only provides what SigDig
+ needs, which is parsing, rounding, comparing, and formatting - not arithmetic.
+ */
+
+template < typename Traits >
+class decimal_number
+{
+public:
+
+    typedef typename Traits::bits_type bits_type;
+    typedef typename Traits::bits_type coefficient_type;
+
+    static int get_lowest_exponent();
+    static int get_highest_exponent();
+    static coefficient_type get_max_coefficient();
+
+    /// Makes a positive zero.
+    decimal_number();
+
+    /** Makes a decimal number equal to coefficient * 10 ^ exponent. This throws
+     if coefficient has more digits than the format allows, or if exponent is
+     outside the format's range.
+     */
+    decimal_number( bool negative, coefficient_type coefficient, int exponent );
+
+    decimal_number( const decimal_number & that ) = default;
+
+    decimal_number & operator = ( const decimal_number & that ) = default;
+
+    /** Parses numbers in fixed or scientific notation such as "-0.00120" or
+     "1.20e+3" without going through binary floating point, so the result is
+     exact. This throws if the string has more digits than the format allows.
+     */
+    static decimal_number from_string( const char * source );
+
+    static decimal_number from_string( const std::string & source );
+
+    /// Makes the decimal number nearest to value with the requested number of digits.
+    static decimal_number from_value( long double value, unsigned int digits );
+
+    /// Makes a decimal number from its BID encoding. This throws if the encoding is not canonical.
+    static decimal_number from_bits( bits_type bits );
+
+    inline bits_type get_bits() const { return bits_; }
+
+    bool is_negative() const;
+
+    bool is_zero() const;
+
+    coefficient_type get_coefficient() const;
+
+    /// Returns the power of ten the coefficient is multiplied by.
+    int get_exponent() const;
+
+    /// Returns how many digits are in the coefficient, including any trailing zeros.
+    unsigned int get_digit_count() const;
+
+    /** Returns the number of significant digits. Every digit in the coefficient
+     is significant unless the exponent is zero, since then the number reads
+     as an integer and its trailing zeros are not, so 1.20 and 1.20E+3 have 3,
+     but 1200 has 2. The last digit of a zero is at its exponent, so 0.00 has 3.
+     */
+    unsigned int count_significant_digits() const;
+
+    /** Returns the exponent of the most significant digit, just as
+     utility::calculate_exponent does, except a zero with a positive exponent
+     returns that exponent, as in 0E+2.
+     */
+    int get_most_significant_exponent() const;
+
+    /// Returns this rounded to the requested number of digits.
+    decimal_number round_to_digits( unsigned int digits,
+        rounding_style rounding = rounding_style::round_half ) const;
+
+    long double to_long_double() const;
+
+    /// Writes all the digits in the coefficient. This throws for hexadecimal formats.
+    std::string to_string( format_style formatting = format_style::decimal_fixed ) const;
+
+    /// Returns -1, 0, or +1 if this is less than, equal to, or greater than that.
+    int compare( const decimal_number & that ) const;
+
+    inline bool operator == ( const decimal_number & that ) const { return compare( that ) == 0; }
+
+    inline bool operator != ( const decimal_number & that ) const { return compare( that ) != 0; }
+
+    inline bool operator < ( const decimal_number & that ) const { return compare( that ) < 0; }
+
+    inline bool operator > ( const decimal_number & that ) const { return compare( that ) > 0; }
+
+    inline bool operator <= ( const decimal_number & that ) const { return compare( that ) <= 0; }
+
+    inline bool operator >= ( const decimal_number & that ) const { return compare( that ) >= 0; }
+
+private:
+
+    explicit decimal_number( bits_type bits ) : bits_( bits ) {}
+
+    bits_type bits_;
+
+};
+
+// ----------------------------------------------------------------------------
+
+typedef decimal_number< decimal64_traits > decimal64;
+
+#ifdef __SIZEOF_INT128__
+typedef decimal_number< decimal128_traits > decimal128;
+#endif
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
+
+#endif
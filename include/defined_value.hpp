@@ -9,7 +9,9 @@
 #ifndef SIGDIG_DEFINED_VALUE_HPP
 #define SIGDIG_DEFINED_VALUE_HPP
 
+#include <memory_resource>
 #include <string>
+#include <type_traits>
 #include <ostream>
 
 #include "Utility.hpp"
@@ -28,16 +30,22 @@ public:
     explicit defined_value( long double value = 0.0L );
     explicit defined_value( long value );
     explicit defined_value( unsigned long value );
+    explicit defined_value( long long value );
+    explicit defined_value( unsigned long long value );
+#ifdef __SIZEOF_INT128__
+    explicit defined_value( __int128 value );
+    explicit defined_value( unsigned __int128 value );
+#endif
     explicit defined_value( const char * value );
     explicit defined_value( const std::string & value );
-    defined_value( const defined_value & that );
+    defined_value( const defined_value & that ) = default;
 
     defined_value & operator = ( long double value );
     defined_value & operator = ( long value );
     defined_value & operator = ( unsigned long value );
-    defined_value & operator = ( const defined_value & that );
+    defined_value & operator = ( const defined_value & that ) = default;
 
-    ~defined_value();
+    ~defined_value() = default;
 
     defined_value & swap( defined_value & that );
 
@@ -400,6 +408,18 @@ public:
         rounding_style rounding = rounding_style::round_half,
         bool show_decimal = false ) const;
 
+    /// These work like significant_value's to_string overloads that take a memory resource.
+    std::pmr::string to_string( std::pmr::memory_resource * resource,
+        format_style formatting = format_style::decimal_fixed,
+        rounding_style rounding = rounding_style::round_half,
+        bool show_decimal = false ) const;
+
+    std::pmr::string to_string( std::pmr::memory_resource * resource,
+        unsigned int digits,
+        format_style formatting = format_style::decimal_fixed,
+        rounding_style rounding = rounding_style::round_half,
+        bool show_decimal = false ) const;
+
 private:
 
     defined_value( long double value, int exponent );
@@ -411,6 +431,9 @@ private:
 
 };
 
+static_assert( std::is_trivially_copyable< defined_value >::value, "defined_value must be trivially copyable." );
+static_assert( std::is_standard_layout< defined_value >::value, "defined_value must have standard layout." );
+
 
 std::ostream & operator << ( std::ostream & os, const defined_value & value );
 
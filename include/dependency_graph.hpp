@@ -0,0 +1,148 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#pragma once
+
+#ifndef SIGDIG_DEPENDENCY_GRAPH_HPP
+#define SIGDIG_DEPENDENCY_GRAPH_HPP
+
+#include <cstddef>
+
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include "calculated_value.hpp"
+#include "defined_value.hpp"
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+/** @class dependency_graph A dataflow graph of significant values. Each node is
+ an input, a constant, or an operation on other nodes. When inputs change, only
+ the nodes that depend on them are calculated again, so the cost of an update
+ depends on how much of the graph it reaches rather than the size of the graph.
+ Each operation follows the same significant digit rules as the operators for
+ calculated_value and defined_value.
+
+ A node can only use nodes made before it, so the order of node ids is also a
+ topological order. Propagating takes the lowest dirty id off a min-heap, so
+ every node is calculated once, after all of its operands. If a node gets the
+ same value, digits, and exponent it had before, its dependents are not marked.
+
+ Several inputs can be staged and then propagated together, so nodes that
+ depend on more than one of them are only calculated once.
+ */
+
+class dependency_graph
+{
+public:
+
+    typedef std::size_t node_id;
+
+    enum class operation : unsigned char
+    {
+        negate,
+        add,
+        subtract,
+        multiply,
+        divide
+    };
+
+    dependency_graph();
+
+    dependency_graph( const dependency_graph & that ) = default;
+
+    dependency_graph & operator = ( const dependency_graph & that ) = default;
+
+    ~dependency_graph() = default;
+
+    inline std::size_t size() const { return nodes_.size(); }
+
+    node_id add_input( const significant_value & value );
+
+    node_id add_constant( const defined_value & value );
+
+    /** Adds a node for an operation on one or two earlier nodes. Use the
+     unary form for negate and the binary form for everything else. If every
+     operand is a constant, this returns a new constant node instead. These
+     throw std::out_of_range for an unknown node, and std::invalid_argument for
+     the wrong number of operands or for dividing by a constant zero.
+     */
+    node_id add_operation( operation op, node_id operand );
+
+    node_id add_operation( operation op, node_id left, node_id right );
+
+    /// Changes an input and propagates the change right away.
+    void set_input( node_id input, const significant_value & value );
+
+    /** Changes an input without propagating, so several changes can share one
+     pass. Values read before the next call to propagate may be out of date.
+     This throws std::invalid_argument if the node is not an input.
+     */
+    void stage_input( node_id input, const significant_value & value );
+
+    /** Calculates every node affected by staged inputs, and returns how many
+     nodes were calculated. If an operation throws, such as dividing by zero,
+     that node and any others not yet calculated stay dirty for the next call.
+     */
+    std::size_t propagate();
+
+    inline bool is_dirty() const { return !dirty_.empty(); }
+
+    bool is_constant( node_id node ) const;
+
+    bool is_input( node_id node ) const;
+
+    /** Returns the value of a node as of the last propagation. This throws
+     std::invalid_argument for a constant node, since constants have no digits.
+     */
+    calculated_value get_value( node_id node ) const;
+
+    /// This throws std::invalid_argument if the node is not a constant.
+    defined_value get_constant( node_id node ) const;
+
+private:
+
+    enum class node_kind : unsigned char
+    {
+        input,
+        constant,
+        unary,
+        binary
+    };
+
+    struct node
+    {
+        node_kind kind;
+        operation op;
+        node_id left;
+        node_id right;
+        long double constant;   ///< Only used by constant nodes.
+        calculated_value value; ///< Not used by constant nodes.
+    };
+
+    node_id add_node( const node & added );
+
+    void validate_node( node_id node ) const;
+
+    void mark_dependents( node_id node );
+
+    calculated_value calculate( const node & current ) const;
+
+    std::vector< node > nodes_;
+    std::vector< std::vector< node_id > > dependents_;
+    std::vector< bool > queued_;
+    std::priority_queue< node_id, std::vector< node_id >, std::greater< node_id > > dirty_;
+
+};
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
+
+#endif
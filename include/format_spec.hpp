@@ -0,0 +1,106 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#pragma once
+
+#ifndef SIGDIG_FORMAT_SPEC_HPP
+#define SIGDIG_FORMAT_SPEC_HPP
+
+#include <cfloat>
+#include <cstddef>
+
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "utility.hpp"
+
+namespace sigdig {
+
+class significant_value;
+class defined_value;
+class column_view;
+
+// ----------------------------------------------------------------------------
+
+/** @class format_spec Holds the styles for writing many values the same way,
+ such as every value in a column. The styles are checked, and the formatter
+ specialized for them is picked, once when the spec is made rather than once
+ per value.
+ */
+
+class format_spec
+{
+public:
+
+    /// The most chars any value can need, which is for the largest long double in fixed point format.
+    static const std::size_t max_length = LDBL_MAX_10_EXP + 8;
+
+    /// This throws if either style is invalid, or for hexadecimal since that style can not yet write significant digits.
+    explicit format_spec( format_style formatting = format_style::decimal_fixed,
+        rounding_style rounding = rounding_style::round_half, bool show_decimal = false );
+
+    format_spec( const format_spec & that ) = default;
+
+    format_spec & operator = ( const format_spec & that ) = default;
+
+    inline format_style get_format_style() const { return formatting_; }
+
+    inline rounding_style get_rounding_style() const { return rounding_; }
+
+    inline bool shows_decimal() const { return show_decimal_; }
+
+    /// Writes value with its own number of significant digits.
+    std::string format( const significant_value & value ) const;
+
+    std::string format( const significant_value & value, unsigned int digits ) const;
+
+    std::string format( const defined_value & value ) const;
+
+    std::string format( const defined_value & value, unsigned int digits ) const;
+
+    /// Writes each value in column into results, replacing what was in results.
+    void format( const column_view & column, std::vector< std::string > & results ) const;
+
+    /** Like the above, but each string allocates from the memory resource of
+     results, so a whole column of strings can live in one arena.
+     */
+    void format( const column_view & column, std::pmr::vector< std::pmr::string > & results ) const;
+
+    /** These write the value into target, which has room for capacity chars,
+     and return how many chars were written. They do not allocate memory or
+     add a terminating NIL char. They throw std::length_error if target is too
+     small, but max_length chars are always enough.
+     */
+    std::size_t write( const significant_value & value, char * target, std::size_t capacity ) const;
+
+    std::size_t write( const significant_value & value, unsigned int digits,
+        char * target, std::size_t capacity ) const;
+
+    std::size_t write( const defined_value & value, char * target, std::size_t capacity ) const;
+
+    std::size_t write( const defined_value & value, unsigned int digits,
+        char * target, std::size_t capacity ) const;
+
+private:
+
+    typedef std::size_t ( * writer )( long double value, int exponent, unsigned int digits,
+        bool show_decimal, char * target, std::size_t capacity );
+
+    std::string format( long double value, int exponent, unsigned int digits ) const;
+
+    format_style formatting_;
+    rounding_style rounding_;
+    bool show_decimal_;
+    writer writer_;
+
+};
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
+
+#endif
@@ -0,0 +1,126 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#pragma once
+
+#ifndef SIGDIG_FORMULA_HPP
+#define SIGDIG_FORMULA_HPP
+
+#include <cstddef>
+
+#include <string>
+#include <vector>
+
+#include "significant_column.hpp"
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+/** @class formula Parses an arithmetic expression such as "(p2 - p1) * k / t"
+ once, and then evaluates it over entire columns. Each name in the expression
+ refers to a column, and each number is a defined value, so it never limits the
+ number of significant digits. Parts of the expression that only use numbers
+ are folded into one number when the expression is parsed. The expression is
+ compiled into instructions that work on registers, and those instructions run
+ over blocks of rows at a time. Each operator follows the same significant
+ digit rules as the operators in significant_value.
+ The grammar has the usual precedence and left associativity.
+    expression := term { ( '+' | '-' ) term }
+    term       := unary { ( '*' | '/' ) unary }
+    unary      := ( '+' | '-' ) unary | primary
+    primary    := number | name | '(' expression ')'
+ A name starts with a letter or underscore, and may contain letters, digits,
+ and underscores. The constructor throws std::invalid_argument if the
+ expression has a syntax error, has no names in it, or divides by zero.
+ */
+
+class formula
+{
+public:
+
+    explicit formula( const std::string & expression );
+
+    formula( const formula & that ) = default;
+
+    formula & operator = ( const formula & that ) = default;
+
+    ~formula() = default;
+
+    /// Returns the names used in the expression, in the order they first appear.
+    inline const std::vector< std::string > & get_variable_names() const { return names_; }
+
+    /// Returns the index of a name within get_variable_names, or the number of names if it is not used.
+    std::size_t find_variable( const std::string & name ) const;
+
+    inline std::size_t get_instruction_count() const { return instructions_.size(); }
+
+    inline std::size_t get_register_count() const { return register_count_; }
+
+    /** Evaluates the expression for every row. There must be one column for
+     each name, in the same order as get_variable_names, and all the columns
+     must have the same size. The result column is resized to match them. This
+     throws std::invalid_argument if a row divides by zero.
+     */
+    void evaluate( const std::vector< column_view > & columns,
+        significant_column & result ) const;
+
+    /// How many rows each instruction processes before the next instruction runs.
+    static constexpr std::size_t block_size = 256;
+
+private:
+
+    enum class opcode : unsigned char
+    {
+        copy,
+        negate,
+        add,
+        subtract,
+        multiply,
+        divide
+    };
+
+    enum class operand_kind : unsigned char
+    {
+        none,
+        column,
+        constant,
+        register_slot
+    };
+
+    struct operand
+    {
+        operand_kind kind;
+        std::size_t index;
+    };
+
+    struct instruction
+    {
+        opcode code;
+        operand left;
+        operand right;
+        std::size_t target;
+    };
+
+    struct node;
+
+    class parser;
+
+    operand compile( const std::vector< node > & nodes, std::size_t index,
+        std::size_t first_free );
+
+    std::vector< instruction > instructions_;
+    std::vector< long double > constants_;
+    std::vector< std::string > names_;
+    std::size_t register_count_;
+
+};
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
+
+#endif
@@ -0,0 +1,81 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#pragma once
+
+#ifndef SIGDIG_INTERPOLATION_TABLE_HPP
+#define SIGDIG_INTERPOLATION_TABLE_HPP
+
+#include <cstddef>
+
+#include <vector>
+
+#include "significant_column.hpp"
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+/** @class interpolation_table A calibration table of breakpoints that
+ linearly interpolates between them. The result for x between breakpoints
+ ( x0, y0 ) and ( x1, y1 ) is y0 + ( x - x0 ) * ( y1 - y0 ) / ( x1 - x0 ),
+ with the same digits as if those operators were used on significant values.
+ The differences between neighboring breakpoints are figured when the table is
+ made, so each lookup only does one search, one subtraction, one
+ multiplication, one division, and one addition.
+
+ Lookups of a whole column walk forward from the previous breakpoint, so a
+ column sorted by x is done in one sweep through the table. Values outside
+ the table are not extrapolated.
+ */
+
+class interpolation_table
+{
+public:
+
+    /** Makes a table from breakpoints. The x values must be in strictly
+     increasing order, and there must be at least 2 breakpoints.
+     */
+    interpolation_table( const column_view & x, const column_view & y );
+
+    interpolation_table( const interpolation_table & that ) = default;
+
+    interpolation_table & operator = ( const interpolation_table & that ) = default;
+
+    inline std::size_t size() const { return x_.size(); }
+
+    inline long double get_lowest_x() const { return x_.view().get_exact_value( 0 ); }
+
+    inline long double get_highest_x() const { return x_.view().get_exact_value( x_.size() - 1 ); }
+
+    /// These throw if a value is outside the range of the breakpoints.
+    calculated_value interpolate( const significant_value & x ) const;
+
+    void interpolate( const column_view & x, significant_column & result ) const;
+
+private:
+
+    /// Returns the breakpoint just at or below value.
+    std::size_t find_segment( long double value ) const;
+
+    void interpolate( std::size_t segment, long double x, unsigned int x_digits,
+        int x_exponent, long double & value, unsigned int & digits,
+        int & exponent ) const;
+
+    significant_column x_;
+    significant_column y_;
+    std::vector< long double > rise_;           ///< y1 - y0 for each segment.
+    std::vector< unsigned int > rise_digits_;
+    std::vector< long double > run_;            ///< x1 - x0 for each segment.
+    std::vector< unsigned int > run_digits_;
+
+};
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
+
+#endif
@@ -0,0 +1,86 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#pragma once
+
+#ifndef SIGDIG_LINEAR_ALGEBRA_HPP
+#define SIGDIG_LINEAR_ALGEBRA_HPP
+
+#include <cstddef>
+
+#include "significant_column.hpp"
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+/** @class matrix_view A read-only view of a column of significant values as a
+ matrix stored one row after another. Like column_view, it does not own the
+ values.
+ */
+
+class matrix_view
+{
+public:
+
+    matrix_view();
+
+    /// Throws if elements does not have exactly rows times columns values.
+    matrix_view( const column_view & elements, std::size_t rows, std::size_t columns );
+
+    matrix_view( const matrix_view & that ) = default;
+
+    matrix_view & operator = ( const matrix_view & that ) = default;
+
+    inline std::size_t get_row_count() const { return rows_; }
+
+    inline std::size_t get_column_count() const { return columns_; }
+
+    inline const column_view & get_elements() const { return elements_; }
+
+    inline std::size_t get_index( std::size_t row, std::size_t column ) const
+    { return row * columns_ + column; }
+
+private:
+
+    column_view elements_;
+    std::size_t rows_;
+    std::size_t columns_;
+
+};
+
+// ----------------------------------------------------------------------------
+
+/** @class linear_algebra This class provides dot products and matrix
+ products of significant values. Each product has the fewer digits of its two
+ factors, and each sum keeps the highest least significant digit of its terms,
+ just like chaining operator * and operator +. Those rules are applied to each
+ output element while the sums are accumulated, so no calculated_value is made
+ for any intermediate result. The result of gemv and gemm is resized to hold
+ the output, and gemm stores its output one row after another.
+ */
+
+class linear_algebra
+{
+public:
+
+    static calculated_value dot( const column_view & left, const column_view & right );
+
+    /// Multiplies matrix by vector, which must have as many values as matrix has columns.
+    static void gemv( const matrix_view & matrix, const column_view & vector,
+        significant_column & result );
+
+    /// Multiplies left by right. The left matrix must have as many columns as the right has rows.
+    static void gemm( const matrix_view & left, const matrix_view & right,
+        significant_column & result );
+
+};
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
+
+#endif
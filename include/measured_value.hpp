@@ -10,8 +10,10 @@
 #define SIGDIG_MEASURED_VALUE_HPP
 
 #include <string>
+#include <type_traits>
 
 #include "significant_value.hpp"
+#include "decimal_number.hpp"
 
 namespace sigdig {
 
@@ -24,22 +26,41 @@ public:
     explicit measured_value( long double value = 0.0L );
     explicit measured_value( long value );
     explicit measured_value( unsigned long value );
+    explicit measured_value( long long value );
+    explicit measured_value( unsigned long long value );
+#ifdef __SIZEOF_INT128__
+    explicit measured_value( __int128 value );
+    explicit measured_value( unsigned __int128 value );
+#endif
+    /// Takes the value and number of significant digits from a decimal number, so both are exact.
+    explicit measured_value( const decimal64 & value );
+#ifdef __SIZEOF_INT128__
+    explicit measured_value( const decimal128 & value );
+#endif
     explicit measured_value( const char * value );
     explicit measured_value( const std::string & value );
 
     measured_value( long double value, unsigned int digits );
+    measured_value( long double value, deferred_metadata deferred );
     measured_value( long value, unsigned int digits );
     measured_value( unsigned long value, unsigned int digits );
+    measured_value( long long value, unsigned int digits );
+    measured_value( unsigned long long value, unsigned int digits );
+#ifdef __SIZEOF_INT128__
+    measured_value( __int128 value, unsigned int digits );
+    measured_value( unsigned __int128 value, unsigned int digits );
+#endif
     measured_value( const char * value, unsigned int digits );
     measured_value( const std::string & value, unsigned int digits );
-    measured_value( const measured_value & that );
+    measured_value( const measured_value & that ) = default;
 
-    ~measured_value();
+    ~measured_value() = default;
 
     measured_value & swap( measured_value & that );
 
     measured_value & assign( long double value );
     measured_value & assign( long double value, unsigned int digits );
+    measured_value & assign( long double value, deferred_metadata deferred );
     measured_value & assign( long value );
     measured_value & assign( long value, unsigned int digits );
     measured_value & assign( unsigned long value );
@@ -55,7 +76,7 @@ public:
     measured_value & operator = ( unsigned long value );
     measured_value & operator = ( const char * value );
     measured_value & operator = ( const std::string & value );
-    measured_value & operator = ( const measured_value & that );
+    measured_value & operator = ( const measured_value & that ) = default;
 
     /// Declare the operator- function in base class as usable for this class to prevent shadowing.
     using significant_value::operator -;
@@ -106,6 +127,9 @@ private:
 
 };
 
+static_assert( std::is_trivially_copyable< measured_value >::value, "measured_value must be trivially copyable." );
+static_assert( std::is_standard_layout< measured_value >::value, "measured_value must have standard layout." );
+
 // ----------------------------------------------------------------------------
 
 } // end namespace
@@ -0,0 +1,95 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#pragma once
+
+#ifndef SIGDIG_OPERATION_COUNTERS_HPP
+#define SIGDIG_OPERATION_COUNTERS_HPP
+
+#include <cstddef>
+
+#include <array>
+#include <string>
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+/** The operations SigDig can count. Counting only happens if the library is
+ built with SIGDIG_COUNTERS defined. Otherwise the counting code is compiled
+ out, so it costs nothing, and every count stays zero.
+ */
+enum class operation_counter : unsigned int
+{
+    measured_value_constructions,
+    calculated_value_constructions,
+    defined_value_constructions,
+    exponent_calculations,          ///< Calls to lookup::calculate_exponent.
+    digit_count_iterations,         ///< Loop iterations in utility::count_significant_digits.
+    decimal_fixed_strings,          ///< Values written in decimal_fixed format.
+    decimal_exponent_strings,       ///< Values written in decimal_exponent format.
+    hexadecimal_exponent_strings,   ///< Values written in hexadecimal_exponent format.
+    invalid_input_values,           ///< Exceptions thrown by helper::validate_input_value.
+    invalid_digit_counts            ///< Exceptions thrown by helper::validate_digit_count.
+};
+
+// ----------------------------------------------------------------------------
+
+/** @class counter_snapshot The counts of every operation at one moment. Each
+ thread counts into its own counters without locking or sharing cache lines,
+ and taking a snapshot adds together the counters of every thread, including
+ threads that already ended. A snapshot can be written as JSON or in the
+ Prometheus text format.
+ */
+
+class counter_snapshot
+{
+public:
+
+    static const std::size_t counter_count =
+        static_cast< std::size_t >( operation_counter::invalid_digit_counts ) + 1;
+
+    /// Returns true if the library was built with SIGDIG_COUNTERS defined.
+    static bool is_enabled();
+
+    /// Adds together the counts from all threads.
+    static counter_snapshot take();
+
+    /// Returns the name used for a counter in JSON and Prometheus output, such as "exponent_calculations".
+    static const char * get_name( operation_counter which );
+
+    /// Makes a snapshot with every count at zero.
+    counter_snapshot();
+
+    counter_snapshot( const counter_snapshot & that ) = default;
+
+    counter_snapshot & operator = ( const counter_snapshot & that ) = default;
+
+    inline unsigned long long get( operation_counter which ) const
+    {
+        return counts_[ static_cast< std::size_t >( which ) ];
+    }
+
+    /// Returns how much each count grew since an earlier snapshot.
+    counter_snapshot operator - ( const counter_snapshot & earlier ) const;
+
+    /// Writes a JSON object with one member per counter.
+    std::string to_json() const;
+
+    /// Writes each counter as a Prometheus counter named sigdig_<name>_total.
+    std::string to_prometheus() const;
+
+private:
+
+    std::array< unsigned long long, counter_count > counts_;
+
+};
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
+
+#endif
@@ -0,0 +1,145 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#pragma once
+
+#ifndef SIGDIG_PACKED_INTEGERS_HPP
+#define SIGDIG_PACKED_INTEGERS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <vector>
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+enum integer_encoding
+{
+    bit_packed = 0, ///< Each integer is stored as an offset from the minimum using as few bits as needed.
+    dictionary = 1, ///< Each integer is stored as a bit-packed index into a list of the distinct integers.
+    run_length = 2  ///< Each run of repeated integers is stored once along with where the run ends.
+};
+
+// ----------------------------------------------------------------------------
+
+/** @class packed_integers_view A read-only view of a sequence of integers
+ encoded by packed_integers. The encoded form is a series of 64-bit words with
+ a small header, so it can be stored in a file and viewed in place. All of the
+ functions here work on the encoded form without decoding the whole sequence.
+ */
+
+class packed_integers_view
+{
+public:
+
+    /// Number of 64-bit words in the header that starts every encoded sequence.
+    static const std::size_t header_words = 4;
+
+    packed_integers_view();
+
+    /** Makes a view of encoded words. This throws if the words do not hold a
+     valid encoding, or if the encoding needs more words than available.
+     */
+    packed_integers_view( const std::uint64_t * words, std::size_t available_words );
+
+    packed_integers_view( const packed_integers_view & that ) = default;
+
+    packed_integers_view & operator = ( const packed_integers_view & that ) = default;
+
+    inline std::size_t size() const { return count_; }
+
+    inline integer_encoding get_encoding() const { return encoding_; }
+
+    inline unsigned int get_bit_width() const { return width_; }
+
+    inline int minimum() const { return minimum_; }
+
+    inline int maximum() const { return maximum_; }
+
+    /// Returns how many 64-bit words the encoding uses, including the header.
+    inline std::size_t get_word_count() const { return word_count_; }
+
+    int get( std::size_t index ) const;
+
+    /// Decodes count integers starting at first into target.
+    void decode( std::size_t first, std::size_t count, int * target ) const;
+
+    void decode( std::size_t first, std::size_t count, unsigned int * target ) const;
+
+    /// Returns how many integers in the sequence equal value.
+    std::size_t count_equal( int value ) const;
+
+    /// Returns how many runs of repeated integers are in the sequence.
+    std::size_t count_runs() const;
+
+private:
+
+    template < typename T >
+    void decode_into( std::size_t first, std::size_t count, T * target ) const;
+
+    const std::uint64_t * words_;
+    std::size_t count_;
+    std::size_t entries_;
+    std::size_t word_count_;
+    integer_encoding encoding_;
+    unsigned int width_;
+    int minimum_;
+    int maximum_;
+
+};
+
+// ----------------------------------------------------------------------------
+
+/** @class packed_integers Encodes a sequence of integers such as digit counts
+ or exponents. Those barely vary within a column, so they usually need only a
+ few bits each. This picks whichever encoding is smallest.
+ */
+
+class packed_integers
+{
+public:
+
+    packed_integers();
+
+    packed_integers( const int * values, std::size_t count );
+
+    packed_integers( const unsigned int * values, std::size_t count );
+
+    packed_integers( const int * values, std::size_t count, integer_encoding encoding );
+
+    packed_integers( const packed_integers & that );
+
+    packed_integers & operator = ( const packed_integers & that );
+
+    inline std::size_t size() const { return view_.size(); }
+
+    inline const packed_integers_view & view() const { return view_; }
+
+    inline const std::vector< std::uint64_t > & get_words() const { return words_; }
+
+    /// Returns number of bytes used by the encoded form.
+    inline std::size_t get_byte_count() const
+    { return words_.size() * sizeof( std::uint64_t ); }
+
+    /// Returns the encoding which would need the fewest words for these integers.
+    static integer_encoding choose_encoding( const int * values, std::size_t count );
+
+private:
+
+    void encode( const int * values, std::size_t count, integer_encoding encoding );
+
+    std::vector< std::uint64_t > words_;
+    packed_integers_view view_;
+
+};
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
+
+#endif
@@ -0,0 +1,78 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#pragma once
+
+#ifndef SIGDIG_POLYNOMIAL_HPP
+#define SIGDIG_POLYNOMIAL_HPP
+
+#include <cstddef>
+
+#include <vector>
+
+#include "significant_column.hpp"
+
+namespace sigdig {
+
+class defined_value;
+
+// ----------------------------------------------------------------------------
+
+/** @class polynomial A polynomial whose coefficients may be defined values or
+ significant values, such as a calibration curve. The first coefficient is the
+ constant term, the next is multiplied by x, and so on.
+
+ Evaluation uses Horner's method. Each step multiplies by x and then adds the
+ next coefficient, applying the same digit rules as operator * and operator +
+ to a plain value, digit count, and exponent. No calculated_value is made for
+ any intermediate result. A polynomial with only a defined constant term gives
+ results with the digits of x.
+ */
+
+class polynomial
+{
+public:
+
+    polynomial();
+
+    explicit polynomial( const std::vector< defined_value > & coefficients );
+
+    explicit polynomial( const column_view & coefficients );
+
+    polynomial( const polynomial & that ) = default;
+
+    polynomial & operator = ( const polynomial & that ) = default;
+
+    /// Adds a coefficient for the next higher power of x.
+    void add_term( const defined_value & coefficient );
+
+    void add_term( const significant_value & coefficient );
+
+    inline std::size_t get_term_count() const { return values_.size(); }
+
+    /// These throw if the polynomial has no terms.
+    calculated_value evaluate( const significant_value & x ) const;
+
+    void evaluate( const column_view & x, significant_column & result ) const;
+
+private:
+
+    void evaluate( long double x, unsigned int x_digits, int x_exponent,
+        long double & value, unsigned int & digits, int & exponent ) const;
+
+    void validate_terms() const;
+
+    std::vector< long double > values_;
+    std::vector< unsigned int > digits_;     ///< Zero for defined coefficients.
+    std::vector< int > exponents_;           ///< Exponent of most significant digit.
+
+};
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
+
+#endif
@@ -0,0 +1,151 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#pragma once
+
+#ifndef SIGDIG_PRECISION_TELEMETRY_HPP
+#define SIGDIG_PRECISION_TELEMETRY_HPP
+
+#include <cstddef>
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+/// The arithmetic operations whose digits are recorded.
+enum class digit_operation : unsigned int
+{
+    add,
+    subtract,
+    multiply,
+    divide
+};
+
+// ----------------------------------------------------------------------------
+
+/** @class precision_histograms A snapshot of how many significant digits went
+ into and came out of each arithmetic operation, for each call site tag. The
+ input digits are the larger digit count of the operands, since that is the
+ precision the operation could have kept. A result that lost every digit, such
+ as the difference of two equal values, keeps 1 digit at the last place its
+ operands knew, so it is counted with 1 output digit.
+ */
+
+class precision_histograms
+{
+public:
+
+    static const unsigned int max_digits = 34;
+    static const std::size_t operation_count = 4;
+    static const std::size_t bins_per_operation = ( max_digits + 1 ) * ( max_digits + 1 );
+    static const std::size_t bins_per_tag = operation_count * bins_per_operation;
+
+    typedef std::array< unsigned long long, bins_per_tag > tag_bins;
+
+    precision_histograms( const std::vector< std::string > & names,
+        const std::vector< tag_bins > & counts );
+
+    precision_histograms( const precision_histograms & that ) = default;
+
+    precision_histograms & operator = ( const precision_histograms & that ) = default;
+
+    inline std::size_t get_tag_count() const { return names_.size(); }
+
+    /// This throws std::out_of_range if the tag is unknown.
+    const std::string & get_tag_name( unsigned int tag ) const;
+
+    unsigned long long get_count( unsigned int tag, digit_operation operation,
+        unsigned int input_digits, unsigned int output_digits ) const;
+
+    /// Returns how many operations had fewer output digits than input digits.
+    unsigned long long get_loss_count( unsigned int tag, digit_operation operation ) const;
+
+    /** Writes each tag with its nonzero bins as [input, output, count] triples,
+     grouped by operation.
+     */
+    std::string to_json() const;
+
+    /// Returns where the count for these digits is kept within a tag's bins.
+    static inline std::size_t get_bin( digit_operation operation, unsigned int input_digits,
+        int output_digits )
+    {
+        const unsigned int input = ( input_digits < max_digits ) ? input_digits : max_digits;
+        const unsigned int output = ( output_digits <= 0 ) ? 0 :
+            ( output_digits < static_cast< int >( max_digits ) ) ? static_cast< unsigned int >( output_digits ) :
+            max_digits;
+        return static_cast< std::size_t >( operation ) * bins_per_operation +
+            input * ( max_digits + 1 ) + output;
+    }
+
+private:
+
+    std::vector< std::string > names_;
+    std::vector< tag_bins > counts_;
+
+};
+
+// ----------------------------------------------------------------------------
+
+/** @class precision_telemetry Records how many significant digits each
+ arithmetic operation kept, so stages that destroy precision can be found
+ without a debugger. Recording only happens if the library is built with
+ SIGDIG_TELEMETRY defined. Otherwise the recording code is compiled out, and
+ every histogram stays empty.
+
+ Each thread records into its own histograms without locking, under the tag of
+ the innermost scope it is in, or the "untagged" tag if it is in none. Taking a
+ snapshot merges the histograms of every thread, including threads that ended.
+ */
+
+class precision_telemetry
+{
+public:
+
+    /// The tag used when a thread is not inside any scope.
+    static const unsigned int untagged = 0;
+
+    /// Returns true if the library was built with SIGDIG_TELEMETRY defined.
+    static bool is_enabled();
+
+    /// Returns the id of a call site tag, and adds it the first time the name is used.
+    static unsigned int find_tag( const std::string & name );
+
+    /// Merges the histograms from all threads.
+    static precision_histograms take();
+
+    /** @class scope Records operations done by this thread under a tag for as
+     long as the scope exists. Scopes may nest, and the previous tag comes back
+     when the inner scope ends. This throws std::out_of_range if the tag is unknown.
+     */
+    class scope
+    {
+    public:
+
+        explicit scope( unsigned int tag );
+
+        ~scope();
+
+        scope( const scope & ) = delete;
+
+        scope & operator = ( const scope & ) = delete;
+
+    private:
+
+        unsigned int previous_;
+
+    };
+
+};
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
+
+#endif
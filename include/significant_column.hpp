@@ -0,0 +1,146 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#pragma once
+
+#ifndef SIGDIG_SIGNIFICANT_COLUMN_HPP
+#define SIGDIG_SIGNIFICANT_COLUMN_HPP
+
+#include <cstddef>
+
+#include <memory_resource>
+#include <vector>
+
+#include "calculated_value.hpp"
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+/** @class column_view A read-only view of many significant values stored in
+ columns. The values, digit counts, and exponents are in separate arrays so
+ batch functions can walk each array without touching the others. A view does
+ not own the arrays it refers to. They may come from a significant_column or a
+ memory-mapped file.
+ */
+
+class column_view
+{
+public:
+
+    column_view();
+
+    column_view( const long double * values, const unsigned int * digits,
+        const int * exponents, std::size_t count );
+
+    column_view( const column_view & that ) = default;
+
+    column_view & operator = ( const column_view & that ) = default;
+
+    inline std::size_t size() const { return count_; }
+
+    inline bool empty() const { return count_ == 0; }
+
+    inline const long double * get_values() const { return values_; }
+
+    inline const unsigned int * get_digit_counts() const { return digits_; }
+
+    inline const int * get_most_sigdig_exponents() const { return exponents_; }
+
+    inline long double get_exact_value( std::size_t index ) const
+    { return values_[ index ]; }
+
+    inline unsigned int get_digit_count( std::size_t index ) const
+    { return digits_[ index ]; }
+
+    inline int get_most_sigdig_exponent( std::size_t index ) const
+    { return exponents_[ index ]; }
+
+    inline int get_least_sigdig_exponent( std::size_t index ) const
+    { return exponents_[ index ] - static_cast< int >( digits_[ index ] ) + 1; }
+
+    /// Returns a view of count values starting at first.
+    column_view slice( std::size_t first, std::size_t count ) const;
+
+    /// Creates a calculated_value from the value at index.
+    calculated_value get( std::size_t index ) const;
+
+private:
+
+    const long double * values_;
+    const unsigned int * digits_;
+    const int * exponents_;
+    std::size_t count_;
+
+};
+
+// ----------------------------------------------------------------------------
+
+/** @class significant_column Owns columns of significant values. Each value
+ is stored as its exact value, its number of significant digits, and the
+ exponent of its most significant digit. The exponent of the least significant
+ digit is not stored since it can be derived from the other two.
+
+ The columns allocate from a memory resource, which is the default resource
+ unless one is given. A copy uses the default resource, as std::pmr
+ containers do.
+ */
+
+class significant_column
+{
+public:
+
+    significant_column();
+
+    /// This throws std::invalid_argument if resource is null.
+    explicit significant_column( std::pmr::memory_resource * resource );
+
+    explicit significant_column( const column_view & that );
+
+    significant_column( const column_view & that, std::pmr::memory_resource * resource );
+
+    std::pmr::memory_resource * get_memory_resource() const
+    { return values_.get_allocator().resource(); }
+
+    std::size_t size() const { return values_.size(); }
+
+    bool empty() const { return values_.empty(); }
+
+    void reserve( std::size_t count );
+
+    void resize( std::size_t count );
+
+    void clear();
+
+    void push_back( const significant_value & value );
+
+    void push_back( long double value, unsigned int digits, int exponent );
+
+    void set( std::size_t index, long double value, unsigned int digits, int exponent );
+
+    calculated_value get( std::size_t index ) const;
+
+    column_view view() const;
+
+    long double * get_values() { return values_.data(); }
+
+    unsigned int * get_digit_counts() { return digits_.data(); }
+
+    int * get_most_sigdig_exponents() { return exponents_.data(); }
+
+private:
+
+    std::pmr::vector< long double > values_;
+    std::pmr::vector< unsigned int > digits_;
+    std::pmr::vector< int > exponents_;
+
+};
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
+
+#endif
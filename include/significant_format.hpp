@@ -0,0 +1,185 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#pragma once
+
+#ifndef SIGDIG_SIGNIFICANT_FORMAT_HPP
+#define SIGDIG_SIGNIFICANT_FORMAT_HPP
+
+// This provides formatters for std::format when the standard library has it,
+// and otherwise for the fmt library if it is available. If neither is, this
+// provides nothing, and SIGDIG_FORMAT_NAMESPACE is not defined.
+
+#if __has_include( <version> )
+    #include <version>
+#endif
+
+#if defined( __cpp_lib_format )
+    #include <format>
+    #define SIGDIG_FORMAT_NAMESPACE std
+#elif __has_include( <fmt/format.h> )
+    #include <fmt/format.h>
+    #define SIGDIG_FORMAT_NAMESPACE fmt
+#endif
+
+#ifdef SIGDIG_FORMAT_NAMESPACE
+
+#include <cstddef>
+
+#include <algorithm>
+#include <array>
+
+#include "format_spec.hpp"
+#include "significant_value.hpp"
+#include "measured_value.hpp"
+#include "calculated_value.hpp"
+#include "defined_value.hpp"
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+/** @struct format_options The parsed format spec for significant and defined
+ values. The spec has this form, and every part is optional.
+    [#][.digits][rounding][type]
+ # shows the decimal point even if no digits follow it.
+ .digits writes that many significant digits instead of the value's own count.
+ rounding is t for truncate, d for floor, h for round_half, u for ceiling, or
+  z for from_zero. The default is round_half.
+ type is f for decimal_fixed or e for decimal_exponent. The default is
+  decimal_fixed. Hexadecimal is not accepted since that style can not yet
+  write significant digits.
+ For example, "{:.3ue}" writes 3 digits in scientific notation rounded up.
+ */
+
+struct format_options
+{
+    format_style formatting = format_style::decimal_fixed;
+    rounding_style rounding = rounding_style::round_half;
+    unsigned int digits = 0; ///< Zero means use the value's own number of digits.
+    bool show_decimal = false;
+
+    template < typename Iterator >
+    constexpr Iterator parse( Iterator first, Iterator last )
+    {
+        if ( ( first != last ) && ( *first == '#' ) )
+        {
+            show_decimal = true;
+            ++first;
+        }
+        if ( ( first != last ) && ( *first == '.' ) )
+        {
+            ++first;
+            if ( ( first == last ) || ( *first < '0' ) || ( '9' < *first ) )
+            {
+                throw SIGDIG_FORMAT_NAMESPACE::format_error( "Error! Format spec needs digits after the dot." );
+            }
+            for ( ; ( first != last ) && ( '0' <= *first ) && ( *first <= '9' ); ++first )
+            {
+                digits = digits * 10 + static_cast< unsigned int >( *first - '0' );
+                if ( digits > 34 )
+                {
+                    throw SIGDIG_FORMAT_NAMESPACE::format_error( "Error! Format spec asks for more than 34 digits." );
+                }
+            }
+            if ( digits == 0 )
+            {
+                throw SIGDIG_FORMAT_NAMESPACE::format_error( "Error! Format spec can not ask for zero digits." );
+            }
+        }
+        if ( first != last )
+        {
+            switch ( *first )
+            {
+                case 't' : rounding = rounding_style::truncate;   ++first; break;
+                case 'd' : rounding = rounding_style::floor;      ++first; break;
+                case 'h' : rounding = rounding_style::round_half; ++first; break;
+                case 'u' : rounding = rounding_style::ceiling;    ++first; break;
+                case 'z' : rounding = rounding_style::from_zero;  ++first; break;
+                default: break;
+            }
+        }
+        if ( first != last )
+        {
+            switch ( *first )
+            {
+                case 'f' : formatting = format_style::decimal_fixed;    ++first; break;
+                case 'e' : formatting = format_style::decimal_exponent; ++first; break;
+                case 'a' :
+                    throw SIGDIG_FORMAT_NAMESPACE::format_error(
+                        "Error! Format spec can not use hexadecimal for significant values." );
+                default: break;
+            }
+        }
+        if ( ( first != last ) && ( *first != '}' ) )
+        {
+            throw SIGDIG_FORMAT_NAMESPACE::format_error( "Error! Invalid format spec for significant value." );
+        }
+        return first;
+    }
+};
+
+// ----------------------------------------------------------------------------
+
+/** @class value_formatter Formats a significant or defined value by writing
+ its chars into a buffer on the stack and copying them to the output iterator.
+ Unlike calling to_string, this never allocates memory.
+ */
+
+template < typename T >
+class value_formatter
+{
+public:
+
+    /// This is constexpr since C++20 parses format strings at compile time.
+    constexpr value_formatter() : options_() {}
+
+    template < typename ParseContext >
+    constexpr auto parse( ParseContext & context ) -> decltype( context.begin() )
+    {
+        return options_.parse( context.begin(), context.end() );
+    }
+
+    template < typename FormatContext >
+    auto format( const T & value, FormatContext & context ) const -> decltype( context.out() )
+    {
+        const format_spec spec( options_.formatting, options_.rounding, options_.show_decimal );
+        std::array< char, format_spec::max_length > chars;
+        const std::size_t size = ( options_.digits == 0 ) ?
+            spec.write( value, chars.data(), chars.size() ) :
+            spec.write( value, options_.digits, chars.data(), chars.size() );
+        return std::copy_n( chars.data(), size, context.out() );
+    }
+
+private:
+
+    format_options options_;
+
+};
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
+
+namespace SIGDIG_FORMAT_NAMESPACE {
+
+template <> struct formatter< sigdig::significant_value > :
+    sigdig::value_formatter< sigdig::significant_value > {};
+
+template <> struct formatter< sigdig::measured_value > :
+    sigdig::value_formatter< sigdig::significant_value > {};
+
+template <> struct formatter< sigdig::calculated_value > :
+    sigdig::value_formatter< sigdig::significant_value > {};
+
+template <> struct formatter< sigdig::defined_value > :
+    sigdig::value_formatter< sigdig::defined_value > {};
+
+} // end namespace
+
+#endif
+
+#endif
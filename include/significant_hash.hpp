@@ -0,0 +1,98 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#pragma once
+
+#ifndef SIGDIG_SIGNIFICANT_HASH_HPP
+#define SIGDIG_SIGNIFICANT_HASH_HPP
+
+#include <cstddef>
+
+#include <functional>
+
+#include "defined_value.hpp"
+#include "measured_value.hpp"
+#include "calculated_value.hpp"
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+inline std::size_t combine_hash( std::size_t seed, std::size_t hash )
+{
+    return seed ^ ( hash + 0x9e3779b97f4a7c15ULL + ( seed << 6 ) + ( seed >> 2 ) );
+}
+
+// ----------------------------------------------------------------------------
+
+/** @struct same_representation Checks if two values have the same exact value
+ and the same significant digits. Use this instead of operator == as the key
+ comparison of std::unordered_map or std::unordered_set, since operator ==
+ checks tolerance ranges and is not consistent with std::hash.
+ */
+
+struct same_representation
+{
+    inline bool operator () ( const significant_value & left,
+        const significant_value & right ) const
+    {
+        return ( left.get_exact_value() == right.get_exact_value() )
+            && ( left.get_digit_count() == right.get_digit_count() )
+            && ( left.get_most_sigdig_exponent() == right.get_most_sigdig_exponent() );
+    }
+
+    inline bool operator () ( const defined_value & left,
+        const defined_value & right ) const
+    { return left.get_value() == right.get_value(); }
+};
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
+
+namespace std {
+
+// ----------------------------------------------------------------------------
+
+/** Hashes the exact value and significant digits. Values which are equal by
+ tolerance usually have different hashes, so look in tolerance_hash_map to find
+ or group values by tolerance.
+ */
+
+template <>
+struct hash< sigdig::significant_value >
+{
+    inline std::size_t operator () ( const sigdig::significant_value & value ) const
+    {
+        std::size_t seed = std::hash< long double >()( value.get_exact_value() );
+        seed = sigdig::combine_hash( seed, value.get_digit_count() );
+        return sigdig::combine_hash( seed,
+            static_cast< std::size_t >( value.get_most_sigdig_exponent() ) );
+    }
+};
+
+template <>
+struct hash< sigdig::measured_value > : public hash< sigdig::significant_value >
+{
+};
+
+template <>
+struct hash< sigdig::calculated_value > : public hash< sigdig::significant_value >
+{
+};
+
+template <>
+struct hash< sigdig::defined_value >
+{
+    inline std::size_t operator () ( const sigdig::defined_value & value ) const
+    { return std::hash< long double >()( value.get_value() ); }
+};
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
+
+#endif
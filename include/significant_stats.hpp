@@ -0,0 +1,97 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#pragma once
+
+#ifndef SIGDIG_SIGNIFICANT_STATS_HPP
+#define SIGDIG_SIGNIFICANT_STATS_HPP
+
+#include <cstddef>
+
+#include "significant_column.hpp"
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+/** @class significant_stats Accumulates the count, mean, variance, minimum,
+ and maximum of a stream of significant values. Each sample updates a few
+ floating point numbers using Welford's algorithm, along with the highest
+ exponent of any least significant digit and the lowest digit count. Digits of
+ the results are only figured when a result is requested.
+
+ The mean has the digits that the sum of the samples would have, since the
+ sum is divided by an exact count. The variance and standard deviation have
+ the lowest digit count of the samples and the mean, as products would.
+ Accumulators filled by different threads can be merged.
+ */
+
+class significant_stats
+{
+public:
+
+    significant_stats();
+
+    significant_stats( const significant_stats & that ) = default;
+
+    significant_stats & operator = ( const significant_stats & that ) = default;
+
+    void add( const significant_value & value );
+
+    void add( long double value, unsigned int digits, int most_sigdig_exponent );
+
+    void add( const column_view & column );
+
+    /// Combines samples from that into this, as if they were added here.
+    void merge( const significant_stats & that );
+
+    void clear();
+
+    inline std::size_t size() const { return count_; }
+
+    inline bool empty() const { return count_ == 0; }
+
+    /// Returns highest exponent of any least significant digit among the samples.
+    inline int get_least_sigdig_exponent() const { return least_sigdig_exponent_; }
+
+    /// Returns lowest digit count among the samples.
+    inline unsigned int get_min_digit_count() const { return min_digits_; }
+
+    /// These functions throw if there are no samples.
+    calculated_value get_sum() const;
+    calculated_value get_mean() const;
+    calculated_value get_minimum() const;
+    calculated_value get_maximum() const;
+
+    /// These functions throw if there are fewer than two samples.
+    calculated_value get_variance() const;
+    calculated_value get_standard_deviation() const;
+
+private:
+
+    void validate_count( std::size_t needed ) const;
+
+    unsigned int calculate_mean_digits() const;
+
+    std::size_t count_;
+    long double mean_;
+    long double squared_distance_;  ///< Sum of squared distances from the mean.
+    int least_sigdig_exponent_;
+    unsigned int min_digits_;
+    long double min_value_;
+    unsigned int min_value_digits_;
+    int min_value_exponent_;
+    long double max_value_;
+    unsigned int max_value_digits_;
+    int max_value_exponent_;
+
+};
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
+
+#endif
@@ -9,7 +9,9 @@
 #ifndef SIGDIG_SIGNIFICANT_VALUE_HPP
 #define SIGDIG_SIGNIFICANT_VALUE_HPP
 
+#include <memory_resource>
 #include <string>
+#include <type_traits>
 #include <ostream>
 
 #include "utility.hpp"
@@ -19,6 +21,16 @@ namespace sigdig {
 class defined_value;
 class calculated_value;
 
+/** @struct deferred_metadata Pass this to a constructor or assign function
+ that takes a long double to skip counting the significant digits and finding
+ the exponents until something first needs them. This suits values that are
+ only stored and copied. Const functions calculate the digits and exponents
+ each time they need them without storing them, so a deferred value is safe to
+ read from many threads. Call resolve_metadata to store them once instead when
+ a value will be read many times.
+ */
+struct deferred_metadata {};
+
 // ----------------------------------------------------------------------------
 
 class significant_value
@@ -50,7 +62,7 @@ public:
         typename =
             typename std::enable_if< std::is_arithmetic< T >::value, T >::type
     > bool equals( T value ) const
-    { return equals( static_cast< long double >( value ), digits_ ); }
+    { return equals( static_cast< long double >( value ), get_digit_count() ); }
 */
 
     template
@@ -68,7 +80,7 @@ public:
     }
 
     bool equals( long double value ) const
-    { return equals( value, digits_ ); }
+    { return equals( value, get_digit_count() ); }
 
     bool equals( long double value, unsigned int digits ) const;
 
@@ -103,7 +115,7 @@ public:
         typename =
             typename std::enable_if< std::is_arithmetic< T >::value, T >::type
     > bool operator != ( T value ) const
-    { return !equals( static_cast< long double >( value ), digits_ ); }
+    { return !equals( static_cast< long double >( value ), get_digit_count() ); }
 */
     bool operator != ( const significant_value & that ) const
     { return !( equals( that ) ); }
@@ -112,7 +124,7 @@ public:
     { return !( equals( that ) ); }
 
     bool operator != ( long double value ) const
-    { return !equals( value, digits_ ); }
+    { return !equals( value, get_digit_count() ); }
 /*
     template
     <
@@ -120,10 +132,10 @@ public:
         typename =
             typename std::enable_if< std::is_arithmetic< T >::value, T >::type
     > bool operator < ( T value ) const
-    { return less_than( static_cast< long double >( value ), digits_ ); }
+    { return less_than( static_cast< long double >( value ), get_digit_count() ); }
 */
     bool operator < ( long double value ) const
-    { return less_than( value, digits_ ); }
+    { return less_than( value, get_digit_count() ); }
 
     bool operator < ( const significant_value & that ) const
     { return less_than( that ); }
@@ -137,7 +149,7 @@ public:
         typename =
             typename std::enable_if< std::is_arithmetic< T >::value, T >::type
     > bool less_than( T value ) const
-    { return less_than( static_cast< long double >( value ), digits_ ); }
+    { return less_than( static_cast< long double >( value ), get_digit_count() ); }
 */
     template
     <
@@ -154,7 +166,7 @@ public:
     }
 
     bool less_than( long double value ) const
-    { return less_than( value, digits_ ); }
+    { return less_than( value, get_digit_count() ); }
 
     bool less_than( long double value, unsigned int digits ) const;
 
@@ -185,10 +197,10 @@ public:
         typename =
             typename std::enable_if< std::is_arithmetic< T >::value, T >::type
     > bool operator > ( T value ) const
-    { return greater_than( static_cast< long double >( value ), digits_ ); }
+    { return greater_than( static_cast< long double >( value ), get_digit_count() ); }
 */
     bool operator > ( long double value ) const
-    { return greater_than( value, digits_ ); }
+    { return greater_than( value, get_digit_count() ); }
 
     bool operator > ( const significant_value & that ) const
     { return greater_than( that ); }
@@ -202,7 +214,7 @@ public:
         typename =
             typename std::enable_if< std::is_arithmetic< T >::value, T >::type
     > bool greater_than( T value ) const
-    { return greater_than( static_cast< long double >( value ), digits_ ); }
+    { return greater_than( static_cast< long double >( value ), get_digit_count() ); }
 */
     template
     <
@@ -219,7 +231,7 @@ public:
     }
 
     bool greater_than( long double value ) const
-    { return greater_than( value, digits_ ); }
+    { return greater_than( value, get_digit_count() ); }
 
     bool greater_than( long double value, unsigned int digits ) const;
 
@@ -251,10 +263,10 @@ public:
         typename =
             typename std::enable_if< std::is_arithmetic< T >::value, T >::type
     > bool operator <= ( T value ) const
-    { return !greater_than( static_cast< long double >( value ), digits_ ); }
+    { return !greater_than( static_cast< long double >( value ), get_digit_count() ); }
 */
     bool operator <= ( long double value ) const
-    { return !greater_than( value, digits_ ); }
+    { return !greater_than( value, get_digit_count() ); }
 
     bool operator <= ( const significant_value & that ) const
     { return !greater_than( that ); }
@@ -269,7 +281,7 @@ public:
         typename =
             typename std::enable_if< std::is_arithmetic< T >::value, T >::type
     > bool less_than_or_equals( T value ) const
-    { return !greater_than( static_cast< long double >( value ), digits_ ); }
+    { return !greater_than( static_cast< long double >( value ), get_digit_count() ); }
 */
     template
     <
@@ -286,7 +298,7 @@ public:
     }
 
     bool less_than_or_equals( long double value ) const
-    { return !greater_than( value, digits_ ); }
+    { return !greater_than( value, get_digit_count() ); }
 
     bool less_than_or_equals( long double value, unsigned int digits ) const
     { return !greater_than( value, digits  ); }
@@ -338,7 +350,7 @@ public:
         typename =
             typename std::enable_if< std::is_arithmetic< T >::value, T >::type
     > bool greater_than_or_equals( T value ) const
-    { return !less_than( static_cast< long double >( value ), digits_ ); }
+    { return !less_than( static_cast< long double >( value ), get_digit_count() ); }
 */
     template
     <
@@ -355,7 +367,7 @@ public:
     }
 
     bool greater_than_or_equals( long double value ) const
-    { return !less_than( value, digits_ ); }
+    { return !less_than( value, get_digit_count() ); }
 
     bool greater_than_or_equals( long double value, unsigned int digits ) const
     { return !less_than( value, digits ); }
@@ -386,7 +398,7 @@ public:
 
 
     long double get_value( rounding_style rounding = rounding_style::round_half ) const
-    { return get_value( digits_, rounding ); }
+    { return get_value( get_digit_count(), rounding ); }
 
     long double get_value( int digits, rounding_style rounding = rounding_style::round_half ) const;
 
@@ -400,15 +412,55 @@ public:
         rounding_style rounding = rounding_style::round_half,
         bool show_decimal = false ) const;
 
+    /** These are like the to_string functions above, except the string
+     allocates from resource. A whole report can then share one arena, such as
+     a std::pmr::monotonic_buffer_resource, and release it all at once. These
+     throw std::invalid_argument if resource is null.
+     */
+    std::pmr::string to_string( std::pmr::memory_resource * resource,
+        format_style formatting = format_style::decimal_fixed,
+        rounding_style rounding = rounding_style::round_half,
+        bool show_decimal = false ) const;
+
+    std::pmr::string to_string( std::pmr::memory_resource * resource,
+        unsigned int digits,
+        format_style formatting = format_style::decimal_fixed,
+        rounding_style rounding = rounding_style::round_half,
+        bool show_decimal = false ) const;
+
+    /** These have the format and rounding styles as template parameters, so
+     the formatter picks its code path at compile time instead of on every
+     call. Use format_spec when the styles are only known at run time.
+     */
+    template < format_style Formatting, rounding_style Rounding >
+    std::string to_string() const
+    { return to_string< Formatting, Rounding >( get_digit_count() ); }
+
+    template < format_style Formatting, rounding_style Rounding >
+    std::string to_string( unsigned int digits, bool show_decimal = false ) const;
+
     inline long double get_exact_value() const { return value_; }
 
     inline int get_most_sigdig_exponent() const
-    { return most_sigdig_exponent_; }
+    { return is_metadata_deferred() ? get_resolved().most_sigdig_exponent_ : most_sigdig_exponent_; }
 
     inline int get_least_sigdig_exponent() const
-    { return least_sigdig_exponent_; }
+    { return is_metadata_deferred() ? get_resolved().least_sigdig_exponent_ : least_sigdig_exponent_; }
 
-    inline unsigned int get_digit_count() const { return digits_; }
+    inline unsigned int get_digit_count() const
+    { return is_metadata_deferred() ? get_resolved().digits_ : digits_; }
+
+    /// Returns true if the digits and exponents were deferred and not yet stored.
+    inline bool is_metadata_deferred() const { return digits_ == 0; }
+
+    /// Calculates and stores the digits and exponents now if they were deferred.
+    inline void resolve_metadata()
+    {
+        if ( digits_ == 0 )
+        {
+            calculate_metadata();
+        }
+    }
 
     long double get_tolerance() const;
 
@@ -437,6 +489,47 @@ public:
 
     calculated_value operator + ( const defined_value & addend ) const;
 
+    /** These treat a built-in number as a defined value, so the result keeps
+     this value's significant digits, just as the defined_value overloads do.
+     They skip constructing a defined_value, which would search for the
+     number's exponent even though these never use it.
+     */
+    calculated_value operator / ( long double divisor ) const;
+
+    calculated_value operator * ( long double factor ) const;
+
+    calculated_value operator - ( long double subtrahend ) const;
+
+    calculated_value operator + ( long double addend ) const;
+
+    template
+    <
+        typename T,
+        typename =
+            typename std::enable_if< std::is_arithmetic< T >::value, T >::type
+    > calculated_value operator / ( T divisor ) const;
+
+    template
+    <
+        typename T,
+        typename =
+            typename std::enable_if< std::is_arithmetic< T >::value, T >::type
+    > calculated_value operator * ( T factor ) const;
+
+    template
+    <
+        typename T,
+        typename =
+            typename std::enable_if< std::is_arithmetic< T >::value, T >::type
+    > calculated_value operator - ( T subtrahend ) const;
+
+    template
+    <
+        typename T,
+        typename =
+            typename std::enable_if< std::is_arithmetic< T >::value, T >::type
+    > calculated_value operator + ( T addend ) const;
+
     // Power functions.
     calculated_value to_power_of( const significant_value & exponent ) const;
 
@@ -447,21 +540,33 @@ protected:
 
     significant_value( long double value );
     significant_value( long double value, unsigned int digits );
+    significant_value( long double value, deferred_metadata );
     significant_value( long value );
     significant_value( long value, unsigned int digits );
     significant_value( unsigned long value );
     significant_value( unsigned long value, unsigned int digits );
+    significant_value( long long value );
+    significant_value( long long value, unsigned int digits );
+    significant_value( unsigned long long value );
+    significant_value( unsigned long long value, unsigned int digits );
+#ifdef __SIZEOF_INT128__
+    significant_value( __int128 value );
+    significant_value( __int128 value, unsigned int digits );
+    significant_value( unsigned __int128 value );
+    significant_value( unsigned __int128 value, unsigned int digits );
+#endif
     significant_value( const char * value );
     significant_value( const char * value, unsigned int digits );
     significant_value( const std::string & value );
     significant_value( const std::string & value, unsigned int digits );
-    significant_value( const significant_value & that );
+    significant_value( const significant_value & that ) = default;
     significant_value( long double value, unsigned int digits,
         int most_sigdig_exponent, int least_sigdig_exponent );
-    ~significant_value();
+    ~significant_value() = default;
 
     void assign( long double value );
     void assign( long double value, unsigned int digits );
+    void assign( long double value, deferred_metadata );
     void assign( long value );
     void assign( long value, unsigned int digits );
     void assign( unsigned long value );
@@ -475,7 +580,14 @@ protected:
 
     bool is_sane() const;
 
+    void calculate_metadata();
+
+    /// Returns a copy with the digits and exponents calculated, leaving this unchanged.
+    significant_value get_resolved() const;
+
     long double value_;
+    // Zero digits means a value made with deferred_metadata has not stored
+    // these yet.
     unsigned int digits_;
     int most_sigdig_exponent_;
     int least_sigdig_exponent_;
@@ -486,8 +598,51 @@ private:
 
 };
 
+static_assert( std::is_trivially_copyable< significant_value >::value,
+    "significant_value must be trivially copyable so containers can copy it with memcpy." );
+static_assert( std::is_standard_layout< significant_value >::value, "significant_value must have standard layout." );
+
 std::ostream & operator << ( std::ostream & os, const significant_value & value );
 
+/** These put a built-in number on the left side, and give the same results as
+ the defined_value operators with a significant_value on the right side.
+ */
+calculated_value operator / ( long double dividend, const significant_value & divisor );
+
+calculated_value operator * ( long double multiplier, const significant_value & factor );
+
+calculated_value operator - ( long double minuend, const significant_value & subtrahend );
+
+calculated_value operator + ( long double augend, const significant_value & addend );
+
+template
+<
+    typename T,
+    typename =
+        typename std::enable_if< std::is_arithmetic< T >::value, T >::type
+> calculated_value operator / ( T dividend, const significant_value & divisor );
+
+template
+<
+    typename T,
+    typename =
+        typename std::enable_if< std::is_arithmetic< T >::value, T >::type
+> calculated_value operator * ( T multiplier, const significant_value & factor );
+
+template
+<
+    typename T,
+    typename =
+        typename std::enable_if< std::is_arithmetic< T >::value, T >::type
+> calculated_value operator - ( T minuend, const significant_value & subtrahend );
+
+template
+<
+    typename T,
+    typename =
+        typename std::enable_if< std::is_arithmetic< T >::value, T >::type
+> calculated_value operator + ( T augend, const significant_value & addend );
+
 // ----------------------------------------------------------------------------
 
 } // end namespace
@@ -0,0 +1,86 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#pragma once
+
+#ifndef SIGDIG_STREAM_PIPELINE_HPP
+#define SIGDIG_STREAM_PIPELINE_HPP
+
+#include <cstddef>
+
+#include <functional>
+#include <iosfwd>
+
+#include "format_spec.hpp"
+#include "significant_column.hpp"
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+/** @class stream_pipeline Reads numbers as text, parses them into measured
+ values, does a calculation on them, and writes the results as text. Parsing,
+ calculating, and formatting each run in their own thread, so one stage does
+ not wait for the others while they work on a different block of values.
+ Values travel between the stages in blocks through lock-free queues that hold
+ a fixed number of blocks. A stage that gets ahead waits for room in the next
+ queue, so memory use stays bounded no matter how long the input is. Blocks are
+ recycled between stages, so once the pipeline is running the stages rarely
+ allocate memory.
+ */
+
+class stream_pipeline
+{
+public:
+
+    /** Does the calculation on one block of values. The output column does not
+     need to be the same size as the input column. The output column may hold
+     values from a previous block, so the calculation must resize or clear it.
+     */
+    typedef std::function< void ( const column_view & input,
+        significant_column & output ) > calculation;
+
+    /** The block size is how many values are parsed before they are passed to
+     the next stage, and the queue depth is how many blocks can wait between
+     two stages. This throws std::invalid_argument if the calculation is empty,
+     or if the block size or queue depth is zero.
+     */
+    explicit stream_pipeline( const calculation & calculate,
+        const format_spec & spec = format_spec(),
+        std::size_t block_size = 4096, std::size_t queue_depth = 4 );
+
+    stream_pipeline( const stream_pipeline & that ) = default;
+
+    stream_pipeline & operator = ( const stream_pipeline & that ) = default;
+
+    ~stream_pipeline() = default;
+
+    inline std::size_t get_block_size() const { return block_size_; }
+
+    inline std::size_t get_queue_depth() const { return queue_depth_; }
+
+    /** Reads numbers separated by whitespace from input, and writes each result
+     to output on its own line. This returns how many results were written. If
+     any stage throws, the other stages stop, and this rethrows the first
+     exception after all the threads end. A number that can not be parsed
+     throws std::invalid_argument, and a read error throws std::runtime_error.
+     */
+    std::size_t run( std::istream & input, std::ostream & output ) const;
+
+private:
+
+    calculation calculate_;
+    format_spec spec_;
+    std::size_t block_size_;
+    std::size_t queue_depth_;
+
+};
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
+
+#endif
@@ -0,0 +1,120 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#pragma once
+
+#ifndef SIGDIG_TOLERANCE_HASH_MAP_HPP
+#define SIGDIG_TOLERANCE_HASH_MAP_HPP
+
+#include <cstddef>
+
+#include <unordered_map>
+#include <vector>
+
+#include "significant_column.hpp"
+
+namespace sigdig {
+
+class defined_value;
+
+// ----------------------------------------------------------------------------
+
+/** @class tolerance_hash_map Groups significant values by tolerance using
+ hashing instead of sorting. Each group has a key, which is the first value put
+ into the group, and a group number, which is the order the group was made.
+ Group numbers can be used as positions in arrays of sums or counts.
+
+ The number line is divided into cells that are 10^e wide, where e is at least
+ the highest exponent of any least significant digit in the map. A tolerance
+ range is never wider than one cell, so it touches one or two cells, and keys
+ are stored in each cell their ranges touch. Two ranges that overlap always
+ touch a cell in common, so a search only looks at the cells of its own range.
+ If a value with a wider range arrives, the cells are made wider and every key
+ is stored again. Keys so far from zero that their cell numbers are not exact
+ are kept in a list that every search checks, and a search whose own cell
+ numbers are not exact looks at every key.
+
+ Equality by tolerance is not transitive, so a value might equal the keys of
+ several groups. The value then belongs to the group with the lowest number.
+ */
+
+class tolerance_hash_map
+{
+public:
+
+    /// Returned by find functions when no group has a key equal to the value.
+    static const std::size_t npos = static_cast< std::size_t >( -1 );
+
+    tolerance_hash_map();
+
+    tolerance_hash_map( const tolerance_hash_map & that ) = default;
+
+    tolerance_hash_map & operator = ( const tolerance_hash_map & that ) = default;
+
+    /// Returns number of groups.
+    inline std::size_t size() const { return keys_.size(); }
+
+    inline bool empty() const { return keys_.empty(); }
+
+    void clear();
+
+    /// Returns exponent of the cell width, or 0 if the map is empty.
+    inline int get_cell_exponent() const { return cell_exponent_; }
+
+    /// Returns number of the group whose key equals value, or npos if none.
+    std::size_t find( const significant_value & value ) const;
+
+    /// Returns number of the group whose key's tolerance range contains value, or npos if none.
+    std::size_t find( const defined_value & value ) const;
+
+    /// Appends the numbers of every group whose key equals value.
+    void find_all( const significant_value & value,
+        std::vector< std::size_t > & groups ) const;
+
+    /** Returns number of the group whose key equals value. If no key equals
+     value, this makes a new group with value as its key.
+     */
+    std::size_t find_or_insert( const significant_value & value );
+
+    std::size_t find_or_insert( long double value, unsigned int digits,
+        int most_sigdig_exponent );
+
+    /// Puts each value of column into a group, and stores the group numbers into groups.
+    void group( const column_view & column, std::vector< std::size_t > & groups );
+
+    /// Returns the key of a group.
+    calculated_value get_key( std::size_t group ) const;
+
+    /// Returns a view of the keys of every group in group order.
+    inline column_view get_keys() const { return keys_.view(); }
+
+private:
+
+    typedef std::unordered_map< long double, std::vector< std::size_t > > cell_map;
+
+    std::size_t find_in_range( long double lower, long double upper,
+        std::vector< std::size_t > * groups ) const;
+
+    long double calculate_cell( long double value ) const;
+
+    void add_to_cells( std::size_t group );
+
+    void widen_cells( int cell_exponent );
+
+    significant_column keys_;
+    std::vector< long double > lower_;
+    std::vector< long double > upper_;
+    cell_map cells_;
+    std::vector< std::size_t > uncelled_;
+    int cell_exponent_;
+
+};
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
+
+#endif
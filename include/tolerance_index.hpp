@@ -0,0 +1,100 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#pragma once
+
+#ifndef SIGDIG_TOLERANCE_INDEX_HPP
+#define SIGDIG_TOLERANCE_INDEX_HPP
+
+#include <cstddef>
+
+#include <utility>
+#include <vector>
+
+#include "significant_column.hpp"
+
+namespace sigdig {
+
+class defined_value;
+
+// ----------------------------------------------------------------------------
+
+/** @class tolerance_index An index of the tolerance ranges of a column of
+ significant values. It finds every stored value that equals a given value in
+ O( log n + k ) time, where k is the number of matches. Equality means the same
+ thing as significant_value::equals, which is that the tolerance ranges overlap.
+
+ The ranges are sorted by their lower ends and stored in an array that is also
+ treated as an implicit binary tree. Each node holds the highest upper end in
+ its subtree, so searches skip any subtree whose ranges all end too soon. The
+ index refers to values by their position in the column it was built from.
+ */
+
+class tolerance_index
+{
+public:
+
+    /// A pair of positions, the first from the indexed column and the second from another column.
+    typedef std::pair< std::size_t, std::size_t > match;
+
+    tolerance_index();
+
+    explicit tolerance_index( const column_view & column );
+
+    tolerance_index( const tolerance_index & that ) = default;
+
+    tolerance_index & operator = ( const tolerance_index & that ) = default;
+
+    /// Replaces the contents of this index with the ranges of values in column.
+    void build( const column_view & column );
+
+    inline std::size_t size() const { return lower_.size(); }
+
+    inline bool empty() const { return lower_.empty(); }
+
+    /** Finds the positions of stored values whose tolerance ranges overlap the
+     closed range from lower to upper. Positions are appended to matches in the
+     order of the lower ends of their ranges.
+     */
+    void find_overlapping( long double lower, long double upper,
+        std::vector< std::size_t > & matches ) const;
+
+    /// Finds positions of stored values which equal value.
+    void find_equal( const significant_value & value,
+        std::vector< std::size_t > & matches ) const;
+
+    /// Finds positions of stored values whose tolerance ranges contain value.
+    void find_equal( const defined_value & value,
+        std::vector< std::size_t > & matches ) const;
+
+    /// Returns how many stored values equal value.
+    std::size_t count_equal( const significant_value & value ) const;
+
+    /** Finds every pair of equal values between the indexed column and other.
+     This takes O( m log n + k ) time for m values in other. Pairs are appended
+     to matches, grouped by position within other.
+     */
+    void join( const column_view & other, std::vector< match > & matches ) const;
+
+private:
+
+    template < typename Visitor >
+    void visit_overlapping( long double lower, long double upper,
+        Visitor & visitor ) const;
+
+    std::vector< long double > lower_;
+    std::vector< long double > upper_;
+    std::vector< long double > max_upper_;  ///< Highest upper end within each subtree.
+    std::vector< std::size_t > positions_;  ///< Position of each range within the original column.
+    int max_level_;
+
+};
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
+
+#endif
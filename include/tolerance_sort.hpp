@@ -0,0 +1,76 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#pragma once
+
+#ifndef SIGDIG_TOLERANCE_SORT_HPP
+#define SIGDIG_TOLERANCE_SORT_HPP
+
+#include <cstddef>
+
+#include <utility>
+#include <vector>
+
+#include "significant_column.hpp"
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+/** @class tolerance_sort This class sorts columns of significant values by
+ their tolerance ranges. The less_than operators treat overlapping values as
+ neither less nor greater, so they are not a strict weak ordering and can not
+ be given to std::sort. These functions instead order values by the lower end
+ of each tolerance range, then by the upper end, then by original position.
+ That order is strict, and it keeps values that equal each other close
+ together. Large columns are sorted using several threads.
+ */
+
+class tolerance_sort
+{
+public:
+
+    /// A pair of positions, the first from the left column and the second from the right column.
+    typedef std::pair< std::size_t, std::size_t > match;
+
+    /// Columns with at least this many values are sorted using several threads.
+    static const std::size_t parallel_threshold = 65536;
+
+    /** Fills order with positions of values in column, arranged in sorted
+     order. Set thread_count to 0 to use as many threads as the hardware has.
+     */
+    static void sort( const column_view & column, std::vector< std::size_t > & order,
+        unsigned int thread_count = 0 );
+
+    /// Sorts the values within column.
+    static void sort( significant_column & column, unsigned int thread_count = 0 );
+
+    /// Returns true if the values in column are in sorted order.
+    static bool is_sorted( const column_view & column );
+
+    /** Splits a sorted column into runs of values which all equal each other.
+     Each run starts where the previous run ended, and the start of each run is
+     put into starts. A run ends at the first value which does not equal every
+     value already in it. This throws if the column is not sorted.
+     */
+    static void group_equal( const column_view & sorted,
+        std::vector< std::size_t > & starts );
+
+    /** Finds every pair of equal values between two sorted columns by walking
+     both columns once. Only values whose tolerance ranges are still open are
+     kept while walking, so this needs little memory even for huge columns.
+     Pairs are appended to matches. This throws if either column is not sorted.
+     */
+    static void merge_join( const column_view & left, const column_view & right,
+        std::vector< match > & matches );
+
+};
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
+
+#endif
@@ -9,6 +9,8 @@
 #ifndef SIGDIG_UTILITY_HPP
 #define SIGDIG_UTILITY_HPP
 
+#include <cstddef>
+
 namespace sigdig {
 
 // ----------------------------------------------------------------------------
@@ -48,15 +50,44 @@ public:
     static int calculate_exponent( long double value );
     static int calculate_exponent( long value );
     static int calculate_exponent( unsigned long value );
+    static int calculate_exponent( long long value );
+    static int calculate_exponent( unsigned long long value );
+#ifdef __SIZEOF_INT128__
+    static int calculate_exponent( __int128 value );
+    static int calculate_exponent( unsigned __int128 value );
+#endif
 
     static unsigned int count_significant_digits( long double value, int & exponent );
     static unsigned int count_significant_digits( long double value );
     static unsigned int count_significant_digits( long value );
     static unsigned int count_significant_digits( unsigned long value );
+    static unsigned int count_significant_digits( long long value );
+    static unsigned int count_significant_digits( unsigned long long value );
+#ifdef __SIZEOF_INT128__
+    static unsigned int count_significant_digits( __int128 value );
+    static unsigned int count_significant_digits( unsigned __int128 value );
+#endif
 
     static void count_digits_in_string( const char * source,
         long double & target, unsigned int & digits, int & exponent );
 
+    /** Rounds value to the requested number of significant digits. The result
+     is identical to writing value with significant_value::to_string in
+     decimal_fixed format and reading it back with strtold, but is found with
+     integer arithmetic instead of strings.
+     @param exponent The exponent of the most significant digit of value.
+     */
+    static long double round_to_digits( long double value, int exponent,
+        unsigned int digits, rounding_style rounding = rounding_style::round_half );
+
+    static long double round_to_digits( long double value, unsigned int digits,
+        rounding_style rounding = rounding_style::round_half );
+
+    /// Rounds count values, such as a column, using the matching exponents and digits.
+    static void round_to_digits( const long double * values, const int * exponents,
+        const unsigned int * digits, std::size_t count, rounding_style rounding,
+        long double * results );
+
     static bool are_nearly_equal( long double v1, long double v2 );
 
     static bool are_nearly_equal( long double v1, long double v2, long double tolerance );
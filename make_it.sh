@@ -25,6 +25,63 @@ g++ -Weffc++ -Wall -std=c++17 -I include -I src -c src/calculated_value.cpp -o o
 rm ./obj/significant_value.o
 g++ -Weffc++ -Wall -std=c++17 -I include -I src -c src/significant_value.cpp -o obj/significant_value.o
 
+rm ./obj/significant_column.o
+g++ -Weffc++ -Wall -std=c++17 -I include -I src -c src/significant_column.cpp -o obj/significant_column.o
+
+rm ./obj/batch.o
+g++ -Weffc++ -Wall -std=c++17 -I include -I src -c src/batch.cpp -o obj/batch.o
+
+rm ./obj/formula.o
+g++ -Weffc++ -Wall -std=c++17 -I include -I src -c src/formula.cpp -o obj/formula.o
+
+rm ./obj/dependency_graph.o
+g++ -Weffc++ -Wall -std=c++17 -I include -I src -c src/dependency_graph.cpp -o obj/dependency_graph.o
+
+rm ./obj/stream_pipeline.o
+g++ -Weffc++ -Wall -std=c++17 -pthread -I include -I src -c src/stream_pipeline.cpp -o obj/stream_pipeline.o
+
+rm ./obj/operation_counters.o
+g++ -Weffc++ -Wall -std=c++17 -I include -I src -c src/operation_counters.cpp -o obj/operation_counters.o
+
+rm ./obj/precision_telemetry.o
+g++ -Weffc++ -Wall -std=c++17 -I include -I src -c src/precision_telemetry.cpp -o obj/precision_telemetry.o
+
+rm ./obj/column_file.o
+g++ -Weffc++ -Wall -std=c++17 -I include -I src -c src/column_file.cpp -o obj/column_file.o
+
+rm ./obj/packed_integers.o
+g++ -Weffc++ -Wall -std=c++17 -I include -I src -c src/packed_integers.cpp -o obj/packed_integers.o
+
+rm ./obj/compressed_column.o
+g++ -Weffc++ -Wall -std=c++17 -I include -I src -c src/compressed_column.cpp -o obj/compressed_column.o
+
+rm ./obj/tolerance_index.o
+g++ -Weffc++ -Wall -std=c++17 -I include -I src -c src/tolerance_index.cpp -o obj/tolerance_index.o
+
+rm ./obj/tolerance_sort.o
+g++ -Weffc++ -Wall -std=c++17 -pthread -I include -I src -c src/tolerance_sort.cpp -o obj/tolerance_sort.o
+
+rm ./obj/tolerance_hash_map.o
+g++ -Weffc++ -Wall -std=c++17 -I include -I src -c src/tolerance_hash_map.cpp -o obj/tolerance_hash_map.o
+
+rm ./obj/significant_stats.o
+g++ -Weffc++ -Wall -std=c++17 -I include -I src -c src/significant_stats.cpp -o obj/significant_stats.o
+
+rm ./obj/linear_algebra.o
+g++ -Weffc++ -Wall -std=c++17 -I include -I src -c src/linear_algebra.cpp -o obj/linear_algebra.o
+
+rm ./obj/polynomial.o
+g++ -Weffc++ -Wall -std=c++17 -I include -I src -c src/polynomial.cpp -o obj/polynomial.o
+
+rm ./obj/interpolation_table.o
+g++ -Weffc++ -Wall -std=c++17 -I include -I src -c src/interpolation_table.cpp -o obj/interpolation_table.o
+
+rm ./obj/decimal_number.o
+g++ -Weffc++ -Wall -std=c++17 -I include -I src -c src/decimal_number.cpp -o obj/decimal_number.o
+
+rm ./obj/format_spec.o
+g++ -Weffc++ -Wall -std=c++17 -I include -I src -c src/format_spec.cpp -o obj/format_spec.o
+
 rm ./bin/main.o
 g++ -Weffc++ -Wall -std=c++17 -I include -I src -I .. -c test/main.cpp -o bin/main.o
 g++ -Weffc++ -Wall -std=c++17 -I include -I src -I .. -I ../CppUnitTest/include -c test/main.cpp -o bin/main.o
@@ -33,6 +90,14 @@ g++ -Weffc++ -Wall -std=c++17 -I include -I src -I .. -I ../CppUnitTest/include
 
 g++ -Weffc++ -Wall -std=c++17 -I include -I src -I .. -I ../CppUnitTest/include -c test/test_defined_value.cpp -o bin/test_defined_value.o
 
+g++ -Weffc++ -Wall -std=c++17 -I include -I src -I .. -I ../CppUnitTest/include -c test/test_columns.cpp -o bin/test_columns.o
+
+g++ -Weffc++ -Wall -std=c++17 -I include -I src -I .. -I ../CppUnitTest/include -c test/test_tolerance_index.cpp -o bin/test_tolerance_index.o
+
+g++ -Weffc++ -Wall -std=c++17 -I include -I src -I .. -I ../CppUnitTest/include -c test/test_numerics.cpp -o bin/test_numerics.o
+# C++20 checks format strings at compile time, so make sure the formatters still compile there.
+g++ -Weffc++ -Wall -std=c++20 -I include -I src -I .. -I ../CppUnitTest/include -fsyntax-only test/test_numerics.cpp
+
 rm ./bin/main.exe
 #g++ -Weffc++ -Wall -std=c++17 \
 #	bin/main.o \
@@ -66,14 +131,52 @@ g++ -Weffc++ -Wall -std=c++17 \
 	bin/main.o \
 	bin/test_helper.o \
 	bin/test_defined_value.o \
+	bin/test_columns.o \
+	bin/test_tolerance_index.o \
+	bin/test_numerics.o \
 	obj/defined_value.o \
 	obj/measured_value.o \
 	obj/calculated_value.o \
 	obj/significant_value.o \
+	obj/significant_column.o \
+	obj/batch.o \
+	obj/formula.o \
+	obj/dependency_graph.o \
+	obj/stream_pipeline.o \
+	obj/operation_counters.o \
+	obj/precision_telemetry.o \
+	obj/column_file.o \
+	obj/packed_integers.o \
+	obj/compressed_column.o \
+	obj/tolerance_index.o \
+	obj/tolerance_sort.o \
+	obj/tolerance_hash_map.o \
+	obj/significant_stats.o \
+	obj/linear_algebra.o \
+	obj/polynomial.o \
+	obj/interpolation_table.o \
+	obj/decimal_number.o \
+	obj/format_spec.o \
 	obj/utility.o \
 	obj/helper.o \
 	obj/lookup.o \
 	obj/UnitTest.o \
+	-pthread \
 	-o bin/main.exe
 
+g++ -Weffc++ -Wall -std=c++17 -O2 -I include -I src -c test/bench_integer.cpp -o bin/bench_integer.o
+
+rm ./bin/bench_integer.exe
+g++ -Weffc++ -Wall -std=c++17 \
+	bin/bench_integer.o \
+	obj/defined_value.o \
+	obj/measured_value.o \
+	obj/calculated_value.o \
+	obj/significant_value.o \
+	obj/decimal_number.o \
+	obj/utility.o \
+	obj/helper.o \
+	obj/lookup.o \
+	-o bin/bench_integer.exe
+
 # g++ -Weffc++ -Wall -std=c++17 bin/main.o obj/defined_value.o obj/measured_value.o obj/calculated_value.o obj/Helper.o obj/UnitTest.o -o bin/main.exe
@@ -0,0 +1,224 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#include "batch.hpp"
+
+#include <cassert>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "defined_value.hpp"
+#include "helper.hpp"
+#include "lookup.hpp"
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+static void validate_column_sizes( const column_view & left,
+    const column_view & right )
+{
+    if ( left.size() != right.size() )
+    {
+        throw std::invalid_argument(
+            "Error! Columns used in a batch operation must have the same size." );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void batch::add( const column_view & augend, const column_view & addend,
+    significant_column & result )
+{
+    validate_column_sizes( augend, addend );
+    const std::size_t count = augend.size();
+    result.resize( count );
+    long double * values = result.get_values();
+    unsigned int * digits = result.get_digit_counts();
+    int * exponents = result.get_most_sigdig_exponents();
+    for ( std::size_t ii = 0; ii < count; ++ii )
+    {
+        values[ ii ] = helper::calculate_sum(
+            augend.get_exact_value( ii ), augend.get_least_sigdig_exponent( ii ),
+            addend.get_exact_value( ii ), addend.get_least_sigdig_exponent( ii ),
+            false, digits[ ii ], exponents[ ii ] );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void batch::add( const column_view & augend, const defined_value & addend,
+    significant_column & result )
+{
+    const std::size_t count = augend.size();
+    const long double v = addend.get_value();
+    result.resize( count );
+    long double * values = result.get_values();
+    unsigned int * digits = result.get_digit_counts();
+    int * exponents = result.get_most_sigdig_exponents();
+    for ( std::size_t ii = 0; ii < count; ++ii )
+    {
+        const long double sum = augend.get_exact_value( ii ) + v;
+        values[ ii ] = sum;
+        digits[ ii ] = helper::calculate_sum_digits( sum,
+            augend.get_least_sigdig_exponent( ii ), exponents[ ii ] );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void batch::subtract( const column_view & minuend,
+    const column_view & subtrahend, significant_column & result )
+{
+    validate_column_sizes( minuend, subtrahend );
+    const std::size_t count = minuend.size();
+    result.resize( count );
+    long double * values = result.get_values();
+    unsigned int * digits = result.get_digit_counts();
+    int * exponents = result.get_most_sigdig_exponents();
+    for ( std::size_t ii = 0; ii < count; ++ii )
+    {
+        values[ ii ] = helper::calculate_sum(
+            minuend.get_exact_value( ii ), minuend.get_least_sigdig_exponent( ii ),
+            subtrahend.get_exact_value( ii ), subtrahend.get_least_sigdig_exponent( ii ),
+            true, digits[ ii ], exponents[ ii ] );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void batch::multiply( const column_view & multiplicand,
+    const column_view & factor, significant_column & result )
+{
+    validate_column_sizes( multiplicand, factor );
+    const std::size_t count = multiplicand.size();
+    result.resize( count );
+    long double * values = result.get_values();
+    unsigned int * digits = result.get_digit_counts();
+    int * exponents = result.get_most_sigdig_exponents();
+    for ( std::size_t ii = 0; ii < count; ++ii )
+    {
+        const long double product =
+            multiplicand.get_exact_value( ii ) * factor.get_exact_value( ii );
+        values[ ii ] = product;
+        digits[ ii ] = std::min( multiplicand.get_digit_count( ii ),
+            factor.get_digit_count( ii ) );
+        exponents[ ii ] = lookup::calculate_exponent( product );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void batch::multiply( const column_view & multiplicand,
+    const defined_value & factor, significant_column & result )
+{
+    const std::size_t count = multiplicand.size();
+    const long double v = factor.get_value();
+    result.resize( count );
+    long double * values = result.get_values();
+    unsigned int * digits = result.get_digit_counts();
+    int * exponents = result.get_most_sigdig_exponents();
+    for ( std::size_t ii = 0; ii < count; ++ii )
+    {
+        const long double product = multiplicand.get_exact_value( ii ) * v;
+        values[ ii ] = product;
+        digits[ ii ] = multiplicand.get_digit_count( ii );
+        exponents[ ii ] = lookup::calculate_exponent( product );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void batch::divide( const column_view & dividend,
+    const column_view & divisor, significant_column & result )
+{
+    validate_column_sizes( dividend, divisor );
+    const std::size_t count = dividend.size();
+    result.resize( count );
+    long double * values = result.get_values();
+    unsigned int * digits = result.get_digit_counts();
+    int * exponents = result.get_most_sigdig_exponents();
+    for ( std::size_t ii = 0; ii < count; ++ii )
+    {
+        const long double d = divisor.get_exact_value( ii );
+        if ( d == 0.0L )
+        {
+            throw std::invalid_argument( "Division by zero error in batch::divide" );
+        }
+        const long double quotient = dividend.get_exact_value( ii ) / d;
+        values[ ii ] = quotient;
+        digits[ ii ] = std::min( dividend.get_digit_count( ii ),
+            divisor.get_digit_count( ii ) );
+        exponents[ ii ] = lookup::calculate_exponent( quotient );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void batch::equals( const column_view & left, const column_view & right,
+    bool * results )
+{
+    validate_column_sizes( left, right );
+    assert( ( nullptr != results ) || left.empty() );
+    const std::size_t count = left.size();
+    for ( std::size_t ii = 0; ii < count; ++ii )
+    {
+        const long double left_tolerance = lookup::lookup_tolerance(
+            left.get_least_sigdig_exponent( ii ) - 1 );
+        const long double right_tolerance = lookup::lookup_tolerance(
+            right.get_least_sigdig_exponent( ii ) - 1 );
+        const long double left_value = left.get_exact_value( ii );
+        const long double right_value = right.get_exact_value( ii );
+        const bool right_is_more_than =
+            ( left_value + left_tolerance < right_value - right_tolerance );
+        const bool right_is_less_than =
+            ( right_value + right_tolerance < left_value - left_tolerance );
+        results[ ii ] = !( right_is_more_than || right_is_less_than );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void batch::less_than( const column_view & left, const column_view & right,
+    bool * results )
+{
+    validate_column_sizes( left, right );
+    assert( ( nullptr != results ) || left.empty() );
+    const std::size_t count = left.size();
+    for ( std::size_t ii = 0; ii < count; ++ii )
+    {
+        const long double left_tolerance = lookup::lookup_tolerance(
+            left.get_least_sigdig_exponent( ii ) - 1 );
+        const long double right_tolerance = lookup::lookup_tolerance(
+            right.get_least_sigdig_exponent( ii ) - 1 );
+        results[ ii ] = ( left.get_exact_value( ii ) + left_tolerance <
+            right.get_exact_value( ii ) - right_tolerance );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void batch::greater_than( const column_view & left, const column_view & right,
+    bool * results )
+{
+    validate_column_sizes( left, right );
+    assert( ( nullptr != results ) || left.empty() );
+    const std::size_t count = left.size();
+    for ( std::size_t ii = 0; ii < count; ++ii )
+    {
+        const long double left_tolerance = lookup::lookup_tolerance(
+            left.get_least_sigdig_exponent( ii ) - 1 );
+        const long double right_tolerance = lookup::lookup_tolerance(
+            right.get_least_sigdig_exponent( ii ) - 1 );
+        results[ ii ] = ( right.get_exact_value( ii ) + right_tolerance <
+            left.get_exact_value( ii ) - left_tolerance );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
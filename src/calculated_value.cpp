@@ -13,6 +13,8 @@
 
 #include "measured_value.hpp"
 #include "defined_value.hpp"
+#include "counters.hpp"
+#include "telemetry.hpp"
 #include "helper.hpp"
 
 namespace sigdig {
@@ -22,6 +24,7 @@ namespace sigdig {
 calculated_value::calculated_value( long double value ) :
     significant_value( value )
 {
+    SIGDIG_COUNT( calculated_value_constructions );
 }
 
 // ----------------------------------------------------------------------------
@@ -29,6 +32,15 @@ calculated_value::calculated_value( long double value ) :
 calculated_value::calculated_value( long double value, unsigned int digits ) :
     significant_value( value, digits )
 {
+    SIGDIG_COUNT( calculated_value_constructions );
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value::calculated_value( long double value, deferred_metadata deferred ) :
+    significant_value( value, deferred )
+{
+    SIGDIG_COUNT( calculated_value_constructions );
 }
 
 // ----------------------------------------------------------------------------
@@ -36,6 +48,7 @@ calculated_value::calculated_value( long double value, unsigned int digits ) :
 calculated_value::calculated_value( long value ) :
     significant_value( value )
 {
+    SIGDIG_COUNT( calculated_value_constructions );
 }
 
 // ----------------------------------------------------------------------------
@@ -43,6 +56,7 @@ calculated_value::calculated_value( long value ) :
 calculated_value::calculated_value( long value, unsigned int digits ) :
     significant_value( value, digits )
 {
+    SIGDIG_COUNT( calculated_value_constructions );
 }
 
 // ----------------------------------------------------------------------------
@@ -50,6 +64,7 @@ calculated_value::calculated_value( long value, unsigned int digits ) :
 calculated_value::calculated_value( unsigned long value ) :
     significant_value( value )
 {
+    SIGDIG_COUNT( calculated_value_constructions );
 }
 
 // ----------------------------------------------------------------------------
@@ -58,57 +73,119 @@ calculated_value::calculated_value( unsigned long value,
     unsigned int digits ) :
     significant_value( value, digits )
 {
+    SIGDIG_COUNT( calculated_value_constructions );
 }
 
 // ----------------------------------------------------------------------------
 
-calculated_value::calculated_value( const char * value ) :
+calculated_value::calculated_value( long long value ) :
     significant_value( value )
 {
+    SIGDIG_COUNT( calculated_value_constructions );
 }
 
 // ----------------------------------------------------------------------------
 
-calculated_value::calculated_value( const char * value, unsigned int digits ) :
+calculated_value::calculated_value( long long value, unsigned int digits ) :
     significant_value( value, digits )
 {
+    SIGDIG_COUNT( calculated_value_constructions );
 }
 
 // ----------------------------------------------------------------------------
 
-calculated_value::calculated_value( const std::string & value ) :
+calculated_value::calculated_value( unsigned long long value ) :
     significant_value( value )
 {
+    SIGDIG_COUNT( calculated_value_constructions );
 }
 
 // ----------------------------------------------------------------------------
 
-calculated_value::calculated_value( const std::string & value,
-    unsigned int digits ) :
+calculated_value::calculated_value( unsigned long long value, unsigned int digits ) :
     significant_value( value, digits )
 {
+    SIGDIG_COUNT( calculated_value_constructions );
 }
 
 // ----------------------------------------------------------------------------
 
-calculated_value::calculated_value( const calculated_value & that ) :
-    significant_value( that )
+#ifdef __SIZEOF_INT128__
+
+calculated_value::calculated_value( __int128 value ) :
+    significant_value( value )
 {
+    SIGDIG_COUNT( calculated_value_constructions );
 }
 
 // ----------------------------------------------------------------------------
 
-calculated_value::calculated_value( long double value, unsigned int digits,
-    int exponent, int least_sigdig_exponent ) :
-    significant_value( value, digits, exponent, least_sigdig_exponent )
+calculated_value::calculated_value( __int128 value, unsigned int digits ) :
+    significant_value( value, digits )
+{
+    SIGDIG_COUNT( calculated_value_constructions );
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value::calculated_value( unsigned __int128 value ) :
+    significant_value( value )
+{
+    SIGDIG_COUNT( calculated_value_constructions );
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value::calculated_value( unsigned __int128 value, unsigned int digits ) :
+    significant_value( value, digits )
+{
+    SIGDIG_COUNT( calculated_value_constructions );
+}
+
+// ----------------------------------------------------------------------------
+
+#endif
+
+// ----------------------------------------------------------------------------
+
+calculated_value::calculated_value( const char * value ) :
+    significant_value( value )
+{
+    SIGDIG_COUNT( calculated_value_constructions );
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value::calculated_value( const char * value, unsigned int digits ) :
+    significant_value( value, digits )
+{
+    SIGDIG_COUNT( calculated_value_constructions );
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value::calculated_value( const std::string & value ) :
+    significant_value( value )
+{
+    SIGDIG_COUNT( calculated_value_constructions );
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value::calculated_value( const std::string & value,
+    unsigned int digits ) :
+    significant_value( value, digits )
 {
+    SIGDIG_COUNT( calculated_value_constructions );
 }
 
 // ----------------------------------------------------------------------------
 
-calculated_value::~calculated_value()
+calculated_value::calculated_value( long double value, unsigned int digits,
+    int exponent, int least_sigdig_exponent ) :
+    significant_value( value, digits, exponent, least_sigdig_exponent )
 {
-    // No need to call is_sane since base class destructor will do that.
+    SIGDIG_COUNT( calculated_value_constructions );
 }
 
 // ----------------------------------------------------------------------------
@@ -130,6 +207,14 @@ calculated_value & calculated_value::assign( long double value,
 
 // ----------------------------------------------------------------------------
 
+calculated_value & calculated_value::assign( long double value, deferred_metadata deferred )
+{
+    significant_value::assign( value, deferred );
+    return *this;
+}
+
+// ----------------------------------------------------------------------------
+
 calculated_value & calculated_value::assign( long value )
 {
     significant_value::assign( value );
@@ -253,23 +338,6 @@ calculated_value & calculated_value::operator = ( const std::string & value )
 
 // ----------------------------------------------------------------------------
 
-calculated_value & calculated_value::operator = (
-    const calculated_value & that )
-{
-    assert( is_sane() );
-    if ( &that != this )
-    {
-        value_  = that.value_;
-        digits_ = that.digits_;
-        most_sigdig_exponent_  = that.most_sigdig_exponent_;
-        least_sigdig_exponent_ = that.least_sigdig_exponent_;
-        assert( is_sane() );
-    }
-    return *this;
-}
-
-// ----------------------------------------------------------------------------
-
 calculated_value & calculated_value::operator = ( const defined_value & that )
 {
     assert( is_sane() );
@@ -286,7 +354,7 @@ calculated_value & calculated_value::operator = ( const defined_value & that )
 calculated_value calculated_value::operator - () const
 {
     assert( is_sane() );
-    calculated_value negative( -value_, digits_, most_sigdig_exponent_, least_sigdig_exponent_ );
+    calculated_value negative( -value_, get_digit_count(), get_most_sigdig_exponent(), get_least_sigdig_exponent() );
     return negative;
 }
 
@@ -296,7 +364,7 @@ calculated_value calculated_value::absolute() const
 {
     assert( is_sane() );
     const long double v = std::abs( value_ );
-    calculated_value result( v, digits_, most_sigdig_exponent_, least_sigdig_exponent_ );
+    calculated_value result( v, get_digit_count(), get_most_sigdig_exponent(), get_least_sigdig_exponent() );
     return result;
 }
 
@@ -307,8 +375,8 @@ calculated_value calculated_value::truncate() const
     assert( is_sane() );
     const long double v = std::trunc( value_ );
     const int least_sigdig_exponent = 0;
-    const int digits = most_sigdig_exponent_ + 1;
-    calculated_value result( v, digits, most_sigdig_exponent_, least_sigdig_exponent );
+    const int digits = get_most_sigdig_exponent() + 1;
+    calculated_value result( v, digits, get_most_sigdig_exponent(), least_sigdig_exponent );
     return result;
 }
 
@@ -317,12 +385,30 @@ calculated_value calculated_value::truncate() const
 calculated_value & calculated_value::operator += (
     const significant_value & addend )
 {
+    resolve_metadata();
     assert( is_sane() );
+    if ( least_sigdig_exponent_ == addend.get_least_sigdig_exponent() )
+    {
+        long double sum = 0.0L;
+        unsigned int digits = 0;
+        int exponent = 0;
+        if ( helper::add_scaled_integers( value_, addend.get_exact_value(), false,
+            least_sigdig_exponent_, sum, digits, exponent ) )
+        {
+            SIGDIG_RECORD_DIGITS( add, std::max( digits_, addend.get_digit_count() ), digits );
+            value_ = sum;
+            digits_ = digits;
+            most_sigdig_exponent_ = exponent;
+            assert( is_sane() );
+            return *this;
+        }
+    }
     const long double sum = value_ + addend.get_exact_value();
-    const int exponent = utility::calculate_exponent( sum );
-    const int digits = exponent - least_sigdig_exponent_ + 1;
     const int highest_least_sigdig_exponent =
         std::max( least_sigdig_exponent_, addend.get_least_sigdig_exponent() );
+    int exponent = 0;
+    const unsigned int digits = helper::calculate_sum_digits( sum, highest_least_sigdig_exponent, exponent );
+    SIGDIG_RECORD_DIGITS( add, std::max( digits_, addend.get_digit_count() ), digits );
     value_ = sum;
     digits_ = digits;
     most_sigdig_exponent_ = exponent;
@@ -336,12 +422,22 @@ calculated_value & calculated_value::operator += (
 calculated_value & calculated_value::operator += (
     const defined_value & addend )
 {
+    return operator += ( addend.get_value() );
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value & calculated_value::operator += ( long double addend )
+{
+    resolve_metadata();
     assert( is_sane() );
-    // No need to assign digits_ data member since the number of significant
-    // digits does not change during operations with a defined value.
-    value_ += addend.get_value();
-    most_sigdig_exponent_ = utility::calculate_exponent( value_ );
-    digits_ = most_sigdig_exponent_ - least_sigdig_exponent_ + 1;
+    helper::validate_input_value( addend );
+    // The least significant place does not change during operations with a
+    // defined value, so only cancellation can change the digit count.
+    value_ += addend;
+    const unsigned int digits = helper::calculate_sum_digits( value_, least_sigdig_exponent_, most_sigdig_exponent_ );
+    SIGDIG_RECORD_DIGITS( add, digits_, digits );
+    digits_ = digits;
     assert( is_sane() );
     return *this;
 }
@@ -351,12 +447,30 @@ calculated_value & calculated_value::operator += (
 calculated_value & calculated_value::operator -= (
     const significant_value & subtrahend )
 {
+    resolve_metadata();
     assert( is_sane() );
+    if ( least_sigdig_exponent_ == subtrahend.get_least_sigdig_exponent() )
+    {
+        long double sum = 0.0L;
+        unsigned int digits = 0;
+        int exponent = 0;
+        if ( helper::add_scaled_integers( value_, subtrahend.get_exact_value(), true,
+            least_sigdig_exponent_, sum, digits, exponent ) )
+        {
+            SIGDIG_RECORD_DIGITS( subtract, std::max( digits_, subtrahend.get_digit_count() ), digits );
+            value_ = sum;
+            digits_ = digits;
+            most_sigdig_exponent_ = exponent;
+            assert( is_sane() );
+            return *this;
+        }
+    }
     const long double sum = value_ - subtrahend.get_exact_value();
-    const int exponent = utility::calculate_exponent( sum );
-    const int digits = exponent - least_sigdig_exponent_ + 1;
     const int highest_least_sigdig_exponent = std::max( least_sigdig_exponent_,
         subtrahend.get_least_sigdig_exponent() );
+    int exponent = 0;
+    const unsigned int digits = helper::calculate_sum_digits( sum, highest_least_sigdig_exponent, exponent );
+    SIGDIG_RECORD_DIGITS( subtract, std::max( digits_, subtrahend.get_digit_count() ), digits );
     value_ = sum;
     digits_ = digits;
     most_sigdig_exponent_ = exponent;
@@ -370,12 +484,22 @@ calculated_value & calculated_value::operator -= (
 calculated_value & calculated_value::operator -= (
     const defined_value & subtrahend )
 {
+    return operator -= ( subtrahend.get_value() );
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value & calculated_value::operator -= ( long double subtrahend )
+{
+    resolve_metadata();
     assert( is_sane() );
-    // No need to assign digits_ data member since the number of significant
-    // digits does not change during operations with a defined value.
-    value_ -= subtrahend.get_value();
-    most_sigdig_exponent_ = utility::calculate_exponent( value_ );
-    least_sigdig_exponent_ = most_sigdig_exponent_ - digits_ + 1;
+    helper::validate_input_value( subtrahend );
+    // The least significant place does not change during operations with a
+    // defined value, so only cancellation can change the digit count.
+    value_ -= subtrahend;
+    const unsigned int digits = helper::calculate_sum_digits( value_, least_sigdig_exponent_, most_sigdig_exponent_ );
+    SIGDIG_RECORD_DIGITS( subtract, digits_, digits );
+    digits_ = digits;
     assert( is_sane() );
     return *this;
 }
@@ -385,8 +509,11 @@ calculated_value & calculated_value::operator -= (
 calculated_value & calculated_value::operator *= (
     const significant_value & factor )
 {
+    resolve_metadata();
     assert( is_sane() );
     value_ *= factor.get_exact_value();
+    SIGDIG_RECORD_DIGITS( multiply, std::max( digits_, factor.get_digit_count() ),
+        std::min( digits_, factor.get_digit_count() ) );
     digits_ = std::min( digits_, factor.get_digit_count() );
     most_sigdig_exponent_ = utility::calculate_exponent( value_ );
     least_sigdig_exponent_ = most_sigdig_exponent_ - digits_ + 1;
@@ -399,10 +526,19 @@ calculated_value & calculated_value::operator *= (
 calculated_value & calculated_value::operator *= (
     const defined_value & factor )
 {
+    return operator *= ( factor.get_value() );
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value & calculated_value::operator *= ( long double factor )
+{
+    resolve_metadata();
     assert( is_sane() );
+    helper::validate_input_value( factor );
     // No need to assign digits_ data member since the number of significant
     // digits does not change during operations with a defined value.
-    value_ *= factor.get_value();
+    value_ *= factor;
     most_sigdig_exponent_ = utility::calculate_exponent( value_ );
     least_sigdig_exponent_ = most_sigdig_exponent_ - digits_ + 1;
     assert( is_sane() );
@@ -414,6 +550,7 @@ calculated_value & calculated_value::operator *= (
 calculated_value & calculated_value::operator /= (
     const significant_value & divisor )
 {
+    resolve_metadata();
     assert( is_sane() );
     if ( divisor.get_exact_value() == 0.0L )
     {
@@ -421,6 +558,8 @@ calculated_value & calculated_value::operator /= (
             "Division by zero error in calculated_value::operator /=" );
     }
     value_ /= divisor.get_exact_value();
+    SIGDIG_RECORD_DIGITS( divide, std::max( digits_, divisor.get_digit_count() ),
+        std::min( digits_, divisor.get_digit_count() ) );
     digits_ = std::min( digits_, divisor.get_digit_count() );
     most_sigdig_exponent_ = utility::calculate_exponent( value_ );
     least_sigdig_exponent_ = most_sigdig_exponent_ - digits_ + 1;
@@ -433,15 +572,24 @@ calculated_value & calculated_value::operator /= (
 calculated_value & calculated_value::operator /= (
     const defined_value & divisor )
 {
+    return operator /= ( divisor.get_value() );
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value & calculated_value::operator /= ( long double divisor )
+{
+    resolve_metadata();
     assert( is_sane() );
-    if ( divisor.get_value() == 0.0L )
+    helper::validate_input_value( divisor );
+    if ( divisor == 0.0L )
     {
         throw std::invalid_argument(
             "Division by zero error in calculated_value::operator /=" );
     }
     // No need to assign digits_ data member since the number of significant
     // digits does not change during operations with a defined value.
-    value_ /= divisor.get_value();
+    value_ /= divisor;
     most_sigdig_exponent_ = utility::calculate_exponent( value_ );
     least_sigdig_exponent_ = most_sigdig_exponent_ - digits_ + 1;
     assert( is_sane() );
@@ -452,6 +600,7 @@ calculated_value & calculated_value::operator /= (
 
 calculated_value & calculated_value::operator ++ ()
 {
+    resolve_metadata();
     assert( is_sane() );
     value_ += 1.0L;
     // No need to assign digits_ data member since the number of significant
@@ -470,6 +619,7 @@ calculated_value & calculated_value::operator ++ ()
 
 calculated_value & calculated_value::operator -- ()
 {
+    resolve_metadata();
     assert( is_sane() );
     value_ -= 1.0L;
     // No need to assign digits_ data member since the number of significant
@@ -488,6 +638,7 @@ calculated_value & calculated_value::operator -- ()
 
 calculated_value calculated_value::operator ++ ( int )
 {
+    resolve_metadata();
     assert( is_sane() );
     calculated_value post( *this );
     value_ += 1.0L;
@@ -507,6 +658,7 @@ calculated_value calculated_value::operator ++ ( int )
 
 calculated_value calculated_value::operator -- ( int )
 {
+    resolve_metadata();
     assert( is_sane() );
     calculated_value pre( *this );
     value_ -= 1.0L;
@@ -533,7 +685,7 @@ calculated_value calculated_value::square_root() const
             "Error. Cannot calculate the square root of a negative number." ); 
     }
     const long double v = std::sqrt( value_ );
-    calculated_value result( v, digits_ );
+    calculated_value result( v, get_digit_count() );
     return result;
 }
 
@@ -543,7 +695,7 @@ calculated_value calculated_value::cube_root() const
 {
     assert( is_sane() );
     const long double v = std::cbrt( value_ );
-    calculated_value result( v, digits_ );
+    calculated_value result( v, get_digit_count() );
     return result;
 }
 
@@ -552,8 +704,9 @@ calculated_value calculated_value::cube_root() const
 calculated_value calculated_value::sine() const
 {
     assert( is_sane() );
-    const long double v = std::sin( value_ );
-    calculated_value result( v, digits_ );
+    const long double v = helper::calculate_at_precision( value_, get_digit_count(),
+        []( auto x ) { return std::sin( x ); } );
+    calculated_value result( v, get_digit_count() );
     return result;
 }
 
@@ -562,8 +715,9 @@ calculated_value calculated_value::sine() const
 calculated_value calculated_value::cosine() const
 {
     assert( is_sane() );
-    const long double v = std::cos( value_ );
-    calculated_value result( v, digits_ );
+    const long double v = helper::calculate_at_precision( value_, get_digit_count(),
+        []( auto x ) { return std::cos( x ); } );
+    calculated_value result( v, get_digit_count() );
     return result;
 }
 
@@ -572,8 +726,9 @@ calculated_value calculated_value::cosine() const
 calculated_value calculated_value::tangent() const
 {
     assert( is_sane() );
-    const long double v = std::tan( value_ );
-    calculated_value result( v, digits_ );
+    const long double v = helper::calculate_at_precision( value_, get_digit_count(),
+        []( auto x ) { return std::tan( x ); } );
+    calculated_value result( v, get_digit_count() );
     return result;
 }
 
@@ -587,7 +742,7 @@ calculated_value calculated_value::arc_sine() const
         throw std::domain_error( "Error! Value for arc_sine must be from -1.0 to 1.0." );
     }
     const long double v = std::asin( value_ );
-    calculated_value result( v, digits_ );
+    calculated_value result( v, get_digit_count() );
     return result;
 }
 
@@ -601,7 +756,7 @@ calculated_value calculated_value::arc_cosine() const
         throw std::domain_error( "Error! Value for arc_cosine must be from -1.0 to 1.0." );
     }
     const long double v = std::acos( value_ );
-    calculated_value result( v, digits_ );
+    calculated_value result( v, get_digit_count() );
     return result;
 }
 
@@ -611,7 +766,7 @@ calculated_value calculated_value::arc_tangent() const
 {
     assert( is_sane() );
     const long double v = std::atan( value_ );
-    calculated_value result( v, digits_ );
+    calculated_value result( v, get_digit_count() );
     return result;
 }
 
@@ -625,7 +780,7 @@ calculated_value calculated_value::hyper_sine() const
         throw std::domain_error( "Error! Absolute value for hyper_sine may not be greater than 11357.0F." );
     }
     const long double v = std::sinh( value_ );
-    calculated_value result( v, digits_ );
+    calculated_value result( v, get_digit_count() );
     return result;
 }
 
@@ -639,7 +794,7 @@ calculated_value calculated_value::hyper_cosine() const
         throw std::domain_error( "Error! Absolute value for hyper_cosine may not be greater than 11357.0F." );
     }
     const long double v = std::cosh( value_ );
-    calculated_value result( v, digits_ );
+    calculated_value result( v, get_digit_count() );
     return result;
 }
 
@@ -649,7 +804,7 @@ calculated_value calculated_value::hyper_tangent() const
 {
     assert( is_sane() );
     const long double v = std::tanh( value_ );
-    calculated_value result( v, digits_ );
+    calculated_value result( v, get_digit_count() );
     return result;
 }
 
@@ -659,7 +814,7 @@ calculated_value calculated_value::hyper_arc_sine() const
 {
     assert( is_sane() );
     const long double v = std::asinh( value_ );
-    calculated_value result( v, digits_ );
+    calculated_value result( v, get_digit_count() );
     return result;
 }
 
@@ -673,7 +828,7 @@ calculated_value calculated_value::hyper_arc_cosine() const
         throw std::domain_error( "Error! Value for hyper_arc_cosine may not be less than 1.0." );
     }
     const long double v = std::acosh( value_ );
-    calculated_value result( v, digits_ );
+    calculated_value result( v, get_digit_count() );
     return result;
 }
 
@@ -687,7 +842,7 @@ calculated_value calculated_value::hyper_arc_tangent() const
         throw std::domain_error( "Error! Absolute value for hyper_arc_tangent must be less than 1.0." );
     }
     const long double v = std::atanh( value_ );
-    calculated_value result( v, digits_ );
+    calculated_value result( v, get_digit_count() );
     return result;
 }
 
@@ -697,7 +852,7 @@ calculated_value calculated_value::e_to_power_of() const
 {
     assert( is_sane() );
     const long double v = std::exp( value_ );
-    calculated_value result( v, digits_ );
+    calculated_value result( v, get_digit_count() );
     return result;
 }
 
@@ -707,7 +862,7 @@ calculated_value calculated_value::e_to_power_of_then_subtract_1() const
 {
     assert( is_sane() );
     const long double v = std::expm1( value_ );
-    calculated_value result( v, digits_ );
+    calculated_value result( v, get_digit_count() );
     return result;
 }
 
@@ -717,7 +872,7 @@ calculated_value calculated_value::two_to_power_of() const
 {
     assert( is_sane() );
     const long double v = std::exp2( value_ );
-    calculated_value result( v, digits_ );
+    calculated_value result( v, get_digit_count() );
     return result;
 }
 
@@ -727,7 +882,7 @@ calculated_value calculated_value::natural_log_of() const
 {
     assert( is_sane() );
     const long double v = std::log( value_ );
-    calculated_value result( v, digits_ );
+    calculated_value result( v, get_digit_count() );
     return result;
 }
 
@@ -737,7 +892,7 @@ calculated_value calculated_value::base_10_log_of() const
 {
     assert( is_sane() );
     const long double v = std::log10( value_ );
-    calculated_value result( v, digits_ );
+    calculated_value result( v, get_digit_count() );
     return result;
 }
 
@@ -747,7 +902,7 @@ calculated_value calculated_value::base_2_log_of() const
 {
     assert( is_sane() );
     const long double v = std::log2( value_ );
-    calculated_value result( v, digits_ );
+    calculated_value result( v, get_digit_count() );
     return result;
 }
 
@@ -0,0 +1,390 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#include "column_file.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#if defined( _WIN32 ) && !defined( __CYGWIN__ )
+    #define SIGDIG_NO_MMAP
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "helper.hpp"
+
+namespace sigdig {
+
+static const char column_file_magic[ 8 ] = { 'S', 'I', 'G', 'D', 'I', 'G', 'C', 'F' };
+
+static const std::uint32_t column_file_version = 1;
+
+/// Sections within the file start on this boundary so long doubles in a mapped file are aligned.
+static const std::uint64_t column_file_alignment = 16;
+
+// ----------------------------------------------------------------------------
+
+struct column_file_header
+{
+    char magic[ 8 ];
+    std::uint32_t version;
+    std::uint32_t long_double_size;
+    std::uint32_t record_size;
+    std::uint32_t block_count;
+    std::uint64_t value_count;
+    std::uint64_t records_offset;
+    std::uint64_t file_size;
+    std::uint8_t reserved[ 16 ];
+};
+
+static_assert( sizeof( column_file_header ) == 64, "Column file header must be 64 bytes." );
+
+// ----------------------------------------------------------------------------
+
+struct column_block_record
+{
+    std::uint64_t first;
+    std::uint64_t values_offset;
+    std::uint64_t digits_offset;
+    std::uint64_t exponents_offset;
+    std::uint32_t count;
+    std::uint32_t min_digits;
+    std::uint32_t max_digits;
+    std::uint32_t most_common_digits;
+    std::int32_t min_exponent;
+    std::int32_t max_exponent;
+    std::uint32_t reserved[ 2 ];
+    long double min_value;
+    long double max_value;
+};
+
+// ----------------------------------------------------------------------------
+
+static std::uint64_t align_file_offset( std::uint64_t offset )
+{
+    const std::uint64_t remainder = offset % column_file_alignment;
+    return ( remainder == 0 ) ? offset :
+        offset + ( column_file_alignment - remainder );
+}
+
+// ----------------------------------------------------------------------------
+
+/// Returns true if a section of count items of size bytes starting at offset is aligned and within length bytes.
+static bool is_section_in_file( std::uint64_t offset, std::uint64_t count, std::uint64_t size,
+    std::uint64_t alignment, std::uint64_t length )
+{
+    // Dividing instead of multiplying keeps a crafted count from overflowing.
+    return ( offset % alignment == 0 ) && ( offset <= length )
+        && ( count <= ( length - offset ) / size );
+}
+
+// ----------------------------------------------------------------------------
+
+static column_block_record calculate_block_record( const column_view & column,
+    std::size_t first, std::size_t count )
+{
+    assert( 0 < count );
+    column_block_record record;
+    std::memset( &record, 0, sizeof( record ) );
+    record.first = first;
+    record.count = static_cast< std::uint32_t >( count );
+    record.min_value = column.get_exact_value( first );
+    record.max_value = record.min_value;
+    record.min_digits = column.get_digit_count( first );
+    record.max_digits = record.min_digits;
+    record.min_exponent = column.get_most_sigdig_exponent( first );
+    record.max_exponent = record.min_exponent;
+    std::array< std::size_t, helper::max_range_of_digits_for_long_double + 1 > tally;
+    tally.fill( 0 );
+    for ( std::size_t ii = first; ii < first + count; ++ii )
+    {
+        const long double value = column.get_exact_value( ii );
+        const unsigned int digits = column.get_digit_count( ii );
+        const int exponent = column.get_most_sigdig_exponent( ii );
+        record.min_value = std::min( record.min_value, value );
+        record.max_value = std::max( record.max_value, value );
+        record.min_digits = std::min( record.min_digits, digits );
+        record.max_digits = std::max( record.max_digits, digits );
+        record.min_exponent = std::min( record.min_exponent, exponent );
+        record.max_exponent = std::max( record.max_exponent, exponent );
+        ++tally[ std::min< std::size_t >( digits, tally.size() - 1 ) ];
+    }
+    const auto most_common = std::max_element( tally.begin(), tally.end() );
+    record.most_common_digits =
+        static_cast< std::uint32_t >( most_common - tally.begin() );
+    return record;
+}
+
+// ----------------------------------------------------------------------------
+
+void column_file::write( const std::string & path, const column_view & column,
+    std::size_t block_size )
+{
+    if ( block_size == 0 )
+    {
+        throw std::invalid_argument( "Error! Column file blocks may not be empty." );
+    }
+    const std::size_t count = column.size();
+    const std::size_t block_count = ( count + block_size - 1 ) / block_size;
+    // The header and records store these counts in 32 bits.
+    const std::size_t max_count = std::numeric_limits< std::uint32_t >::max();
+    if ( ( block_count > max_count ) || ( std::min( block_size, count ) > max_count ) )
+    {
+        throw std::length_error( "Error! Column has too many blocks or values per block for a column file." );
+    }
+
+    column_file_header header;
+    std::memset( &header, 0, sizeof( header ) );
+    std::memcpy( header.magic, column_file_magic, sizeof( header.magic ) );
+    header.version = column_file_version;
+    header.long_double_size = sizeof( long double );
+    header.record_size = sizeof( column_block_record );
+    header.block_count = static_cast< std::uint32_t >( block_count );
+    header.value_count = count;
+    header.records_offset = align_file_offset( sizeof( header ) );
+
+    const std::uint64_t values_offset = align_file_offset(
+        header.records_offset + block_count * sizeof( column_block_record ) );
+    const std::uint64_t digits_offset = align_file_offset(
+        values_offset + count * sizeof( long double ) );
+    const std::uint64_t exponents_offset = align_file_offset(
+        digits_offset + count * sizeof( unsigned int ) );
+    header.file_size = exponents_offset + count * sizeof( int );
+
+    std::vector< column_block_record > records;
+    records.reserve( block_count );
+    for ( std::size_t first = 0; first < count; first += block_size )
+    {
+        const std::size_t values_in_block = std::min( block_size, count - first );
+        column_block_record record =
+            calculate_block_record( column, first, values_in_block );
+        record.values_offset = values_offset + first * sizeof( long double );
+        record.digits_offset = digits_offset + first * sizeof( unsigned int );
+        record.exponents_offset = exponents_offset + first * sizeof( int );
+        records.push_back( record );
+    }
+
+    std::ofstream out( path, std::ios::binary | std::ios::trunc );
+    if ( !out )
+    {
+        throw std::runtime_error( "Error! Unable to open column file for writing: " + path );
+    }
+    const std::array< char, column_file_alignment > padding = {};
+    auto pad_to = [ &out, &padding ]( std::uint64_t offset )
+    {
+        const std::uint64_t place = static_cast< std::uint64_t >( out.tellp() );
+        assert( place <= offset );
+        out.write( padding.data(), static_cast< std::streamsize >( offset - place ) );
+    };
+    out.write( reinterpret_cast< const char * >( &header ), sizeof( header ) );
+    pad_to( header.records_offset );
+    out.write( reinterpret_cast< const char * >( records.data() ),
+        records.size() * sizeof( column_block_record ) );
+    pad_to( values_offset );
+    out.write( reinterpret_cast< const char * >( column.get_values() ),
+        count * sizeof( long double ) );
+    pad_to( digits_offset );
+    out.write( reinterpret_cast< const char * >( column.get_digit_counts() ),
+        count * sizeof( unsigned int ) );
+    pad_to( exponents_offset );
+    out.write( reinterpret_cast< const char * >( column.get_most_sigdig_exponents() ),
+        count * sizeof( int ) );
+    out.flush();
+    if ( !out )
+    {
+        throw std::runtime_error( "Error! Unable to write column file: " + path );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+mapped_column_file::mapped_column_file( const std::string & path ) :
+    address_( nullptr ),
+    length_( 0 ),
+    view_(),
+    blocks_()
+{
+#ifdef SIGDIG_NO_MMAP
+    std::ifstream in( path, std::ios::binary | std::ios::ate );
+    if ( !in )
+    {
+        throw std::runtime_error( "Error! Unable to open column file: " + path );
+    }
+    length_ = static_cast< std::size_t >( in.tellg() );
+    // The memory from malloc is aligned well enough for long doubles.
+    address_ = std::malloc( std::max< std::size_t >( length_, 1 ) );
+    if ( nullptr == address_ )
+    {
+        throw std::bad_alloc();
+    }
+    in.seekg( 0 );
+    in.read( static_cast< char * >( address_ ), length_ );
+    if ( !in )
+    {
+        unmap();
+        throw std::runtime_error( "Error! Unable to read column file: " + path );
+    }
+#else
+    const int handle = ::open( path.c_str(), O_RDONLY );
+    if ( handle < 0 )
+    {
+        throw std::runtime_error( "Error! Unable to open column file: " + path );
+    }
+    struct stat status;
+    if ( ::fstat( handle, &status ) != 0 )
+    {
+        ::close( handle );
+        throw std::runtime_error( "Error! Unable to find size of column file: " + path );
+    }
+    length_ = static_cast< std::size_t >( status.st_size );
+    if ( length_ < sizeof( column_file_header ) )
+    {
+        ::close( handle );
+        throw std::runtime_error( "Error! File is too small to be a column file: " + path );
+    }
+    void * place = ::mmap( nullptr, length_, PROT_READ, MAP_SHARED, handle, 0 );
+    ::close( handle );
+    if ( place == MAP_FAILED )
+    {
+        throw std::runtime_error( "Error! Unable to map column file into memory: " + path );
+    }
+    address_ = place;
+#endif
+
+    const char * bytes = static_cast< const char * >( address_ );
+    const column_file_header * header =
+        reinterpret_cast< const column_file_header * >( bytes );
+    const bool is_valid_header = ( length_ >= sizeof( column_file_header ) )
+        && ( std::memcmp( header->magic, column_file_magic, sizeof( header->magic ) ) == 0 )
+        && ( header->version == column_file_version )
+        && ( header->long_double_size == sizeof( long double ) )
+        && ( header->record_size == sizeof( column_block_record ) )
+        && ( header->file_size == length_ )
+        && is_section_in_file( header->records_offset, header->block_count,
+            sizeof( column_block_record ), alignof( column_block_record ), length_ );
+    if ( !is_valid_header )
+    {
+        unmap();
+        throw std::runtime_error( "Error! File is not a compatible column file: " + path );
+    }
+
+    const column_block_record * records =
+        reinterpret_cast< const column_block_record * >( bytes + header->records_offset );
+    const std::size_t count = header->value_count;
+    blocks_.reserve( header->block_count );
+    std::size_t expected_first = 0;
+    for ( std::uint32_t ii = 0; ii < header->block_count; ++ii )
+    {
+        // The view covers every block as one range, so each block must start
+        // where the one before it ended.
+        const column_block_record & record = records[ ii ];
+        const bool is_valid_record = ( record.first == expected_first )
+            && ( record.values_offset == records[ 0 ].values_offset + expected_first * sizeof( long double ) )
+            && ( record.digits_offset == records[ 0 ].digits_offset + expected_first * sizeof( unsigned int ) )
+            && ( record.exponents_offset == records[ 0 ].exponents_offset + expected_first * sizeof( int ) );
+        if ( !is_valid_record )
+        {
+            unmap();
+            throw std::runtime_error( "Error! Column file has a corrupt block record: " + path );
+        }
+        column_block_stats stats;
+        stats.first = record.first;
+        stats.count = record.count;
+        stats.min_value = record.min_value;
+        stats.max_value = record.max_value;
+        stats.min_digits = record.min_digits;
+        stats.max_digits = record.max_digits;
+        stats.most_common_digits = record.most_common_digits;
+        stats.min_exponent = record.min_exponent;
+        stats.max_exponent = record.max_exponent;
+        blocks_.push_back( stats );
+        expected_first += record.count;
+    }
+    if ( expected_first != count )
+    {
+        unmap();
+        throw std::runtime_error( "Error! Column file blocks do not cover every value: " + path );
+    }
+    const bool are_sections_in_file = ( 0 == count ) || (
+        is_section_in_file( records[ 0 ].values_offset, count, sizeof( long double ),
+            alignof( long double ), length_ )
+        && is_section_in_file( records[ 0 ].digits_offset, count, sizeof( unsigned int ),
+            alignof( unsigned int ), length_ )
+        && is_section_in_file( records[ 0 ].exponents_offset, count, sizeof( int ),
+            alignof( int ), length_ ) );
+    if ( !are_sections_in_file )
+    {
+        unmap();
+        throw std::runtime_error( "Error! Column file sections do not fit in the file: " + path );
+    }
+
+    if ( 0 < count )
+    {
+        // The writer stores each section contiguously, so the first block
+        // record tells where every section starts.
+        view_ = column_view(
+            reinterpret_cast< const long double * >( bytes + records[ 0 ].values_offset ),
+            reinterpret_cast< const unsigned int * >( bytes + records[ 0 ].digits_offset ),
+            reinterpret_cast< const int * >( bytes + records[ 0 ].exponents_offset ),
+            count );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+mapped_column_file::~mapped_column_file()
+{
+    unmap();
+}
+
+// ----------------------------------------------------------------------------
+
+void mapped_column_file::unmap()
+{
+    if ( nullptr == address_ )
+    {
+        return;
+    }
+#ifdef SIGDIG_NO_MMAP
+    std::free( address_ );
+#else
+    ::munmap( address_, length_ );
+#endif
+    address_ = nullptr;
+    length_ = 0;
+}
+
+// ----------------------------------------------------------------------------
+
+const column_block_stats & mapped_column_file::get_block_stats(
+    std::size_t block ) const
+{
+    return blocks_.at( block );
+}
+
+// ----------------------------------------------------------------------------
+
+column_view mapped_column_file::get_block( std::size_t block ) const
+{
+    const column_block_stats & stats = blocks_.at( block );
+    return view_.slice( stats.first, stats.count );
+}
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
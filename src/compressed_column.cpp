@@ -0,0 +1,78 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#include "compressed_column.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+compressed_column::compressed_column() :
+    values_(),
+    digits_(),
+    exponents_()
+{
+}
+
+// ----------------------------------------------------------------------------
+
+compressed_column::compressed_column( const column_view & column ) :
+    values_( column.get_values(), column.get_values() + column.size() ),
+    digits_( column.get_digit_counts(), column.size() ),
+    exponents_( column.get_most_sigdig_exponents(), column.size() )
+{
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value compressed_column::get( std::size_t index ) const
+{
+    if ( index >= values_.size() )
+    {
+        throw std::out_of_range( "Error! Index is outside of compressed_column." );
+    }
+    const unsigned int digits = get_digit_count( index );
+    const int exponent = get_most_sigdig_exponent( index );
+    const column_view single( &values_[ index ], &digits, &exponent, 1 );
+    return single.get( 0 );
+}
+
+// ----------------------------------------------------------------------------
+
+void compressed_column::decode( std::size_t first, std::size_t count,
+    significant_column & target ) const
+{
+    if ( ( first > values_.size() ) || ( count > values_.size() - first ) )
+    {
+        throw std::out_of_range( "Error! Range is outside of compressed_column." );
+    }
+    target.resize( count );
+    std::copy( values_.begin() + first, values_.begin() + first + count, target.get_values() );
+    digits_.view().decode( first, count, target.get_digit_counts() );
+    exponents_.view().decode( first, count, target.get_most_sigdig_exponents() );
+}
+
+// ----------------------------------------------------------------------------
+
+void compressed_column::decode( significant_column & target ) const
+{
+    decode( 0, values_.size(), target );
+}
+
+// ----------------------------------------------------------------------------
+
+std::size_t compressed_column::get_byte_count() const
+{
+    return values_.size() * sizeof( long double ) + digits_.get_byte_count()
+        + exponents_.get_byte_count();
+}
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
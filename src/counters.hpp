@@ -0,0 +1,70 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#pragma once
+
+#ifndef SIGDIG_COUNTERS_HPP
+#define SIGDIG_COUNTERS_HPP
+
+#include "operation_counters.hpp"
+
+#ifdef SIGDIG_COUNTERS
+
+#include <atomic>
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+/** @class thread_counters The counters for one thread. Only the owning thread
+ changes them, so incrementing is a plain load and store instead of a locked
+ add. They are atomic only so a snapshot can read them from another thread.
+ */
+
+class thread_counters
+{
+public:
+
+    thread_counters();
+
+    ~thread_counters();
+
+    thread_counters( const thread_counters & ) = delete;
+
+    thread_counters & operator = ( const thread_counters & ) = delete;
+
+    inline void increment( operation_counter which )
+    {
+        std::atomic< unsigned long long > & count = counts_[ static_cast< std::size_t >( which ) ];
+        count.store( count.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+    }
+
+    inline unsigned long long get( std::size_t index ) const
+    {
+        return counts_[ index ].load( std::memory_order_relaxed );
+    }
+
+private:
+
+    std::atomic< unsigned long long > counts_[ counter_snapshot::counter_count ];
+
+};
+
+extern thread_local thread_counters local_counters;
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
+
+#define SIGDIG_COUNT( name ) ::sigdig::local_counters.increment( ::sigdig::operation_counter::name )
+
+#else
+
+#define SIGDIG_COUNT( name ) static_cast< void >( 0 )
+
+#endif
+
+#endif
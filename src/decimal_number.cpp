@@ -0,0 +1,525 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#include "decimal_number.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "helper.hpp"
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+template < typename T >
+static T calculate_power_of_ten( unsigned int exponent )
+{
+    if ( exponent <= 19 )
+    {
+        return static_cast< T >( helper::get_integer_power_of_ten( exponent ) );
+    }
+    return static_cast< T >( helper::get_integer_power_of_ten( 19 ) )
+        * static_cast< T >( helper::get_integer_power_of_ten( exponent - 19 ) );
+}
+
+// ----------------------------------------------------------------------------
+
+/// Writes the decimal digits of value into chars, and returns how many were written.
+template < typename T >
+static unsigned int write_decimal_digits( T value, char * chars )
+{
+    char reversed[ 40 ];
+    unsigned int count = 0;
+    do
+    {
+        reversed[ count++ ] = static_cast< char >( '0' + static_cast< unsigned int >( value % 10 ) );
+        value /= 10;
+    } while ( value != 0 );
+    for ( unsigned int ii = 0; ii < count; ++ii )
+    {
+        chars[ ii ] = reversed[ count - 1 - ii ];
+    }
+    return count;
+}
+
+// ----------------------------------------------------------------------------
+
+template < typename Traits >
+int decimal_number< Traits >::get_lowest_exponent()
+{
+    return -Traits::exponent_bias;
+}
+
+// ----------------------------------------------------------------------------
+
+template < typename Traits >
+int decimal_number< Traits >::get_highest_exponent()
+{
+    // The top two bits of the exponent field can not both be set.
+    const int highest_biased = ( 3 << ( Traits::exponent_bits - 2 ) ) - 1;
+    return highest_biased - Traits::exponent_bias;
+}
+
+// ----------------------------------------------------------------------------
+
+template < typename Traits >
+typename decimal_number< Traits >::coefficient_type decimal_number< Traits >::get_max_coefficient()
+{
+    return calculate_power_of_ten< coefficient_type >( Traits::max_digits ) - 1;
+}
+
+// ----------------------------------------------------------------------------
+
+template < typename Traits >
+decimal_number< Traits >::decimal_number() :
+    bits_( static_cast< bits_type >( Traits::exponent_bias )
+        << ( Traits::total_bits - 1 - Traits::exponent_bits ) )
+{
+}
+
+// ----------------------------------------------------------------------------
+
+template < typename Traits >
+decimal_number< Traits >::decimal_number( bool negative, coefficient_type coefficient, int exponent ) :
+    bits_( 0 )
+{
+    if ( coefficient > get_max_coefficient() )
+    {
+        throw std::invalid_argument( "Error! Coefficient has too many digits for decimal format." );
+    }
+    if ( ( exponent < get_lowest_exponent() ) || ( get_highest_exponent() < exponent ) )
+    {
+        throw std::domain_error( "Error! Exponent is outside range of decimal format." );
+    }
+
+    const unsigned int small_coefficient_bits = Traits::total_bits - 1 - Traits::exponent_bits;
+    const bits_type one = 1;
+    const bits_type biased = static_cast< bits_type >( exponent + Traits::exponent_bias );
+    bits_ = ( negative ) ? ( one << ( Traits::total_bits - 1 ) ) : 0;
+    if ( coefficient < ( one << small_coefficient_bits ) )
+    {
+        bits_ |= ( biased << small_coefficient_bits ) | coefficient;
+    }
+    else
+    {
+        // Coefficients that do not fit start with an implied 100 in binary,
+        // and the exponent moves right by two bits to make room for the 11
+        // that marks this form.
+        const unsigned int large_coefficient_bits = small_coefficient_bits - 2;
+        bits_ |= ( static_cast< bits_type >( 3 ) << ( Traits::total_bits - 3 ) )
+            | ( biased << large_coefficient_bits )
+            | ( coefficient - ( one << small_coefficient_bits ) );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+template < typename Traits >
+decimal_number< Traits > decimal_number< Traits >::from_string( const char * source )
+{
+    if ( ( nullptr == source ) || ( '\0' == *source ) )
+    {
+        throw std::invalid_argument( "Error! String is empty instead of containing number." );
+    }
+
+    const char * s = source;
+    const bool negative = ( '-' == *s );
+    if ( ( '-' == *s ) || ( '+' == *s ) )
+    {
+        ++s;
+    }
+
+    coefficient_type coefficient = 0;
+    unsigned int digits = 0;
+    int exponent = 0;
+    bool found_digit = false;
+    bool found_point = false;
+    for ( ; ; ++s )
+    {
+        const char ch = *s;
+        if ( '.' == ch )
+        {
+            if ( found_point )
+            {
+                throw std::invalid_argument(
+                    "Error! String containing number may not have more than one decimal point." );
+            }
+            found_point = true;
+            continue;
+        }
+        if ( ( ch < '0' ) || ( '9' < ch ) )
+        {
+            break;
+        }
+        found_digit = true;
+        if ( found_point )
+        {
+            --exponent;
+        }
+        if ( ( 0 == coefficient ) && ( '0' == ch ) )
+        {
+            // Leading zeros are never significant.
+            continue;
+        }
+        if ( digits == Traits::max_digits )
+        {
+            throw std::invalid_argument( "Error! String has more digits than decimal format can store." );
+        }
+        coefficient = coefficient * 10 + static_cast< unsigned int >( ch - '0' );
+        ++digits;
+    }
+    if ( !found_digit )
+    {
+        throw std::invalid_argument( "Error! String does not contain a number." );
+    }
+
+    if ( ( 'e' == *s ) || ( 'E' == *s ) )
+    {
+        ++s;
+        const bool negative_exponent = ( '-' == *s );
+        if ( ( '-' == *s ) || ( '+' == *s ) )
+        {
+            ++s;
+        }
+        if ( ( *s < '0' ) || ( '9' < *s ) )
+        {
+            throw std::invalid_argument( "Error! String does not contain number in scientific notation." );
+        }
+        int scientific_exponent = 0;
+        for ( ; ( '0' <= *s ) && ( *s <= '9' ); ++s )
+        {
+            // Stop accumulating once the exponent is far outside every format's range.
+            if ( scientific_exponent < 100000 )
+            {
+                scientific_exponent = scientific_exponent * 10 + ( *s - '0' );
+            }
+        }
+        exponent += ( negative_exponent ) ? -scientific_exponent : scientific_exponent;
+    }
+
+    if ( 0 == coefficient )
+    {
+        // A zero can move to the nearest exponent in range without losing anything.
+        exponent = ( exponent < get_lowest_exponent() ) ? get_lowest_exponent() :
+            ( get_highest_exponent() < exponent ) ? get_highest_exponent() : exponent;
+    }
+    return decimal_number( negative, coefficient, exponent );
+}
+
+// ----------------------------------------------------------------------------
+
+template < typename Traits >
+decimal_number< Traits > decimal_number< Traits >::from_string( const std::string & source )
+{
+    return from_string( source.c_str() );
+}
+
+// ----------------------------------------------------------------------------
+
+template < typename Traits >
+decimal_number< Traits > decimal_number< Traits >::from_value( long double value, unsigned int digits )
+{
+    helper::validate_input_value( value );
+    if ( ( 0 == digits ) || ( Traits::max_digits < digits ) )
+    {
+        throw std::invalid_argument( "Error! Number of digits is outside range of decimal format." );
+    }
+    char chars[ 64 ];
+    std::snprintf( chars, sizeof( chars ), "%.*Le", static_cast< int >( digits - 1 ), value );
+    return from_string( chars );
+}
+
+// ----------------------------------------------------------------------------
+
+template < typename Traits >
+decimal_number< Traits > decimal_number< Traits >::from_bits( bits_type bits )
+{
+    const decimal_number result( bits );
+    const unsigned int combination = static_cast< unsigned int >(
+        ( bits >> ( Traits::total_bits - 6 ) ) & 0x1F );
+    if ( ( combination & 0x1E ) == 0x1E )
+    {
+        throw std::invalid_argument( "Error! Decimal encoding holds an infinity or NaN." );
+    }
+    const int exponent = result.get_exponent();
+    if ( ( get_highest_exponent() < exponent ) || ( get_max_coefficient() < result.get_coefficient() ) )
+    {
+        throw std::invalid_argument( "Error! Decimal encoding is not canonical." );
+    }
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+
+template < typename Traits >
+bool decimal_number< Traits >::is_negative() const
+{
+    return ( ( bits_ >> ( Traits::total_bits - 1 ) ) != 0 );
+}
+
+// ----------------------------------------------------------------------------
+
+template < typename Traits >
+bool decimal_number< Traits >::is_zero() const
+{
+    return ( 0 == get_coefficient() );
+}
+
+// ----------------------------------------------------------------------------
+
+template < typename Traits >
+typename decimal_number< Traits >::coefficient_type decimal_number< Traits >::get_coefficient() const
+{
+    const unsigned int small_coefficient_bits = Traits::total_bits - 1 - Traits::exponent_bits;
+    const bits_type one = 1;
+    if ( ( ( bits_ >> ( Traits::total_bits - 3 ) ) & 3 ) == 3 )
+    {
+        const unsigned int large_coefficient_bits = small_coefficient_bits - 2;
+        return ( one << small_coefficient_bits ) | ( bits_ & ( ( one << large_coefficient_bits ) - 1 ) );
+    }
+    return ( bits_ & ( ( one << small_coefficient_bits ) - 1 ) );
+}
+
+// ----------------------------------------------------------------------------
+
+template < typename Traits >
+int decimal_number< Traits >::get_exponent() const
+{
+    const unsigned int small_coefficient_bits = Traits::total_bits - 1 - Traits::exponent_bits;
+    const bits_type mask = ( static_cast< bits_type >( 1 ) << Traits::exponent_bits ) - 1;
+    const unsigned int shift = ( ( ( bits_ >> ( Traits::total_bits - 3 ) ) & 3 ) == 3 ) ?
+        small_coefficient_bits - 2 : small_coefficient_bits;
+    return static_cast< int >( ( bits_ >> shift ) & mask ) - Traits::exponent_bias;
+}
+
+// ----------------------------------------------------------------------------
+
+template < typename Traits >
+unsigned int decimal_number< Traits >::get_digit_count() const
+{
+    return helper::count_decimal_digits( get_coefficient() );
+}
+
+// ----------------------------------------------------------------------------
+
+template < typename Traits >
+unsigned int decimal_number< Traits >::count_significant_digits() const
+{
+    const coefficient_type coefficient = get_coefficient();
+    const int exponent = get_exponent();
+    if ( 0 == coefficient )
+    {
+        // The zeros right of the decimal point are significant, as in 0.00.
+        return ( exponent < 0 ) ? static_cast< unsigned int >( 1 - exponent ) : 1;
+    }
+    const unsigned int digits = helper::count_decimal_digits( coefficient );
+    if ( exponent != 0 )
+    {
+        return digits;
+    }
+    return digits - helper::count_trailing_decimal_zeros( coefficient );
+}
+
+// ----------------------------------------------------------------------------
+
+template < typename Traits >
+int decimal_number< Traits >::get_most_significant_exponent() const
+{
+    if ( is_zero() )
+    {
+        return std::max( 0, get_exponent() );
+    }
+    return get_exponent() + static_cast< int >( get_digit_count() ) - 1;
+}
+
+// ----------------------------------------------------------------------------
+
+template < typename Traits >
+decimal_number< Traits > decimal_number< Traits >::round_to_digits( unsigned int digits,
+    rounding_style rounding ) const
+{
+    if ( 0 == digits )
+    {
+        throw std::invalid_argument( "Error! Can not round to zero digits." );
+    }
+    const coefficient_type coefficient = get_coefficient();
+    const unsigned int current = helper::count_decimal_digits( coefficient );
+    if ( ( 0 == coefficient ) || ( current <= digits ) )
+    {
+        return *this;
+    }
+
+    unsigned int shift = current - digits;
+    const coefficient_type divisor = calculate_power_of_ten< coefficient_type >( shift );
+    coefficient_type quotient = coefficient / divisor;
+    const coefficient_type remainder = coefficient % divisor;
+    const bool negative = is_negative();
+    bool away_from_zero = false;
+    switch ( rounding )
+    {
+        case rounding_style::truncate   : away_from_zero = false; break;
+        case rounding_style::floor      : away_from_zero = ( negative && ( remainder != 0 ) ); break;
+        case rounding_style::round_half : away_from_zero = ( remainder >= divisor / 2 ); break;
+        case rounding_style::ceiling    : away_from_zero = ( !negative && ( remainder != 0 ) ); break;
+        case rounding_style::from_zero  : away_from_zero = ( remainder != 0 ); break;
+    }
+    if ( away_from_zero )
+    {
+        ++quotient;
+        if ( quotient == calculate_power_of_ten< coefficient_type >( digits ) )
+        {
+            // Rounding 999 up to 2 digits gives 100, which needs one less digit than it has.
+            quotient /= 10;
+            ++shift;
+        }
+    }
+    return decimal_number( negative, quotient, get_exponent() + static_cast< int >( shift ) );
+}
+
+// ----------------------------------------------------------------------------
+
+template < typename Traits >
+long double decimal_number< Traits >::to_long_double() const
+{
+    const coefficient_type coefficient = get_coefficient();
+    const int exponent = get_exponent();
+    // Powers of ten up to 10^27 are exact in a long double, as is any 64-bit
+    // coefficient, so one multiply or divide gives a correctly rounded result.
+    const coefficient_type largest_exact = static_cast< coefficient_type >( ~0ULL );
+    if ( ( coefficient <= largest_exact ) && ( -27 <= exponent ) && ( exponent <= 27 ) )
+    {
+        long double value = static_cast< long double >( static_cast< unsigned long long >( coefficient ) );
+        if ( exponent < 0 )
+        {
+            value /= calculate_power_of_ten< long double >( -exponent );
+        }
+        else if ( exponent > 0 )
+        {
+            value *= calculate_power_of_ten< long double >( exponent );
+        }
+        return ( is_negative() ) ? -value : value;
+    }
+    const std::string chars = to_string( format_style::decimal_exponent );
+    return std::strtold( chars.c_str(), nullptr );
+}
+
+// ----------------------------------------------------------------------------
+
+template < typename Traits >
+std::string decimal_number< Traits >::to_string( format_style formatting ) const
+{
+    if ( format_style::hexadecimal_exponent == formatting )
+    {
+        throw std::invalid_argument( "Error! Decimal numbers can not be written in hexadecimal notation." );
+    }
+
+    char digits[ 40 ];
+    const int count = static_cast< int >( write_decimal_digits( get_coefficient(), digits ) );
+    const int exponent = get_exponent();
+    std::string result;
+    result.reserve( count + 16 );
+    if ( is_negative() )
+    {
+        result += '-';
+    }
+
+    if ( format_style::decimal_exponent == formatting )
+    {
+        result += digits[ 0 ];
+        if ( count > 1 )
+        {
+            result += '.';
+            result.append( digits + 1, count - 1 );
+        }
+        const int scientific_exponent = exponent + count - 1;
+        char chars[ 16 ];
+        std::snprintf( chars, sizeof( chars ), "e%+03d", scientific_exponent );
+        result += chars;
+        return result;
+    }
+
+    if ( exponent >= 0 )
+    {
+        result.append( digits, count );
+        result.append( static_cast< std::size_t >( exponent ), '0' );
+        return result;
+    }
+    const int point = count + exponent;
+    if ( point > 0 )
+    {
+        result.append( digits, point );
+        result += '.';
+        result.append( digits + point, count - point );
+    }
+    else
+    {
+        result += "0.";
+        result.append( static_cast< std::size_t >( -point ), '0' );
+        result.append( digits, count );
+    }
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+
+template < typename Traits >
+int decimal_number< Traits >::compare( const decimal_number & that ) const
+{
+    const int this_sign = ( is_zero() ) ? 0 : ( is_negative() ) ? -1 : 1;
+    const int that_sign = ( that.is_zero() ) ? 0 : ( that.is_negative() ) ? -1 : 1;
+    if ( this_sign != that_sign )
+    {
+        return ( this_sign < that_sign ) ? -1 : 1;
+    }
+    if ( 0 == this_sign )
+    {
+        return 0;
+    }
+
+    int magnitude = 0;
+    const int this_place = get_most_significant_exponent();
+    const int that_place = that.get_most_significant_exponent();
+    if ( this_place != that_place )
+    {
+        magnitude = ( this_place < that_place ) ? -1 : 1;
+    }
+    else
+    {
+        // Both most significant digits are in the same place, so scaling up the
+        // coefficient with fewer digits can not overflow.
+        coefficient_type this_coefficient = get_coefficient();
+        coefficient_type that_coefficient = that.get_coefficient();
+        const int this_exponent = get_exponent();
+        const int that_exponent = that.get_exponent();
+        if ( this_exponent > that_exponent )
+        {
+            this_coefficient *= calculate_power_of_ten< coefficient_type >( this_exponent - that_exponent );
+        }
+        else if ( that_exponent > this_exponent )
+        {
+            that_coefficient *= calculate_power_of_ten< coefficient_type >( that_exponent - this_exponent );
+        }
+        magnitude = ( this_coefficient < that_coefficient ) ? -1 :
+            ( that_coefficient < this_coefficient ) ? 1 : 0;
+    }
+    return ( this_sign > 0 ) ? magnitude : -magnitude;
+}
+
+// ----------------------------------------------------------------------------
+
+template class decimal_number< decimal64_traits >;
+
+#ifdef __SIZEOF_INT128__
+template class decimal_number< decimal128_traits >;
+#endif
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
@@ -16,6 +16,7 @@
 
 #include "significant_value.hpp"
 #include "calculated_value.hpp"
+#include "counters.hpp"
 #include "helper.hpp"
 
 namespace sigdig {
@@ -26,6 +27,7 @@ defined_value::defined_value( long double value ) :
     value_( helper::validate_input_value( value ) ),
     exponent_( utility::calculate_exponent( value ) )
 {
+    SIGDIG_COUNT( defined_value_constructions );
     assert( is_sane() );
 }
 
@@ -35,6 +37,7 @@ defined_value::defined_value( long value ) :
     value_( static_cast< long double >( value ) ),
     exponent_( utility::calculate_exponent( value ) )
 {
+    SIGDIG_COUNT( defined_value_constructions );
     assert( is_sane() );
 }
 
@@ -44,50 +47,83 @@ defined_value::defined_value( unsigned long value ) :
     value_( static_cast< long double >( value ) ),
     exponent_( utility::calculate_exponent( value ) )
 {
+    SIGDIG_COUNT( defined_value_constructions );
     assert( is_sane() );
 }
 
 // ----------------------------------------------------------------------------
 
-defined_value::defined_value( const char * value ) :
-    value_( helper::validate_input_value( value ) ),
-    exponent_( utility::calculate_exponent( value_ ) )
+defined_value::defined_value( long long value ) :
+    value_( static_cast< long double >( value ) ),
+    exponent_( utility::calculate_exponent( value ) )
 {
+    SIGDIG_COUNT( defined_value_constructions );
     assert( is_sane() );
 }
 
 // ----------------------------------------------------------------------------
 
-defined_value::defined_value( const std::string & value ) :
-    value_( helper::validate_input_value( value.c_str() ) ),
-    exponent_( utility::calculate_exponent( value_ ) )
+defined_value::defined_value( unsigned long long value ) :
+    value_( static_cast< long double >( value ) ),
+    exponent_( utility::calculate_exponent( value ) )
 {
+    SIGDIG_COUNT( defined_value_constructions );
     assert( is_sane() );
 }
 
 // ----------------------------------------------------------------------------
 
-defined_value::defined_value( long double value, int exponent ) :
+#ifdef __SIZEOF_INT128__
+
+defined_value::defined_value( __int128 value ) :
+    value_( static_cast< long double >( value ) ),
+    exponent_( utility::calculate_exponent( value ) )
+{
+    SIGDIG_COUNT( defined_value_constructions );
+    assert( is_sane() );
+}
+
+// ----------------------------------------------------------------------------
+
+defined_value::defined_value( unsigned __int128 value ) :
+    value_( static_cast< long double >( value ) ),
+    exponent_( utility::calculate_exponent( value ) )
+{
+    SIGDIG_COUNT( defined_value_constructions );
+    assert( is_sane() );
+}
+
+// ----------------------------------------------------------------------------
+
+#endif
+
+// ----------------------------------------------------------------------------
+
+defined_value::defined_value( const char * value ) :
     value_( helper::validate_input_value( value ) ),
-    exponent_( exponent )
+    exponent_( utility::calculate_exponent( value_ ) )
 {
+    SIGDIG_COUNT( defined_value_constructions );
     assert( is_sane() );
 }
 
 // ----------------------------------------------------------------------------
 
-defined_value::defined_value( const defined_value & that ) :
-    value_ ( that.value_ ),
-    exponent_( that.exponent_ )
+defined_value::defined_value( const std::string & value ) :
+    value_( helper::validate_input_value( value.c_str() ) ),
+    exponent_( utility::calculate_exponent( value_ ) )
 {
-    assert( that.is_sane() );
+    SIGDIG_COUNT( defined_value_constructions );
     assert( is_sane() );
 }
 
 // ----------------------------------------------------------------------------
 
-defined_value::~defined_value()
+defined_value::defined_value( long double value, int exponent ) :
+    value_( helper::validate_input_value( value ) ),
+    exponent_( exponent )
 {
+    SIGDIG_COUNT( defined_value_constructions );
     assert( is_sane() );
 }
 
@@ -123,20 +159,6 @@ defined_value & defined_value::operator = ( unsigned long value )
 
 // ----------------------------------------------------------------------------
 
-defined_value & defined_value::operator = ( const defined_value & that )
-{
-    assert( is_sane() );
-    assert( that.is_sane() );
-    if ( this != &that )
-    {
-        value_ = that.value_;
-        exponent_ = that.exponent_;
-    }
-    return *this;
-}
-
-// ----------------------------------------------------------------------------
-
 defined_value defined_value::operator - () const
 {
     assert( is_sane() );
@@ -885,6 +907,29 @@ std::string defined_value::to_string( unsigned int digits,
 
 // ----------------------------------------------------------------------------
 
+std::pmr::string defined_value::to_string( std::pmr::memory_resource * resource,
+    format_style formatting, rounding_style rounding, bool show_decimal ) const
+{
+    assert( is_sane() );
+    return helper::to_string( resource, value_, exponent_,
+        utility::count_significant_digits( value_ ), formatting, rounding,
+        show_decimal );
+}
+
+// ----------------------------------------------------------------------------
+
+std::pmr::string defined_value::to_string( std::pmr::memory_resource * resource,
+    unsigned int digits, format_style formatting, rounding_style rounding,
+    bool show_decimal ) const
+{
+    assert( is_sane() );
+    helper::validate_digit_count( digits );
+    return helper::to_string( resource, value_, exponent_, digits,
+        formatting, rounding, show_decimal );
+}
+
+// ----------------------------------------------------------------------------
+
 bool defined_value::is_sane() const
 {
     assert( this != nullptr );
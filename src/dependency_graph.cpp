@@ -0,0 +1,311 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#include "dependency_graph.hpp"
+
+#include <cassert>
+
+#include <stdexcept>
+
+#include "helper.hpp"
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+/// Returns true if both have the same value and the same significant digits.
+static bool are_identical( const significant_value & left, const significant_value & right )
+{
+    return ( left.get_exact_value() == right.get_exact_value() )
+        && ( left.get_digit_count() == right.get_digit_count() )
+        && ( left.get_most_sigdig_exponent() == right.get_most_sigdig_exponent() );
+}
+
+// ----------------------------------------------------------------------------
+
+dependency_graph::dependency_graph() :
+    nodes_(),
+    dependents_(),
+    queued_(),
+    dirty_()
+{
+}
+
+// ----------------------------------------------------------------------------
+
+void dependency_graph::validate_node( node_id node ) const
+{
+    if ( node >= nodes_.size() )
+    {
+        throw std::out_of_range( "Error! Node is not in the dependency graph." );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+dependency_graph::node_id dependency_graph::add_node( const node & added )
+{
+    nodes_.push_back( added );
+    dependents_.emplace_back();
+    queued_.push_back( false );
+    const node_id id = nodes_.size() - 1;
+    if ( added.kind == node_kind::unary )
+    {
+        dependents_[ added.left ].push_back( id );
+    }
+    else if ( added.kind == node_kind::binary )
+    {
+        dependents_[ added.left ].push_back( id );
+        if ( added.right != added.left )
+        {
+            dependents_[ added.right ].push_back( id );
+        }
+    }
+    return id;
+}
+
+// ----------------------------------------------------------------------------
+
+dependency_graph::node_id dependency_graph::add_input( const significant_value & value )
+{
+    const calculated_value copy = helper::make_calculated( value.get_exact_value(),
+        value.get_digit_count(), value.get_most_sigdig_exponent() );
+    return add_node( node{ node_kind::input, operation::negate, 0, 0, 0.0L, copy } );
+}
+
+// ----------------------------------------------------------------------------
+
+dependency_graph::node_id dependency_graph::add_constant( const defined_value & value )
+{
+    return add_node( node{ node_kind::constant, operation::negate, 0, 0,
+        value.get_value(), calculated_value() } );
+}
+
+// ----------------------------------------------------------------------------
+
+dependency_graph::node_id dependency_graph::add_operation( operation op, node_id operand )
+{
+    validate_node( operand );
+    if ( op != operation::negate )
+    {
+        throw std::invalid_argument( "Error! Only negate needs exactly one operand." );
+    }
+    if ( nodes_[ operand ].kind == node_kind::constant )
+    {
+        return add_constant( defined_value( -nodes_[ operand ].constant ) );
+    }
+    node added{ node_kind::unary, op, operand, operand, 0.0L, calculated_value() };
+    if ( is_dirty() )
+    {
+        // The operand may be out of date, so wait for the next propagation.
+        const node_id id = add_node( added );
+        queued_[ id ] = true;
+        dirty_.push( id );
+        return id;
+    }
+    added.value = calculate( added );
+    return add_node( added );
+}
+
+// ----------------------------------------------------------------------------
+
+dependency_graph::node_id dependency_graph::add_operation( operation op,
+    node_id left, node_id right )
+{
+    validate_node( left );
+    validate_node( right );
+    if ( op == operation::negate )
+    {
+        throw std::invalid_argument( "Error! Negate only has one operand." );
+    }
+    const bool left_is_constant = ( nodes_[ left ].kind == node_kind::constant );
+    const bool right_is_constant = ( nodes_[ right ].kind == node_kind::constant );
+    if ( ( op == operation::divide ) && right_is_constant && ( nodes_[ right ].constant == 0.0L ) )
+    {
+        throw std::invalid_argument( "Division by zero error in dependency_graph::add_operation" );
+    }
+    if ( left_is_constant && right_is_constant )
+    {
+        const defined_value a( nodes_[ left ].constant );
+        const defined_value b( nodes_[ right ].constant );
+        switch ( op )
+        {
+            case operation::add :      return add_constant( a + b );
+            case operation::subtract : return add_constant( a - b );
+            case operation::multiply : return add_constant( a * b );
+            case operation::divide :   return add_constant( a / b );
+            default: break;
+        }
+    }
+    node added{ node_kind::binary, op, left, right, 0.0L, calculated_value() };
+    if ( is_dirty() )
+    {
+        const node_id id = add_node( added );
+        queued_[ id ] = true;
+        dirty_.push( id );
+        return id;
+    }
+    added.value = calculate( added );
+    return add_node( added );
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value dependency_graph::calculate( const node & current ) const
+{
+    const node & left = nodes_[ current.left ];
+    if ( current.kind == node_kind::unary )
+    {
+        assert( current.op == operation::negate );
+        return -left.value;
+    }
+    assert( current.kind == node_kind::binary );
+    const node & right = nodes_[ current.right ];
+    if ( left.kind == node_kind::constant )
+    {
+        const defined_value a( left.constant );
+        switch ( current.op )
+        {
+            case operation::add :      return a + right.value;
+            case operation::subtract : return a - right.value;
+            case operation::multiply : return a * right.value;
+            case operation::divide :   return a / right.value;
+            default: break;
+        }
+    }
+    else if ( right.kind == node_kind::constant )
+    {
+        const defined_value b( right.constant );
+        switch ( current.op )
+        {
+            case operation::add :      return left.value + b;
+            case operation::subtract : return left.value - b;
+            case operation::multiply : return left.value * b;
+            case operation::divide :   return left.value / b;
+            default: break;
+        }
+    }
+    else
+    {
+        switch ( current.op )
+        {
+            case operation::add :      return left.value + right.value;
+            case operation::subtract : return left.value - right.value;
+            case operation::multiply : return left.value * right.value;
+            case operation::divide :   return left.value / right.value;
+            default: break;
+        }
+    }
+    assert( false );
+    return calculated_value();
+}
+
+// ----------------------------------------------------------------------------
+
+void dependency_graph::mark_dependents( node_id node )
+{
+    for ( const node_id dependent : dependents_[ node ] )
+    {
+        if ( !queued_[ dependent ] )
+        {
+            queued_[ dependent ] = true;
+            dirty_.push( dependent );
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void dependency_graph::set_input( node_id input, const significant_value & value )
+{
+    stage_input( input, value );
+    propagate();
+}
+
+// ----------------------------------------------------------------------------
+
+void dependency_graph::stage_input( node_id input, const significant_value & value )
+{
+    validate_node( input );
+    node & changed = nodes_[ input ];
+    if ( changed.kind != node_kind::input )
+    {
+        throw std::invalid_argument( "Error! Only input nodes can be set." );
+    }
+    if ( are_identical( changed.value, value ) )
+    {
+        return;
+    }
+    changed.value = helper::make_calculated( value.get_exact_value(), value.get_digit_count(),
+        value.get_most_sigdig_exponent() );
+    mark_dependents( input );
+}
+
+// ----------------------------------------------------------------------------
+
+std::size_t dependency_graph::propagate()
+{
+    std::size_t count = 0;
+    while ( !dirty_.empty() )
+    {
+        const node_id id = dirty_.top();
+        // Calculate before popping, so a throw leaves this node dirty.
+        const calculated_value value = calculate( nodes_[ id ] );
+        dirty_.pop();
+        queued_[ id ] = false;
+        ++count;
+        if ( !are_identical( nodes_[ id ].value, value ) )
+        {
+            nodes_[ id ].value = value;
+            mark_dependents( id );
+        }
+    }
+    return count;
+}
+
+// ----------------------------------------------------------------------------
+
+bool dependency_graph::is_constant( node_id node ) const
+{
+    validate_node( node );
+    return ( nodes_[ node ].kind == node_kind::constant );
+}
+
+// ----------------------------------------------------------------------------
+
+bool dependency_graph::is_input( node_id node ) const
+{
+    validate_node( node );
+    return ( nodes_[ node ].kind == node_kind::input );
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value dependency_graph::get_value( node_id node ) const
+{
+    validate_node( node );
+    if ( nodes_[ node ].kind == node_kind::constant )
+    {
+        throw std::invalid_argument( "Error! A constant node has no significant digits." );
+    }
+    return nodes_[ node ].value;
+}
+
+// ----------------------------------------------------------------------------
+
+defined_value dependency_graph::get_constant( node_id node ) const
+{
+    validate_node( node );
+    if ( nodes_[ node ].kind != node_kind::constant )
+    {
+        throw std::invalid_argument( "Error! Node is not a constant." );
+    }
+    return defined_value( nodes_[ node ].constant );
+}
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
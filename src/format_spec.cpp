@@ -0,0 +1,148 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#include "format_spec.hpp"
+
+#include <array>
+#include <stdexcept>
+
+#include "significant_column.hpp"
+#include "defined_value.hpp"
+#include "helper.hpp"
+
+namespace sigdig {
+
+static_assert( format_spec::max_length == helper::max_formatted_length,
+    "format_spec and helper must agree on the longest formatted value." );
+
+// ----------------------------------------------------------------------------
+
+format_spec::format_spec( format_style formatting, rounding_style rounding, bool show_decimal ) :
+    formatting_( formatting ),
+    rounding_( rounding ),
+    show_decimal_( show_decimal ),
+    writer_( helper::get_writer( formatting, rounding ) )
+{
+    if ( formatting == format_style::hexadecimal_exponent )
+    {
+        throw std::invalid_argument( "Error! Hexadecimal format can not write significant digits." );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+std::string format_spec::format( long double value, int exponent, unsigned int digits ) const
+{
+    std::array< char, max_length > chars;
+    const std::size_t size = writer_( value, exponent, digits, show_decimal_, chars.data(), chars.size() );
+    return std::string( chars.data(), size );
+}
+
+// ----------------------------------------------------------------------------
+
+std::string format_spec::format( const significant_value & value ) const
+{
+    return format( value.get_exact_value(), value.get_most_sigdig_exponent(), value.get_digit_count() );
+}
+
+// ----------------------------------------------------------------------------
+
+std::string format_spec::format( const significant_value & value, unsigned int digits ) const
+{
+    helper::validate_digit_count( digits );
+    return format( value.get_exact_value(), value.get_most_sigdig_exponent(), digits );
+}
+
+// ----------------------------------------------------------------------------
+
+std::string format_spec::format( const defined_value & value ) const
+{
+    return format( value.get_value(), value.get_most_sigdig_exponent(),
+        utility::count_significant_digits( value.get_value() ) );
+}
+
+// ----------------------------------------------------------------------------
+
+std::string format_spec::format( const defined_value & value, unsigned int digits ) const
+{
+    helper::validate_digit_count( digits );
+    return format( value.get_value(), value.get_most_sigdig_exponent(), digits );
+}
+
+// ----------------------------------------------------------------------------
+
+void format_spec::format( const column_view & column, std::vector< std::string > & results ) const
+{
+    const std::size_t count = column.size();
+    const long double * values = column.get_values();
+    const unsigned int * digits = column.get_digit_counts();
+    const int * exponents = column.get_most_sigdig_exponents();
+    results.resize( count );
+    for ( std::size_t ii = 0; ii < count; ++ii )
+    {
+        results[ ii ] = format( values[ ii ], exponents[ ii ], digits[ ii ] );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void format_spec::format( const column_view & column,
+    std::pmr::vector< std::pmr::string > & results ) const
+{
+    const std::size_t count = column.size();
+    const long double * values = column.get_values();
+    const unsigned int * digits = column.get_digit_counts();
+    const int * exponents = column.get_most_sigdig_exponents();
+    std::array< char, max_length > chars;
+    results.resize( count );
+    for ( std::size_t ii = 0; ii < count; ++ii )
+    {
+        const std::size_t size = writer_( values[ ii ], exponents[ ii ], digits[ ii ], show_decimal_,
+            chars.data(), chars.size() );
+        // Assigning keeps the allocator of the string already in results.
+        results[ ii ].assign( chars.data(), size );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+std::size_t format_spec::write( const significant_value & value, char * target, std::size_t capacity ) const
+{
+    return writer_( value.get_exact_value(), value.get_most_sigdig_exponent(), value.get_digit_count(),
+        show_decimal_, target, capacity );
+}
+
+// ----------------------------------------------------------------------------
+
+std::size_t format_spec::write( const significant_value & value, unsigned int digits,
+    char * target, std::size_t capacity ) const
+{
+    helper::validate_digit_count( digits );
+    return writer_( value.get_exact_value(), value.get_most_sigdig_exponent(), digits,
+        show_decimal_, target, capacity );
+}
+
+// ----------------------------------------------------------------------------
+
+std::size_t format_spec::write( const defined_value & value, char * target, std::size_t capacity ) const
+{
+    return writer_( value.get_value(), value.get_most_sigdig_exponent(),
+        utility::count_significant_digits( value.get_value() ), show_decimal_, target, capacity );
+}
+
+// ----------------------------------------------------------------------------
+
+std::size_t format_spec::write( const defined_value & value, unsigned int digits,
+    char * target, std::size_t capacity ) const
+{
+    helper::validate_digit_count( digits );
+    return writer_( value.get_value(), value.get_most_sigdig_exponent(), digits,
+        show_decimal_, target, capacity );
+}
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
@@ -0,0 +1,643 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#include "formula.hpp"
+
+#include <cassert>
+#include <cctype>
+#include <cstdlib>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "helper.hpp"
+#include "lookup.hpp"
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+/// One node of the parsed expression. Children are indexes into the same vector.
+struct formula::node
+{
+    enum class kind : unsigned char
+    {
+        constant,
+        variable,
+        negate,
+        add,
+        subtract,
+        multiply,
+        divide
+    };
+
+    kind type;
+    long double value;
+    std::size_t variable;
+    std::size_t left;
+    std::size_t right;
+};
+
+// ----------------------------------------------------------------------------
+
+/** @class parser A recursive descent parser that builds the nodes for an
+ expression. It folds any operator whose operands are both numbers into a
+ single number as soon as it makes the node, so folding happens bottom up
+ without a separate pass.
+ */
+
+class formula::parser
+{
+public:
+
+    parser( const std::string & expression, std::vector< std::string > & names,
+        std::vector< node > & nodes ) :
+        text_( expression ), position_( 0 ), names_( names ), nodes_( nodes ) {}
+
+    std::size_t parse_all();
+
+private:
+
+    std::size_t parse_expression();
+    std::size_t parse_term();
+    std::size_t parse_unary();
+    std::size_t parse_primary();
+    std::size_t parse_number();
+    std::size_t parse_name();
+
+    std::size_t make_binary( node::kind type, std::size_t left, std::size_t right );
+    std::size_t make_constant( long double value );
+
+    void skip_spaces();
+    [[noreturn]] void fail( const char * problem ) const;
+
+    const std::string & text_;
+    std::size_t position_;
+    std::vector< std::string > & names_;
+    std::vector< node > & nodes_;
+
+};
+
+// ----------------------------------------------------------------------------
+
+void formula::parser::skip_spaces()
+{
+    while ( ( position_ < text_.size() ) &&
+        std::isspace( static_cast< unsigned char >( text_[ position_ ] ) ) )
+    {
+        ++position_;
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void formula::parser::fail( const char * problem ) const
+{
+    throw std::invalid_argument( std::string( "Error! " ) + problem +
+        " at position " + std::to_string( position_ ) + " of formula \"" + text_ + "\"." );
+}
+
+// ----------------------------------------------------------------------------
+
+std::size_t formula::parser::parse_all()
+{
+    const std::size_t root = parse_expression();
+    skip_spaces();
+    if ( position_ != text_.size() )
+    {
+        fail( "Unexpected character" );
+    }
+    if ( names_.empty() )
+    {
+        fail( "No column names" );
+    }
+    return root;
+}
+
+// ----------------------------------------------------------------------------
+
+std::size_t formula::parser::parse_expression()
+{
+    std::size_t left = parse_term();
+    for ( ;; )
+    {
+        skip_spaces();
+        if ( position_ >= text_.size() )
+        {
+            return left;
+        }
+        const char c = text_[ position_ ];
+        if ( ( c != '+' ) && ( c != '-' ) )
+        {
+            return left;
+        }
+        ++position_;
+        const std::size_t right = parse_term();
+        left = make_binary( ( c == '+' ) ? node::kind::add : node::kind::subtract, left, right );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+std::size_t formula::parser::parse_term()
+{
+    std::size_t left = parse_unary();
+    for ( ;; )
+    {
+        skip_spaces();
+        if ( position_ >= text_.size() )
+        {
+            return left;
+        }
+        const char c = text_[ position_ ];
+        if ( ( c != '*' ) && ( c != '/' ) )
+        {
+            return left;
+        }
+        ++position_;
+        const std::size_t right = parse_unary();
+        left = make_binary( ( c == '*' ) ? node::kind::multiply : node::kind::divide, left, right );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+std::size_t formula::parser::parse_unary()
+{
+    skip_spaces();
+    if ( position_ < text_.size() )
+    {
+        const char c = text_[ position_ ];
+        if ( c == '+' )
+        {
+            ++position_;
+            return parse_unary();
+        }
+        if ( c == '-' )
+        {
+            ++position_;
+            const std::size_t operand = parse_unary();
+            if ( nodes_[ operand ].type == node::kind::constant )
+            {
+                nodes_[ operand ].value = -nodes_[ operand ].value;
+                return operand;
+            }
+            nodes_.push_back( node{ node::kind::negate, 0.0L, 0, operand, 0 } );
+            return nodes_.size() - 1;
+        }
+    }
+    return parse_primary();
+}
+
+// ----------------------------------------------------------------------------
+
+std::size_t formula::parser::parse_primary()
+{
+    skip_spaces();
+    if ( position_ >= text_.size() )
+    {
+        fail( "Missing operand" );
+    }
+    const char c = text_[ position_ ];
+    if ( c == '(' )
+    {
+        ++position_;
+        const std::size_t inner = parse_expression();
+        skip_spaces();
+        if ( ( position_ >= text_.size() ) || ( text_[ position_ ] != ')' ) )
+        {
+            fail( "Missing closing parenthesis" );
+        }
+        ++position_;
+        return inner;
+    }
+    if ( std::isdigit( static_cast< unsigned char >( c ) ) || ( c == '.' ) )
+    {
+        return parse_number();
+    }
+    if ( std::isalpha( static_cast< unsigned char >( c ) ) || ( c == '_' ) )
+    {
+        return parse_name();
+    }
+    fail( "Unexpected character" );
+}
+
+// ----------------------------------------------------------------------------
+
+std::size_t formula::parser::parse_number()
+{
+    // Only accept decimal notation here, since strtold would also accept
+    // hexadecimal, inf, and nan.
+    const std::size_t first = position_;
+    std::size_t mantissa_digits = 0;
+    while ( ( position_ < text_.size() ) && std::isdigit( static_cast< unsigned char >( text_[ position_ ] ) ) )
+    {
+        ++position_;
+        ++mantissa_digits;
+    }
+    if ( ( position_ < text_.size() ) && ( text_[ position_ ] == '.' ) )
+    {
+        ++position_;
+        while ( ( position_ < text_.size() ) && std::isdigit( static_cast< unsigned char >( text_[ position_ ] ) ) )
+        {
+            ++position_;
+            ++mantissa_digits;
+        }
+    }
+    if ( mantissa_digits == 0 )
+    {
+        fail( "Number has no digits" );
+    }
+    if ( ( position_ < text_.size() ) && ( ( text_[ position_ ] == 'e' ) || ( text_[ position_ ] == 'E' ) ) )
+    {
+        ++position_;
+        if ( ( position_ < text_.size() ) && ( ( text_[ position_ ] == '+' ) || ( text_[ position_ ] == '-' ) ) )
+        {
+            ++position_;
+        }
+        if ( ( position_ >= text_.size() ) || !std::isdigit( static_cast< unsigned char >( text_[ position_ ] ) ) )
+        {
+            fail( "Exponent has no digits" );
+        }
+        while ( ( position_ < text_.size() ) && std::isdigit( static_cast< unsigned char >( text_[ position_ ] ) ) )
+        {
+            ++position_;
+        }
+    }
+    const std::string number( text_, first, position_ - first );
+    const long double value = std::strtold( number.c_str(), nullptr );
+    return make_constant( value );
+}
+
+// ----------------------------------------------------------------------------
+
+std::size_t formula::parser::parse_name()
+{
+    const std::size_t first = position_;
+    while ( ( position_ < text_.size() ) &&
+        ( std::isalnum( static_cast< unsigned char >( text_[ position_ ] ) ) || ( text_[ position_ ] == '_' ) ) )
+    {
+        ++position_;
+    }
+    const std::string name( text_, first, position_ - first );
+    const auto found = std::find( names_.begin(), names_.end(), name );
+    const std::size_t variable = static_cast< std::size_t >( found - names_.begin() );
+    if ( found == names_.end() )
+    {
+        names_.push_back( name );
+    }
+    nodes_.push_back( node{ node::kind::variable, 0.0L, variable, 0, 0 } );
+    return nodes_.size() - 1;
+}
+
+// ----------------------------------------------------------------------------
+
+std::size_t formula::parser::make_constant( long double value )
+{
+    try
+    {
+        helper::validate_input_value( value );
+    }
+    catch ( const std::invalid_argument & )
+    {
+        fail( "Number is out of range" );
+    }
+    nodes_.push_back( node{ node::kind::constant, value, 0, 0, 0 } );
+    return nodes_.size() - 1;
+}
+
+// ----------------------------------------------------------------------------
+
+std::size_t formula::parser::make_binary( node::kind type, std::size_t left, std::size_t right )
+{
+    const bool left_is_constant = ( nodes_[ left ].type == node::kind::constant );
+    const bool right_is_constant = ( nodes_[ right ].type == node::kind::constant );
+    if ( ( type == node::kind::divide ) && right_is_constant && ( nodes_[ right ].value == 0.0L ) )
+    {
+        fail( "Division by zero" );
+    }
+    if ( left_is_constant && right_is_constant )
+    {
+        // Both are defined values, so the result is exact too.
+        const long double a = nodes_[ left ].value;
+        const long double b = nodes_[ right ].value;
+        long double folded = 0.0L;
+        switch ( type )
+        {
+            case node::kind::add :      folded = a + b; break;
+            case node::kind::subtract : folded = a - b; break;
+            case node::kind::multiply : folded = a * b; break;
+            case node::kind::divide :   folded = a / b; break;
+            default: assert( false ); break;
+        }
+        // Reuse the left node, and leave the right one unreferenced.
+        try
+        {
+            nodes_[ left ].value = helper::validate_input_value( folded );
+        }
+        catch ( const std::invalid_argument & )
+        {
+            fail( "Numbers in formula overflow" );
+        }
+        return left;
+    }
+    nodes_.push_back( node{ type, 0.0L, 0, left, right } );
+    return nodes_.size() - 1;
+}
+
+// ----------------------------------------------------------------------------
+
+formula::formula( const std::string & expression ) :
+    instructions_(),
+    constants_(),
+    names_(),
+    register_count_( 0 )
+{
+    std::vector< node > nodes;
+    parser reader( expression, names_, nodes );
+    const std::size_t root = reader.parse_all();
+    const operand result = compile( nodes, root, 0 );
+    if ( result.kind != operand_kind::register_slot )
+    {
+        // The formula is just a name, so it still needs one instruction to produce a result.
+        assert( result.kind == operand_kind::column );
+        instructions_.push_back( instruction{ opcode::copy, result, operand{ operand_kind::none, 0 }, 0 } );
+        register_count_ = 1;
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+formula::operand formula::compile( const std::vector< node > & nodes,
+    std::size_t index, std::size_t first_free )
+{
+    // Registers are used like a stack: the left operand may take first_free,
+    // and the right operand starts after it. Each result goes into first_free,
+    // which is safe because every instruction reads row ii before writing it.
+    const node & current = nodes[ index ];
+    switch ( current.type )
+    {
+        case node::kind::constant :
+            constants_.push_back( current.value );
+            return operand{ operand_kind::constant, constants_.size() - 1 };
+        case node::kind::variable :
+            return operand{ operand_kind::column, current.variable };
+        case node::kind::negate :
+        {
+            const operand child = compile( nodes, current.left, first_free );
+            instructions_.push_back( instruction{ opcode::negate, child, operand{ operand_kind::none, 0 }, first_free } );
+            register_count_ = std::max( register_count_, first_free + 1 );
+            return operand{ operand_kind::register_slot, first_free };
+        }
+        default:
+            break;
+    }
+
+    const operand left = compile( nodes, current.left, first_free );
+    const std::size_t next_free = ( left.kind == operand_kind::register_slot ) ? first_free + 1 : first_free;
+    const operand right = compile( nodes, current.right, next_free );
+    opcode code = opcode::add;
+    switch ( current.type )
+    {
+        case node::kind::add :      code = opcode::add;      break;
+        case node::kind::subtract : code = opcode::subtract; break;
+        case node::kind::multiply : code = opcode::multiply; break;
+        case node::kind::divide :   code = opcode::divide;   break;
+        default: assert( false ); break;
+    }
+    instructions_.push_back( instruction{ code, left, right, first_free } );
+    register_count_ = std::max( register_count_, first_free + 1 );
+    return operand{ operand_kind::register_slot, first_free };
+}
+
+// ----------------------------------------------------------------------------
+
+std::size_t formula::find_variable( const std::string & name ) const
+{
+    const auto found = std::find( names_.begin(), names_.end(), name );
+    return static_cast< std::size_t >( found - names_.begin() );
+}
+
+// ----------------------------------------------------------------------------
+
+namespace {
+
+/// The rows of one operand within a block. A constant has no arrays.
+struct formula_source
+{
+    const long double * values;
+    const unsigned int * digits;
+    const int * exponents;
+    long double constant;
+};
+
+/// The rows an instruction writes within a block.
+struct formula_target
+{
+    long double * values;
+    unsigned int * digits;
+    int * exponents;
+};
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+
+static void run_formula_sum( const formula_source & left, const formula_source & right,
+    bool subtract, std::size_t count, const formula_target & target )
+{
+    if ( nullptr == right.values )
+    {
+        // A defined value keeps the least significant digit of the other operand.
+        const long double addend = subtract ? -right.constant : right.constant;
+        for ( std::size_t ii = 0; ii < count; ++ii )
+        {
+            const long double sum = left.values[ ii ] + addend;
+            const int least = left.exponents[ ii ] - static_cast< int >( left.digits[ ii ] ) + 1;
+            target.values[ ii ] = sum;
+            target.digits[ ii ] = helper::calculate_sum_digits( sum, least, target.exponents[ ii ] );
+        }
+    }
+    else if ( nullptr == left.values )
+    {
+        // A defined value on the left keeps the digit count of the other operand.
+        for ( std::size_t ii = 0; ii < count; ++ii )
+        {
+            const long double sum = subtract ? left.constant - right.values[ ii ] :
+                left.constant + right.values[ ii ];
+            target.values[ ii ] = sum;
+            target.digits[ ii ] = right.digits[ ii ];
+            target.exponents[ ii ] = lookup::calculate_exponent( sum );
+        }
+    }
+    else
+    {
+        for ( std::size_t ii = 0; ii < count; ++ii )
+        {
+            const int left_least = left.exponents[ ii ] - static_cast< int >( left.digits[ ii ] ) + 1;
+            const int right_least = right.exponents[ ii ] - static_cast< int >( right.digits[ ii ] ) + 1;
+            unsigned int digits = 0;
+            int exponent = 0;
+            target.values[ ii ] = helper::calculate_sum( left.values[ ii ], left_least,
+                right.values[ ii ], right_least, subtract, digits, exponent );
+            target.digits[ ii ] = digits;
+            target.exponents[ ii ] = exponent;
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+static void run_formula_product( const formula_source & left, const formula_source & right,
+    bool divide, std::size_t count, const formula_target & target )
+{
+    if ( divide && ( nullptr != right.values ) )
+    {
+        for ( std::size_t ii = 0; ii < count; ++ii )
+        {
+            if ( right.values[ ii ] == 0.0L )
+            {
+                throw std::invalid_argument( "Division by zero error in formula::evaluate" );
+            }
+        }
+    }
+    if ( nullptr == right.values )
+    {
+        // The parser already rejected division by a defined zero.
+        for ( std::size_t ii = 0; ii < count; ++ii )
+        {
+            const long double product = divide ? left.values[ ii ] / right.constant :
+                left.values[ ii ] * right.constant;
+            target.values[ ii ] = product;
+            target.digits[ ii ] = left.digits[ ii ];
+            target.exponents[ ii ] = lookup::calculate_exponent( product );
+        }
+    }
+    else if ( nullptr == left.values )
+    {
+        for ( std::size_t ii = 0; ii < count; ++ii )
+        {
+            const long double product = divide ? left.constant / right.values[ ii ] :
+                left.constant * right.values[ ii ];
+            target.values[ ii ] = product;
+            target.digits[ ii ] = right.digits[ ii ];
+            target.exponents[ ii ] = lookup::calculate_exponent( product );
+        }
+    }
+    else
+    {
+        for ( std::size_t ii = 0; ii < count; ++ii )
+        {
+            const long double product = divide ? left.values[ ii ] / right.values[ ii ] :
+                left.values[ ii ] * right.values[ ii ];
+            target.values[ ii ] = product;
+            target.digits[ ii ] = std::min( left.digits[ ii ], right.digits[ ii ] );
+            target.exponents[ ii ] = lookup::calculate_exponent( product );
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void formula::evaluate( const std::vector< column_view > & columns,
+    significant_column & result ) const
+{
+    if ( columns.size() != names_.size() )
+    {
+        throw std::invalid_argument(
+            "Error! Formula needs exactly one column for each name in it." );
+    }
+    const std::size_t count = columns.front().size();
+    for ( const column_view & column : columns )
+    {
+        if ( column.size() != count )
+        {
+            throw std::invalid_argument(
+                "Error! Columns used in a formula must have the same size." );
+        }
+    }
+    result.resize( count );
+
+    // The last instruction writes straight into the result, so it needs no register.
+    const std::size_t slots = register_count_ * block_size;
+    std::vector< long double > register_values( slots );
+    std::vector< unsigned int > register_digits( slots );
+    std::vector< int > register_exponents( slots );
+
+    for ( std::size_t first = 0; first < count; first += block_size )
+    {
+        const std::size_t rows = std::min( block_size, count - first );
+        const auto get_source = [&]( const operand & from ) -> formula_source
+        {
+            switch ( from.kind )
+            {
+                case operand_kind::column :
+                {
+                    const column_view & column = columns[ from.index ];
+                    return formula_source{ column.get_values() + first,
+                        column.get_digit_counts() + first,
+                        column.get_most_sigdig_exponents() + first, 0.0L };
+                }
+                case operand_kind::register_slot :
+                {
+                    const std::size_t offset = from.index * block_size;
+                    return formula_source{ register_values.data() + offset,
+                        register_digits.data() + offset,
+                        register_exponents.data() + offset, 0.0L };
+                }
+                case operand_kind::constant :
+                    return formula_source{ nullptr, nullptr, nullptr, constants_[ from.index ] };
+                default:
+                    break;
+            }
+            return formula_source{ nullptr, nullptr, nullptr, 0.0L };
+        };
+
+        const formula_target last{ result.get_values() + first,
+            result.get_digit_counts() + first, result.get_most_sigdig_exponents() + first };
+        for ( std::size_t ii = 0; ii < instructions_.size(); ++ii )
+        {
+            const instruction & step = instructions_[ ii ];
+            const std::size_t offset = step.target * block_size;
+            const formula_target target = ( ii + 1 == instructions_.size() ) ? last :
+                formula_target{ register_values.data() + offset,
+                    register_digits.data() + offset, register_exponents.data() + offset };
+            const formula_source left = get_source( step.left );
+            const formula_source right = get_source( step.right );
+            switch ( step.code )
+            {
+                case opcode::copy :
+                    if ( left.values != target.values )
+                    {
+                        std::copy_n( left.values, rows, target.values );
+                        std::copy_n( left.digits, rows, target.digits );
+                        std::copy_n( left.exponents, rows, target.exponents );
+                    }
+                    break;
+                case opcode::negate :
+                    for ( std::size_t jj = 0; jj < rows; ++jj )
+                    {
+                        target.values[ jj ] = -left.values[ jj ];
+                    }
+                    // Negating a register in place leaves its digits and exponents where they are.
+                    if ( left.digits != target.digits )
+                    {
+                        std::copy_n( left.digits, rows, target.digits );
+                        std::copy_n( left.exponents, rows, target.exponents );
+                    }
+                    break;
+                case opcode::add :      run_formula_sum( left, right, false, rows, target );     break;
+                case opcode::subtract : run_formula_sum( left, right, true, rows, target );      break;
+                case opcode::multiply : run_formula_product( left, right, false, rows, target ); break;
+                case opcode::divide :   run_formula_product( left, right, true, rows, target );  break;
+            }
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
@@ -10,10 +10,15 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
 
+#include <algorithm>
 #include <array>
 
+#include "calculated_value.hpp"
 #include "lookup.hpp"
+#include "counters.hpp"
 
 #ifdef DEBUG
     #include <iostream>
@@ -74,36 +79,39 @@ unsigned int calculate_digits_to_write( format_style format, int exponent,
 
 // ----------------------------------------------------------------------------
 
+template < format_style Formatting >
+char helper::get_format_type( unsigned int & digits )
+{
+    if constexpr ( Formatting == format_style::decimal_fixed )
+    {
+        return 'f';
+    }
+    else if constexpr ( Formatting == format_style::decimal_exponent )
+    {
+        return 'E';
+    }
+    else
+    {
+        static_assert( Formatting == format_style::hexadecimal_exponent, "Invalid formatting style." );
+        const long double hex_digits = ( digits * base_16_to_base_10_digit_ratio );
+        digits = static_cast< unsigned int >( hex_digits + 0.5L );
+        return 'A';
+    }
+}
+
+// ----------------------------------------------------------------------------
+
 char helper::get_format_type( format_style format, unsigned int & digits )
 {
-    char format_type = '\0';
     switch ( format )
     {
-        case decimal_fixed:
-        {
-            format_type = 'f';
-            break;
-        }
-        case decimal_exponent:
-        {
-            format_type = 'E';
-            break;
-        }
-        case hexadecimal_exponent:
-        {
-            format_type = 'A';
-            const long double hex_digits = ( digits * base_16_to_base_10_digit_ratio );
-            digits = static_cast< unsigned int >( hex_digits + 0.5L );
-            break;
-        }
-        default:
-        {
-            throw std::invalid_argument(
-                "Error. Invalid formatting style for converting number to string." );
-        }
+        case decimal_fixed        : return get_format_type< decimal_fixed >( digits );
+        case decimal_exponent     : return get_format_type< decimal_exponent >( digits );
+        case hexadecimal_exponent : return get_format_type< hexadecimal_exponent >( digits );
+        default: break;
     }
-
-    return format_type;
+    throw std::invalid_argument(
+        "Error. Invalid formatting style for converting number to string." );
 }
 
 // ----------------------------------------------------------------------------
@@ -126,52 +134,55 @@ long double calculate_ceiling( long double value, int place )
 
 // ----------------------------------------------------------------------------
 
-long double helper::calculate_rounding( long double value, int place,
-    rounding_style rounding )
+template < rounding_style Rounding >
+long double helper::calculate_rounding( long double value, int place )
 {
     if ( value == 0.0L )
     {
         return 0.0L;
     }
 
-    const bool is_negative = ( value < 0.0L );
+    if constexpr ( Rounding == rounding_style::truncate )
+    {
+        return 0.0L;
+    }
+    else if constexpr ( Rounding == rounding_style::floor )
+    {
+        return ( value < 0.0L ) ? -calculate_ceiling( value, place ) : 0.0L;
+    }
+    else if constexpr ( Rounding == rounding_style::round_half )
+    {
+        const long double rounding_value = lookup::lookup_tolerance( place );
+        return ( value < 0.0L ) ? -rounding_value : rounding_value;
+    }
+    else if constexpr ( Rounding == rounding_style::ceiling )
+    {
+        return ( value < 0.0L ) ? 0.0L : calculate_ceiling( value, place );
+    }
+    else
+    {
+        static_assert( Rounding == rounding_style::from_zero, "Invalid rounding style." );
+        const long double rounding_value = calculate_ceiling( value, place );
+        return ( value < 0.0L ) ? -rounding_value : rounding_value;
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+long double helper::calculate_rounding( long double value, int place,
+    rounding_style rounding )
+{
     switch ( rounding )
     {
-        case rounding_style::truncate:
-        {
-            return 0.0L;
-        }
-        case rounding_style::floor:
-        {
-            const long double rounding_value = ( is_negative ) ? -calculate_ceiling( value, place ) : 0.0L;
-            return rounding_value;
-        }
-        case rounding_style::round_half:
-        {
-            long double rounding_value = lookup::lookup_tolerance( place );
-            if ( is_negative )
-            {
-                rounding_value = -rounding_value;
-            }
-            return rounding_value;
-        }
-        case rounding_style::ceiling:
-        {
-            const long double rounding_value = ( is_negative ) ? 0.0L : calculate_ceiling( value, place );
-            return rounding_value;
-        }
-        case rounding_style::from_zero:
-        {
-            long double rounding_value = calculate_ceiling( value, place );
-            if ( is_negative )
-            {
-                rounding_value = -rounding_value;
-            }
-            return rounding_value;
-        }
+        case rounding_style::truncate   : return calculate_rounding< rounding_style::truncate   >( value, place );
+        case rounding_style::floor      : return calculate_rounding< rounding_style::floor      >( value, place );
+        case rounding_style::round_half : return calculate_rounding< rounding_style::round_half >( value, place );
+        case rounding_style::ceiling    : return calculate_rounding< rounding_style::ceiling    >( value, place );
+        case rounding_style::from_zero  : return calculate_rounding< rounding_style::from_zero  >( value, place );
         default: break;
     }
     assert( false );
+    return 0.0L;
 }
 
 // ----------------------------------------------------------------------------
@@ -187,6 +198,10 @@ void helper::validate_input_value( long double value, unsigned int digits )
 long double helper::validate_input_value( long double value )
 {
     const int number_type = std::fpclassify( value );
+    if ( ( number_type == FP_INFINITE ) || ( number_type == FP_NAN ) || ( number_type == FP_SUBNORMAL ) )
+    {
+        SIGDIG_COUNT( invalid_input_values );
+    }
     switch ( number_type )
     {
         case FP_INFINITE:  throw std::invalid_argument( "Value provided must not be infinite." );
@@ -205,12 +220,14 @@ long double helper::validate_input_value( const char * s )
 {
     if ( ( nullptr == s ) || ( '\0' == *s ) )
     {
+        SIGDIG_COUNT( invalid_input_values );
         throw std::invalid_argument( "String may not be null or empty." );
     }
     char * end = nullptr;
     const long double value = std::strtold( s, &end );
     if ( ( 0 == value ) && ( end == s ) )
     {
+        SIGDIG_COUNT( invalid_input_values );
         throw std::invalid_argument( "String is not parsable as a number." );
     }
     return value;
@@ -222,11 +239,13 @@ unsigned int helper::validate_digit_count( unsigned int digits )
 {
     if ( digits < 1 )
     {
+        SIGDIG_COUNT( invalid_digit_counts );
         throw std::invalid_argument(
             "Error. The number of significant digits cannot be zero." );
     }
         if ( digits > helper::max_range_of_digits_for_long_double )
     {
+        SIGDIG_COUNT( invalid_digit_counts );
         throw std::invalid_argument(
             "Long double does not support a precision more than 34 digits." );
     }
@@ -235,14 +254,121 @@ unsigned int helper::validate_digit_count( unsigned int digits )
 
 // ----------------------------------------------------------------------------
 
-void format_fixed_string( std::string & result, rounding_style rounding,
+unsigned int helper::cap_digit_count( unsigned int digits )
+{
+    return ( digits > max_range_of_digits_for_long_double ) ?
+        max_range_of_digits_for_long_double : digits;
+}
+
+// ----------------------------------------------------------------------------
+
+/** @class char_buffer Provides the few std::string operations the formatter
+ needs, but over an array of chars owned by the caller, so writing a value does
+ not allocate. Like std::string, erase and replace clamp counts that run past the
+ end.
+ */
+
+class char_buffer
+{
+public:
+
+    static const std::size_t npos = static_cast< std::size_t >( -1 );
+
+    char_buffer( char * chars, std::size_t size, std::size_t capacity ) :
+        chars_( chars ),
+        size_( size ),
+        capacity_( capacity )
+    {
+    }
+
+    char_buffer( const char_buffer & ) = delete;
+
+    char_buffer & operator = ( const char_buffer & ) = delete;
+
+    inline std::size_t size() const { return size_; }
+
+    inline char & operator [] ( std::size_t index ) { return chars_[ index ]; }
+
+    std::size_t find( char ch ) const
+    {
+        const void * place = std::memchr( chars_, ch, size_ );
+        return ( place == nullptr ) ? npos : static_cast< const char * >( place ) - chars_;
+    }
+
+    std::size_t find_first_not_of( char ch ) const
+    {
+        for ( std::size_t ii = 0; ii < size_; ++ii )
+        {
+            if ( chars_[ ii ] != ch )
+            {
+                return ii;
+            }
+        }
+        return npos;
+    }
+
+    void push_back( char ch )
+    {
+        append( 1, ch );
+    }
+
+    void append( std::size_t count, char ch )
+    {
+        resize( size_ + count );
+        std::memset( chars_ + size_ - count, ch, count );
+    }
+
+    void erase( std::size_t place, std::size_t count = npos )
+    {
+        assert( place <= size_ );
+        count = std::min( count, size_ - place );
+        std::memmove( chars_ + place, chars_ + place + count, size_ - place - count );
+        size_ -= count;
+    }
+
+    void replace( std::size_t place, std::size_t count, std::size_t fill_count, char ch )
+    {
+        assert( place <= size_ );
+        count = std::min( count, size_ - place );
+        const std::size_t tail = size_ - place - count;
+        resize( size_ - count + fill_count );
+        std::memmove( chars_ + place + fill_count, chars_ + place + count, tail );
+        std::memset( chars_ + place, ch, fill_count );
+    }
+
+#ifdef DEBUG
+    friend std::ostream & operator << ( std::ostream & stream, const char_buffer & buffer )
+    { return stream.write( buffer.chars_, buffer.size_ ); }
+#endif
+
+private:
+
+    void resize( std::size_t size )
+    {
+        if ( size >= capacity_ )
+        {
+            throw std::length_error( "Error! Buffer is too small for formatted number." );
+        }
+        size_ = size;
+    }
+
+    char * chars_;
+    std::size_t size_;
+    std::size_t capacity_;
+
+};
+
+// ----------------------------------------------------------------------------
+
+template < rounding_style Rounding >
+void format_fixed_string( char_buffer & result,
     unsigned int digits, unsigned int digits_to_write_on_left,
     unsigned int digits_to_write_on_right, bool show_decimal, bool is_negative,
     bool do_rounding, bool is_least_sigdig_in_tens_place )
 {
 
-    const std::string::size_type dot_place = result.find( '.' );
-    const bool has_decimal = ( dot_place != std::string::npos );
+    const std::size_t dot_place = result.find( '.' );
+    const bool has_decimal = ( dot_place != char_buffer::npos );
     const unsigned int digits_on_right =
         ( has_decimal ) ? result.size() - ( dot_place + 1 ) : 0;
     unsigned int digits_on_left = ( has_decimal ) ? dot_place : result.size();
@@ -262,9 +388,9 @@ void format_fixed_string( std::string & result, rounding_style rounding,
     {
         // There are spurious digits are to the left of the decimal place, so
         // replace the spurious digits with zeros.
-        std::string::size_type place = digits;
+        std::size_t place = digits;
         if ( is_negative ) ++place; // add 1 for the minus sign.
-        const std::string::size_type replace_count = digits_to_write_on_left - digits;
+        const std::size_t replace_count = digits_to_write_on_left - digits;
         if ( replace_count > 0 )
         {
             result.replace( place, replace_count, replace_count, '0' );
@@ -279,8 +405,7 @@ void format_fixed_string( std::string & result, rounding_style rounding,
         // The caller wants more digits than are currently in the string, so
         // add more to the right.
         const unsigned int zeros_to_add = digits_on_right - digits_to_write_on_right;
-        result.reserve( 1 + zeros_to_add );
-        if ( dot_place == std::string::npos )
+        if ( dot_place == char_buffer::npos )
         {
             result.push_back( '.' );
         }
@@ -289,8 +414,8 @@ void format_fixed_string( std::string & result, rounding_style rounding,
     if ( need_to_truncate )
     {
         // spurious digits are to the right of the decimal. Remove them.
-        assert( dot_place != std::string::npos );
-        std::string::size_type truncate_place = result.size() - ( digits_on_right - digits_to_write_on_right );
+        assert( dot_place != char_buffer::npos );
+        std::size_t truncate_place = result.size() - ( digits_on_right - digits_to_write_on_right );
         assert( 1 < truncate_place );
         assert( truncate_place < result.size() );
         assert( dot_place < truncate_place );
@@ -300,12 +425,12 @@ void format_fixed_string( std::string & result, rounding_style rounding,
             truncate_place = dot_place;
         }
         const bool adjust_for_ceiling = ( do_rounding && (
-            ( rounding == rounding_style::from_zero ) ||
-            ( ( rounding == rounding_style::ceiling ) && !is_negative ) ||
-            ( ( rounding == rounding_style::floor   ) &&  is_negative ) ) );
+            ( Rounding == rounding_style::from_zero ) ||
+            ( ( Rounding == rounding_style::ceiling ) && !is_negative ) ||
+            ( ( Rounding == rounding_style::floor   ) &&  is_negative ) ) );
         if ( adjust_for_ceiling )
         {
-            std::string::size_type zero_place = ( 0 < digits_to_write_on_right ) ?
+            std::size_t zero_place = ( 0 < digits_to_write_on_right ) ?
                 dot_place + digits_to_write_on_right + 1 :
                 dot_place + 1;
             if ( digits_to_write_on_left == 0 ) ++zero_place;
@@ -329,7 +454,7 @@ void format_fixed_string( std::string & result, rounding_style rounding,
 
 // result string should be in this format. "0.0E+00"
 
-void format_exponent_string( std::string & result, unsigned int digits,
+void format_exponent_string( char_buffer & result, unsigned int digits,
     bool show_decimal, bool is_negative )
 {
 #ifdef DEBUG
@@ -338,19 +463,19 @@ void format_exponent_string( std::string & result, unsigned int digits,
     if ( ' ' == result[ 0 ] )
     {
         // Remove any leading spaces from result string.
-        const std::string::size_type nonspace_spot =
+        const std::size_t nonspace_spot =
             result.find_first_not_of( ' ' );
         result.erase( 0, nonspace_spot );
 #ifdef DEBUG
         std::cout << __LINE__ << " \t string: [" << result << ']' << std::endl;
 #endif
     }
-    const std::string::size_type dot_place = result.find( '.' );
+    const std::size_t dot_place = result.find( '.' );
     const unsigned int dot_offset = ( is_negative ) ? 2 : 1;
     assert( dot_place == dot_offset );
-    const std::string::size_type exponent_place = result.find( 'E' );
-    assert( exponent_place != std::string::npos );
-    const std::string::size_type after_exponent = exponent_place + 2;
+    const std::size_t exponent_place = result.find( 'E' );
+    assert( exponent_place != char_buffer::npos );
+    const std::size_t after_exponent = exponent_place + 2;
     assert( after_exponent < result.size() );
     if ( result[ after_exponent ] == '0' )
     {
@@ -363,14 +488,14 @@ void format_exponent_string( std::string & result, unsigned int digits,
 #endif
     if ( ( digits == 1 ) && !show_decimal )
     {
-        const std::string::size_type digits_to_erase =
+        const std::size_t digits_to_erase =
             exponent_place - dot_offset;
         result.erase( dot_offset, digits_to_erase );
     }
     else
     {
         // make sure number of digits in result matches digits parameter.
-        const std::string::size_type digits_after_dot =
+        const std::size_t digits_after_dot =
             ( exponent_place - dot_place ) - 1;
 #ifdef DEBUG
         std::cout << __LINE__ << " \t string: [" << result << " \t digits_after_dot: [" << digits_after_dot << ']' << std::endl;
@@ -400,48 +525,61 @@ std::string helper::to_string( long double value, int exponent,
 
 // ----------------------------------------------------------------------------
 
-std::string helper::to_string( long double value, int exponent,
-    unsigned int digits, format_style formatting, rounding_style rounding,
-    bool show_decimal )
+template < format_style Formatting, rounding_style Rounding >
+std::size_t helper::write( long double value, int exponent,
+    unsigned int digits, bool show_decimal, char * target, std::size_t capacity )
 {
-
+    if constexpr ( Formatting == format_style::decimal_fixed )
+    {
+        SIGDIG_COUNT( decimal_fixed_strings );
+    }
+    else if constexpr ( Formatting == format_style::decimal_exponent )
+    {
+        SIGDIG_COUNT( decimal_exponent_strings );
+    }
+    else
+    {
+        SIGDIG_COUNT( hexadecimal_exponent_strings );
+    }
     const bool is_negative = ( value < 0.0 );
     const int exponent_below_least_sigdig =
         exponent - static_cast< int >( digits );
-    const long double rounding_value = helper::calculate_rounding(
-        value, exponent_below_least_sigdig, rounding );
+    const long double rounding_value = helper::calculate_rounding< Rounding >(
+        value, exponent_below_least_sigdig );
     const long double raw_value = value + rounding_value;
     unsigned int digits_to_write_on_left = 0;
     unsigned int digits_to_write_on_right = 0;
-    const char format_type = get_format_type( formatting, digits );
-    const unsigned int digits_to_write = calculate_digits_to_write( formatting,
+    get_format_type< Formatting >( digits );
+    const unsigned int digits_to_write = calculate_digits_to_write( Formatting,
         exponent, digits, digits_to_write_on_left, digits_to_write_on_right );
-    std::array< char, 32 > format;
-    // Format for more digits than requested to avoid rounding by snprintf.
-    std::snprintf( format.data(), format.size(), "%%%u.%uL%c",
-        digits_to_write + 1, digits_to_write_on_right + 1, format_type );
-    // Need this many chars because the most digits in fixed point format is
-    // 4932. Then add 4 more for the decimal point, leading zero, minus sign,
-    // and terminating NIL char.
-    std::array< char, helper::highest_exponent + 4 > chars;
-    const int bytes = std::snprintf( chars.data(), chars.size(),
-        format.data(), raw_value );
+    // The conversion is known at compile time, so only the width and precision
+    // are passed in. Format for more digits than requested to avoid rounding
+    // by snprintf.
+    const char * const format =
+        ( Formatting == format_style::decimal_fixed ) ? "%*.*Lf" :
+        ( Formatting == format_style::decimal_exponent ) ? "%*.*LE" : "%*.*LA";
+    const int bytes = std::snprintf( target, capacity, format,
+        static_cast< int >( digits_to_write + 1 ),
+        static_cast< int >( digits_to_write_on_right + 1 ), raw_value );
     assert( bytes > 0 );
-    std::string result( chars.data(), bytes );
-    assert( static_cast< unsigned int >( bytes ) == result.size() );
+    if ( static_cast< std::size_t >( bytes ) >= capacity )
+    {
+        throw std::length_error( "Error! Buffer is too small for formatted number." );
+    }
+    char_buffer result( target, bytes, capacity );
 
 #ifdef DEBUG
     std::cout << std::fixed;
-    std::cout << __LINE__ << " \t value : [" << value << "] \t raw value: [" << raw_value << "] \t rounding Value: [" << rounding_value << "] \t rounding style: [" << rounding << ']' << std::endl;
-    std::cout << __LINE__ << " \t string: [" << result << "] \t format: [" << format.data() << "] \t digits_to_write: [" << digits_to_write << "] \t bytes: [" << bytes << ']' << std::endl;
-    std::cout << __LINE__ << " \t digits: [" << digits << "] \t exponent: [" << exponent << "] \t exponent_below_least_sigdig: [" << exponent_below_least_sigdig << "] \t formatting: [" << formatting << ']' << std::endl;
+    std::cout << __LINE__ << " \t value : [" << value << "] \t raw value: [" << raw_value << "] \t rounding Value: [" << rounding_value << "] \t rounding style: [" << Rounding << ']' << std::endl;
+    std::cout << __LINE__ << " \t string: [" << result << "] \t format: [" << format << "] \t digits_to_write: [" << digits_to_write << "] \t bytes: [" << bytes << ']' << std::endl;
+    std::cout << __LINE__ << " \t digits: [" << digits << "] \t exponent: [" << exponent << "] \t exponent_below_least_sigdig: [" << exponent_below_least_sigdig << "] \t formatting: [" << Formatting << ']' << std::endl;
 #endif
-    if ( formatting == format_style::decimal_fixed )
+    if constexpr ( Formatting == format_style::decimal_fixed )
     {
         const bool do_rounding = ( rounding_value != 0.0L );
         const bool is_least_sigdig_in_tens_place =
             ( 0 == exponent_below_least_sigdig );
-        format_fixed_string( result, rounding, digits,
+        format_fixed_string< Rounding >( result, digits,
             digits_to_write_on_left, digits_to_write_on_right, show_decimal,
             is_negative, do_rounding, is_least_sigdig_in_tens_place );
     }
@@ -453,11 +591,438 @@ std::string helper::to_string( long double value, int exponent,
     std::cout << __LINE__ << " \t result: [" << result << ']' << std::endl;
 #endif
 
-    return result;
+    return result.size();
+}
+
+// ----------------------------------------------------------------------------
+
+template std::size_t helper::write< decimal_fixed, truncate >( long double, int, unsigned int, bool, char *, std::size_t );
+template std::size_t helper::write< decimal_fixed, floor >( long double, int, unsigned int, bool, char *, std::size_t );
+template std::size_t helper::write< decimal_fixed, round_half >( long double, int, unsigned int, bool, char *, std::size_t );
+template std::size_t helper::write< decimal_fixed, ceiling >( long double, int, unsigned int, bool, char *, std::size_t );
+template std::size_t helper::write< decimal_fixed, from_zero >( long double, int, unsigned int, bool, char *, std::size_t );
+template std::size_t helper::write< decimal_exponent, truncate >( long double, int, unsigned int, bool, char *, std::size_t );
+template std::size_t helper::write< decimal_exponent, floor >( long double, int, unsigned int, bool, char *, std::size_t );
+template std::size_t helper::write< decimal_exponent, round_half >( long double, int, unsigned int, bool, char *, std::size_t );
+template std::size_t helper::write< decimal_exponent, ceiling >( long double, int, unsigned int, bool, char *, std::size_t );
+template std::size_t helper::write< decimal_exponent, from_zero >( long double, int, unsigned int, bool, char *, std::size_t );
+template std::size_t helper::write< hexadecimal_exponent, truncate >( long double, int, unsigned int, bool, char *, std::size_t );
+template std::size_t helper::write< hexadecimal_exponent, floor >( long double, int, unsigned int, bool, char *, std::size_t );
+template std::size_t helper::write< hexadecimal_exponent, round_half >( long double, int, unsigned int, bool, char *, std::size_t );
+template std::size_t helper::write< hexadecimal_exponent, ceiling >( long double, int, unsigned int, bool, char *, std::size_t );
+template std::size_t helper::write< hexadecimal_exponent, from_zero >( long double, int, unsigned int, bool, char *, std::size_t );
+
+// ----------------------------------------------------------------------------
+
+template < format_style Formatting >
+helper::formatter get_formatter_for( rounding_style rounding )
+{
+    switch ( rounding )
+    {
+        case rounding_style::truncate   : return &helper::to_string< Formatting, rounding_style::truncate   >;
+        case rounding_style::floor      : return &helper::to_string< Formatting, rounding_style::floor      >;
+        case rounding_style::round_half : return &helper::to_string< Formatting, rounding_style::round_half >;
+        case rounding_style::ceiling    : return &helper::to_string< Formatting, rounding_style::ceiling    >;
+        case rounding_style::from_zero  : return &helper::to_string< Formatting, rounding_style::from_zero  >;
+        default: break;
+    }
+    throw std::invalid_argument(
+        "Error. Invalid rounding style for converting number to string." );
+}
+
+// ----------------------------------------------------------------------------
+
+helper::formatter helper::get_formatter( format_style formatting, rounding_style rounding )
+{
+    switch ( formatting )
+    {
+        case decimal_fixed        : return get_formatter_for< decimal_fixed >( rounding );
+        case decimal_exponent     : return get_formatter_for< decimal_exponent >( rounding );
+        case hexadecimal_exponent : return get_formatter_for< hexadecimal_exponent >( rounding );
+        default: break;
+    }
+    throw std::invalid_argument(
+        "Error. Invalid formatting style for converting number to string." );
+}
+
+// ----------------------------------------------------------------------------
+
+template < format_style Formatting >
+helper::writer get_writer_for( rounding_style rounding )
+{
+    switch ( rounding )
+    {
+        case rounding_style::truncate   : return &helper::write< Formatting, rounding_style::truncate   >;
+        case rounding_style::floor      : return &helper::write< Formatting, rounding_style::floor      >;
+        case rounding_style::round_half : return &helper::write< Formatting, rounding_style::round_half >;
+        case rounding_style::ceiling    : return &helper::write< Formatting, rounding_style::ceiling    >;
+        case rounding_style::from_zero  : return &helper::write< Formatting, rounding_style::from_zero  >;
+        default: break;
+    }
+    throw std::invalid_argument(
+        "Error. Invalid rounding style for converting number to string." );
+}
+
+// ----------------------------------------------------------------------------
+
+helper::writer helper::get_writer( format_style formatting, rounding_style rounding )
+{
+    switch ( formatting )
+    {
+        case decimal_fixed        : return get_writer_for< decimal_fixed >( rounding );
+        case decimal_exponent     : return get_writer_for< decimal_exponent >( rounding );
+        case hexadecimal_exponent : return get_writer_for< hexadecimal_exponent >( rounding );
+        default: break;
+    }
+    throw std::invalid_argument(
+        "Error. Invalid formatting style for converting number to string." );
+}
+
+// ----------------------------------------------------------------------------
+
+std::string helper::to_string( long double value, int exponent,
+    unsigned int digits, format_style formatting, rounding_style rounding,
+    bool show_decimal )
+{
+    return get_formatter( formatting, rounding )( value, exponent, digits, show_decimal );
+}
+
+// ----------------------------------------------------------------------------
+
+std::pmr::string helper::to_string( std::pmr::memory_resource * resource, long double value,
+    int exponent, unsigned int digits, format_style formatting, rounding_style rounding,
+    bool show_decimal )
+{
+    if ( nullptr == resource )
+    {
+        throw std::invalid_argument( "Error! Memory resource may not be null." );
+    }
+    std::array< char, max_formatted_length > chars;
+    const std::size_t size = get_writer( formatting, rounding )( value, exponent, digits, show_decimal,
+        chars.data(), chars.size() );
+    return std::pmr::string( chars.data(), size, resource );
+}
+
+// ----------------------------------------------------------------------------
+
+static long double round_to_digits_with_string( long double value, int exponent, unsigned int digits,
+    rounding_style rounding )
+{
+    const std::string result = helper::to_string( value, exponent, digits, format_style::decimal_fixed, rounding );
+    return std::strtold( result.c_str(), nullptr );
+}
+
+// ----------------------------------------------------------------------------
+
+long double helper::round_to_digits( long double value, int exponent, unsigned int digits,
+    rounding_style rounding )
+{
+    // to_string adds a rounding value, has snprintf round the sum one place
+    // past the last digit it keeps (or at the tenths place for whole numbers),
+    // and then truncates at the least significant digit. This does the same
+    // steps with a count of units of that rounding place.
+    static const long double largest_count = 9223372036854775807.0L;
+    const int least_sigdig_exponent = exponent - static_cast< int >( digits ) + 1;
+    const int rounding_place = std::min( least_sigdig_exponent, 0 ) - 1;
+    if ( value == 0.0L )
+    {
+        return value;
+    }
+    if ( rounding_place < -19 )
+    {
+        return round_to_digits_with_string( value, exponent, digits, rounding );
+    }
+    const long double raw_value = value + calculate_rounding(
+        value, exponent - static_cast< int >( digits ), rounding );
+    const long double rounding_power =
+        static_cast< long double >( get_integer_power_of_ten( static_cast< unsigned int >( -rounding_place ) ) );
+    const long double scaled = std::fabs( raw_value ) * rounding_power;
+    if ( !( scaled < largest_count ) )
+    {
+        return round_to_digits_with_string( value, exponent, digits, rounding );
+    }
+    const unsigned long long whole_units = static_cast< unsigned long long >( scaled );
+    const long double fraction = scaled - static_cast< long double >( whole_units );
+    // snprintf rounds the exact binary value, so a scaled value within a few
+    // bits of a tie could round either way. Those go through the string.
+    if ( std::fabs( fraction - 0.5L ) <= scaled * 4.0L * LDBL_EPSILON )
+    {
+        return round_to_digits_with_string( value, exponent, digits, rounding );
+    }
+    const unsigned long long rounded = whole_units + ( ( fraction > 0.5L ) ? 1ULL : 0ULL );
+    long double result = 0.0L;
+    if ( least_sigdig_exponent <= 0 )
+    {
+        // Digits right of the decimal are truncated from the end of the string.
+        const unsigned long long units = rounded / 10ULL;
+        const long double unit_power = static_cast< long double >(
+            get_integer_power_of_ten( static_cast< unsigned int >( -least_sigdig_exponent ) ) );
+        result = static_cast< long double >( units ) / unit_power;
+    }
+    else
+    {
+        // Digits left of the decimal are replaced with zeros by their position
+        // in the string, so only take this path when rounding did not carry
+        // into a new leading digit.
+        const unsigned long long whole = rounded / 10ULL;
+        if ( static_cast< int >( count_decimal_digits( whole ) ) != exponent + 1 )
+        {
+            return round_to_digits_with_string( value, exponent, digits, rounding );
+        }
+        // The whole number fits in 64 bits, so its least significant place is below 10^19.
+        const unsigned long long unit =
+            get_integer_power_of_ten( static_cast< unsigned int >( least_sigdig_exponent ) );
+        result = static_cast< long double >( whole / unit ) * static_cast< long double >( unit );
+    }
+    return std::copysign( result, raw_value );
+}
+
+// ----------------------------------------------------------------------------
+
+unsigned int helper::calculate_sum_digits( long double sum,
+    int least_sigdig_exponent, int & exponent )
+{
+    // A sum of zero has no exponent of its own, so it is handled like any
+    // other sum smaller than the least significant digit of its operands.
+    exponent = ( sum == 0.0L ) ? least_sigdig_exponent - 1 : lookup::calculate_exponent( sum );
+    const int digits = exponent - least_sigdig_exponent + 1;
+    if ( digits < 1 )
+    {
+        // The sum is smaller than the least significant digit of its operands,
+        // so nothing but that last place is known.
+        exponent = least_sigdig_exponent;
+        return 1;
+    }
+    return static_cast< unsigned int >( digits );
+}
+
+// ----------------------------------------------------------------------------
+
+/// Scales value to a count of units if it is a whole number of them, and returns false if not.
+static bool scale_to_units( long double value, long double unit_power, bool units_are_small, long long & units )
+{
+    // A long double holds 64 bits of significand, so counts below 2^53 leave
+    // enough bits to tell a whole number of units from a near miss.
+    static const long double largest_count = 9007199254740992.0L;
+    const long double scaled = ( units_are_small ) ? value * unit_power : value / unit_power;
+    if ( !( std::fabs( scaled ) < largest_count ) )
+    {
+        return false;
+    }
+    const long double rounded = std::nearbyint( scaled );
+    const long double tolerance = 64.0L * LDBL_EPSILON * std::max( std::fabs( scaled ), 1.0L );
+    if ( std::fabs( scaled - rounded ) > tolerance )
+    {
+        return false;
+    }
+    units = static_cast< long long >( rounded );
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+
+bool helper::add_scaled_integers( long double augend, long double addend, bool subtract,
+    int least_sigdig_exponent, long double & sum, unsigned int & digits, int & exponent )
+{
+    // Only powers of ten which fit in 64 bits are exact in a long double.
+    if ( ( least_sigdig_exponent < -19 ) || ( 19 < least_sigdig_exponent ) )
+    {
+        return false;
+    }
+    const bool units_are_small = ( least_sigdig_exponent < 0 );
+    const long double unit_power = static_cast< long double >( get_integer_power_of_ten(
+        static_cast< unsigned int >( units_are_small ? -least_sigdig_exponent : least_sigdig_exponent ) ) );
+    long long augend_units = 0;
+    long long addend_units = 0;
+    if ( !scale_to_units( augend, unit_power, units_are_small, augend_units )
+      || !scale_to_units( addend, unit_power, units_are_small, addend_units ) )
+    {
+        return false;
+    }
+
+    const long long units = ( subtract ) ? augend_units - addend_units : augend_units + addend_units;
+    const unsigned long long magnitude = ( units < 0 ) ?
+        0ULL - static_cast< unsigned long long >( units ) : static_cast< unsigned long long >( units );
+    // A count of zero units still knows the last place, so it has 1 digit there.
+    digits = count_decimal_digits( magnitude );
+    exponent = least_sigdig_exponent + static_cast< int >( digits ) - 1;
+    const long double count = static_cast< long double >( units );
+    sum = ( units_are_small ) ? count / unit_power : count * unit_power;
+    return true;
 }
 
 // ----------------------------------------------------------------------------
 
+long double helper::calculate_sum( long double augend, int augend_least_sigdig, long double addend,
+    int addend_least_sigdig, bool subtract, unsigned int & digits, int & exponent )
+{
+    long double sum = 0.0L;
+    if ( ( augend_least_sigdig == addend_least_sigdig ) && add_scaled_integers(
+        augend, addend, subtract, augend_least_sigdig, sum, digits, exponent ) )
+    {
+        return sum;
+    }
+    sum = ( subtract ) ? augend - addend : augend + addend;
+    digits = calculate_sum_digits( sum, std::max( augend_least_sigdig, addend_least_sigdig ), exponent );
+    return sum;
+}
+
+// ----------------------------------------------------------------------------
+
+int helper::calculate_product_exponent( long double product, int exponent_sum )
+{
+    if ( product == 0.0L )
+    {
+        return 0;
+    }
+    // The table only covers lowest_exponent to highest_exponent, and exponent_sum + 2 is looked up below.
+    if ( ( exponent_sum < lowest_exponent ) || ( exponent_sum + 2 > highest_exponent ) )
+    {
+        return lookup::calculate_exponent( product );
+    }
+    const long double magnitude = std::fabs( product );
+    if ( lookup::lookup_ceiling_offset( exponent_sum + 1 ) <= magnitude )
+    {
+        // The exponent table is only searched if the factors' exponents did not match their values.
+        return ( magnitude < lookup::lookup_ceiling_offset( exponent_sum + 2 ) ) ?
+            exponent_sum + 1 : lookup::calculate_exponent( product );
+    }
+    if ( lookup::lookup_ceiling_offset( exponent_sum ) <= magnitude )
+    {
+        return exponent_sum;
+    }
+    return lookup::calculate_exponent( product );
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value helper::make_calculated( long double value, unsigned int digits, int most_sigdig_exponent )
+{
+    return calculated_value( value, digits, most_sigdig_exponent,
+        most_sigdig_exponent - static_cast< int >( digits ) + 1 );
+}
+
+// ----------------------------------------------------------------------------
+
+static const unsigned long long integer_powers_of_ten[] =
+{
+    1ULL,
+    10ULL,
+    100ULL,
+    1000ULL,
+    10000ULL,
+    100000ULL,
+    1000000ULL,
+    10000000ULL,
+    100000000ULL,
+    1000000000ULL,
+    10000000000ULL,
+    100000000000ULL,
+    1000000000000ULL,
+    10000000000000ULL,
+    100000000000000ULL,
+    1000000000000000ULL,
+    10000000000000000ULL,
+    100000000000000000ULL,
+    1000000000000000000ULL,
+    10000000000000000000ULL
+};
+
+// ----------------------------------------------------------------------------
+
+unsigned long long helper::get_integer_power_of_ten( unsigned int exponent )
+{
+    assert( exponent < sizeof( integer_powers_of_ten ) / sizeof( integer_powers_of_ten[ 0 ] ) );
+    return integer_powers_of_ten[ exponent ];
+}
+
+// ----------------------------------------------------------------------------
+
+unsigned int helper::count_decimal_digits( unsigned long long value )
+{
+    if ( value == 0 )
+    {
+        return 1;
+    }
+    // The number of bits times log10( 2 ), which is about 1233 / 4096, is
+    // either the number of decimal digits or one more than it.
+    const unsigned int bits = 64 - __builtin_clzll( value );
+    const unsigned int guess = ( bits * 1233 ) >> 12;
+    return guess + ( ( value < integer_powers_of_ten[ guess ] ) ? 0 : 1 );
+}
+
+// ----------------------------------------------------------------------------
+
+unsigned int helper::count_trailing_decimal_zeros( unsigned long long value )
+{
+    if ( value == 0 )
+    {
+        return 0;
+    }
+    unsigned int zeros = 0;
+    while ( value % 100000000ULL == 0 )
+    {
+        value /= 100000000ULL;
+        zeros += 8;
+    }
+    if ( value % 10000ULL == 0 )
+    {
+        value /= 10000ULL;
+        zeros += 4;
+    }
+    if ( value % 100ULL == 0 )
+    {
+        value /= 100ULL;
+        zeros += 2;
+    }
+    if ( value % 10ULL == 0 )
+    {
+        zeros += 1;
+    }
+    return zeros;
+}
+
+// ----------------------------------------------------------------------------
+
+#ifdef __SIZEOF_INT128__
+
+unsigned int helper::count_decimal_digits( unsigned __int128 value )
+{
+    const unsigned long long high = static_cast< unsigned long long >( value >> 64 );
+    if ( high == 0 )
+    {
+        return count_decimal_digits( static_cast< unsigned long long >( value ) );
+    }
+    // Values this large have at least 20 digits, so count the digits after
+    // the first 19 and add them.
+    const unsigned long long nineteen_digits = integer_powers_of_ten[ 19 ];
+    const unsigned __int128 upper = value / nineteen_digits;
+    return 19 + count_decimal_digits( upper );
+}
+
+// ----------------------------------------------------------------------------
+
+unsigned int helper::count_trailing_decimal_zeros( unsigned __int128 value )
+{
+    if ( value == 0 )
+    {
+        return 0;
+    }
+    const unsigned long long nineteen_digits = integer_powers_of_ten[ 19 ];
+    unsigned int zeros = 0;
+    while ( value % nineteen_digits == 0 )
+    {
+        value /= nineteen_digits;
+        zeros += 19;
+    }
+    return zeros + count_trailing_decimal_zeros(
+        static_cast< unsigned long long >( value % nineteen_digits ) );
+}
+
+#endif
+
+// ----------------------------------------------------------------------------
+
 bool helper::are_nearly_equal( long double v1, long double v2, long double tolerance )
 {
     const long double diff = std::fabs( v1 - v2 );
@@ -490,6 +1055,24 @@ bool helper::are_nearly_equal( long double v1, long double v2, long double toler
 
 // ----------------------------------------------------------------------------
 
+int helper::count_lost_bits( long double argument, long double result )
+{
+    assert( std::isfinite( argument ) );
+    assert( std::isnormal( result ) );
+    if ( argument == 0.0L )
+    {
+        return 0;
+    }
+    const int argument_exponent = std::ilogb( argument );
+    const int result_exponent = std::ilogb( result );
+    const int lost = std::max( argument_exponent, 0 )
+        + std::max( argument_exponent - result_exponent, 0 )
+        + std::max( result_exponent, 0 );
+    return lost;
+}
+
+// ----------------------------------------------------------------------------
+
 bool helper::are_nearly_equal( long double v1, long double v2 )
 {
     const long double v1_tolerance = v1 * 10.0L * LDBL_EPSILON;
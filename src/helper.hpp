@@ -9,14 +9,21 @@
 
 #pragma once
 
+#include <array>
+#include <limits>
+#include <memory_resource>
 #include <string>
 
 #include <cfloat>
+#include <cmath>
+#include <cstddef>
 
 #include "utility.hpp"
 
 namespace sigdig {
 
+class calculated_value;
+
 // This is meant to be an internal header file.
 // It is not meant to be included by source files outside of SigDig.
 
@@ -41,6 +48,9 @@ public:
 
     static unsigned int validate_digit_count( unsigned int digits );
 
+    /// Returns digits, or the most digits a long double can hold if digits is more than that.
+    static unsigned int cap_digit_count( unsigned int digits );
+
     static long double validate_input_value( long double value );
 
     static void validate_input_value( long double value, unsigned int digits );
@@ -54,10 +64,145 @@ public:
         format_style format = format_style::decimal_fixed, rounding_style rounding = rounding_style::round_half,
         bool show_decimal = false );
 
+    /** Writes the value on the stack and copies it into a string that allocates from resource, so the
+     string is the only allocation. This throws std::invalid_argument if resource is null.
+     */
+    static std::pmr::string to_string( std::pmr::memory_resource * resource, long double value, int exponent,
+        unsigned int digits, format_style format, rounding_style rounding, bool show_decimal );
+
+    /// The most chars any value can need, which is for the largest long double in fixed point format.
+    static const std::size_t max_formatted_length = highest_exponent + 8;
+
+    /** These templates are the formatter with the format and rounding styles fixed at compile time. They
+     write the value into target, which has room for capacity chars, and return how many chars were
+     written. They are explicitly instantiated in helper.cpp for every combination of styles.
+     */
+    template < format_style Formatting, rounding_style Rounding >
+    static std::size_t write( long double value, int exponent, unsigned int digits, bool show_decimal,
+        char * target, std::size_t capacity );
+
+    template < format_style Formatting, rounding_style Rounding >
+    static std::string to_string( long double value, int exponent, unsigned int digits, bool show_decimal )
+    {
+        std::array< char, max_formatted_length > chars;
+        const std::size_t size = write< Formatting, Rounding >( value, exponent, digits, show_decimal,
+            chars.data(), chars.size() );
+        return std::string( chars.data(), size );
+    }
+
+    /// Points to one of the write instantiations.
+    typedef std::size_t ( * writer )( long double value, int exponent, unsigned int digits, bool show_decimal,
+        char * target, std::size_t capacity );
+
+    /// Returns the write instantiation for these styles. This throws if either style is invalid.
+    static writer get_writer( format_style formatting, rounding_style rounding );
+
+    /// Points to one of the to_string instantiations.
+    typedef std::string ( * formatter )( long double value, int exponent, unsigned int digits, bool show_decimal );
+
+    /// Returns the to_string instantiation for these styles. This throws if either style is invalid.
+    static formatter get_formatter( format_style formatting, rounding_style rounding );
+
+    template < rounding_style Rounding >
+    static long double calculate_rounding( long double value, int place );
+
     static long double calculate_rounding( long double value, int place, rounding_style rounding );
 
+    /** Rounds value to the requested digits by the same steps as writing it with to_string in
+     decimal_fixed format and reading it back with strtold, but using integer arithmetic instead of
+     strings. The few values too large, too small, or too close to a tie to round exactly that way
+     still go through the strings, so the result is always identical.
+     */
+    static long double round_to_digits( long double value, int exponent, unsigned int digits,
+        rounding_style rounding );
+
+    template < format_style Formatting >
+    static char get_format_type( unsigned int & digits );
+
     static char get_format_type( format_style format, unsigned int & digits );
 
+    /** Calculates the exponent and number of significant digits for the result of an addition or subtraction
+     whose least significant digit is at least_sigdig_exponent. These are the same rules used by
+     significant_value::operator +. If the result lost every significant digit, this reports 1 digit at the
+     least significant place.
+     */
+    static unsigned int calculate_sum_digits( long double sum, int least_sigdig_exponent, int & exponent );
+
+    /** Adds or subtracts two values whose least significant digits are both at least_sigdig_exponent by
+     counting whole units of 10 ^ least_sigdig_exponent in 64-bit integers. That sum is exact, and its
+     exponent comes from the number of digits in the count instead of a search. This returns false, and
+     changes nothing, if either value is not a whole number of those units, so the caller can fall back to
+     long double arithmetic. The digits follow the same rules as calculate_sum_digits.
+     */
+    static bool add_scaled_integers( long double augend, long double addend, bool subtract,
+        int least_sigdig_exponent, long double & sum, unsigned int & digits, int & exponent );
+
+    /** Adds or subtracts two values the way significant_value::operator + and operator - do, and
+     calculates the digits and exponent of the result. This uses add_scaled_integers when both least
+     significant digits are in the same place, and calculate_sum_digits otherwise.
+     */
+    static long double calculate_sum( long double augend, int augend_least_sigdig, long double addend,
+        int addend_least_sigdig, bool subtract, unsigned int & digits, int & exponent );
+
+    /** Calculates the exponent of a product whose factors have exponents adding up to exponent_sum. The result
+     is either exponent_sum or one more, which is quicker to check than searching the exponent table.
+     */
+    static int calculate_product_exponent( long double product, int exponent_sum );
+
+    /** Makes a calculated_value whose digits and most significant exponent are already known, without
+     counting them again. This is the one way code outside calculated_value reaches its private constructor.
+     */
+    static calculated_value make_calculated( long double value, unsigned int digits, int most_sigdig_exponent );
+
+    /// Returns 10 raised to exponent. The exponent must be from 0 through 19.
+    static unsigned long long get_integer_power_of_ten( unsigned int exponent );
+
+    /// Returns how many decimal digits are needed to write value. This returns 1 for zero.
+    static unsigned int count_decimal_digits( unsigned long long value );
+
+    /// Returns how many zeros are at the end of value when written in decimal. This returns 0 for zero.
+    static unsigned int count_trailing_decimal_zeros( unsigned long long value );
+
+#ifdef __SIZEOF_INT128__
+    static unsigned int count_decimal_digits( unsigned __int128 value );
+
+    static unsigned int count_trailing_decimal_zeros( unsigned __int128 value );
+#endif
+
+    /// Extra digits beyond the requested ones that calculate_at_precision keeps correct.
+    static const unsigned int guard_digits = 3;
+
+    /** Returns how many bits of a result's significand can be wrong when function was evaluated at
+     argument. This estimates the log base 2 of the condition number from the exponents alone: large
+     arguments lose bits to range reduction, results much smaller than their argument lose bits near a
+     root, and large results lose bits near a pole. It is never too low for functions whose condition
+     number is at most about |argument| + |argument / result| + |result|.
+     */
+    static int count_lost_bits( long double argument, long double result );
+
+    /** Evaluates function in double instead of long double when that still leaves digits plus guard_digits
+     correct, since the double versions of sine and cosine are a few times faster. A result that came out
+     zero, subnormal, infinite, or with too many lost bits is evaluated again as a long double. Function
+     must accept double and long double, and must meet the condition number limit of count_lost_bits, as
+     sine, cosine, and tangent do. Functions like arc_sine, whose condition number is unbounded near the
+     ends of their domains, should not use this.
+     */
+    template < typename Function >
+    static long double calculate_at_precision( long double value, unsigned int digits, Function function )
+    {
+        const int needed_bits = static_cast< int >( ( digits + guard_digits ) * 10 + 2 ) / 3;
+        if ( needed_bits < std::numeric_limits< double >::digits )
+        {
+            const double result = function( static_cast< double >( value ) );
+            if ( std::isnormal( result ) &&
+               ( count_lost_bits( value, result ) <= std::numeric_limits< double >::digits - needed_bits ) )
+            {
+                return result;
+            }
+        }
+        return function( value );
+    }
+
     static bool are_nearly_equal( long double v1, long double v2 );
 
     static bool are_nearly_equal( long double v1, long double v2, long double tolerance );
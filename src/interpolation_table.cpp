@@ -0,0 +1,176 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#include "interpolation_table.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "helper.hpp"
+#include "lookup.hpp"
+
+namespace sigdig {
+
+/// A column lookup walks forward at most this many breakpoints before searching.
+static const std::size_t max_forward_steps = 8;
+
+// ----------------------------------------------------------------------------
+
+/// Subtracts two values using the addition and subtraction digit rules.
+static inline long double subtract_values( const column_view & column,
+    std::size_t minuend, std::size_t subtrahend, unsigned int & digits )
+{
+    int exponent = 0;
+    return helper::calculate_sum( column.get_exact_value( minuend ), column.get_least_sigdig_exponent( minuend ),
+        column.get_exact_value( subtrahend ), column.get_least_sigdig_exponent( subtrahend ),
+        true, digits, exponent );
+}
+
+// ----------------------------------------------------------------------------
+
+interpolation_table::interpolation_table( const column_view & x,
+    const column_view & y ) :
+    x_( x ),
+    y_( y ),
+    rise_(),
+    rise_digits_(),
+    run_(),
+    run_digits_()
+{
+    if ( x.size() != y.size() )
+    {
+        throw std::invalid_argument( "Error! Interpolation table needs as many y values as x values." );
+    }
+    if ( x.size() < 2 )
+    {
+        throw std::invalid_argument( "Error! Interpolation table needs at least 2 breakpoints." );
+    }
+    const std::size_t segments = x.size() - 1;
+    rise_.resize( segments );
+    rise_digits_.resize( segments );
+    run_.resize( segments );
+    run_digits_.resize( segments );
+    for ( std::size_t ii = 0; ii < segments; ++ii )
+    {
+        if ( !( x.get_exact_value( ii ) < x.get_exact_value( ii + 1 ) ) )
+        {
+            throw std::invalid_argument( "Error! Interpolation table x values must be strictly increasing." );
+        }
+        rise_[ ii ] = subtract_values( y, ii + 1, ii, rise_digits_[ ii ] );
+        run_[ ii ] = subtract_values( x, ii + 1, ii, run_digits_[ ii ] );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+std::size_t interpolation_table::find_segment( long double value ) const
+{
+    // This binary search has no branches inside the loop, only a conditional
+    // move, so it does not suffer from mispredicted branches.
+    const long double * breakpoints = x_.view().get_values();
+    std::size_t base = 0;
+    std::size_t length = x_.size();
+    while ( length > 1 )
+    {
+        const std::size_t half = length / 2;
+        base = ( breakpoints[ base + half ] <= value ) ? base + half : base;
+        length -= half;
+    }
+    return std::min( base, x_.size() - 2 );
+}
+
+// ----------------------------------------------------------------------------
+
+void interpolation_table::interpolate( std::size_t segment, long double x,
+    unsigned int x_digits, int x_exponent, long double & value,
+    unsigned int & digits, int & exponent ) const
+{
+    const column_view points = x_.view();
+    const column_view levels = y_.view();
+    if ( ( x < points.get_exact_value( 0 ) ) || ( points.get_exact_value( points.size() - 1 ) < x ) )
+    {
+        throw std::domain_error( "Error! Value is outside the range of the interpolation table." );
+    }
+
+    // Digits of x - x0 come from the highest least significant digit.
+    unsigned int offset_digits = 0;
+    int offset_exponent = 0;
+    const long double offset = helper::calculate_sum( x, x_exponent - static_cast< int >( x_digits ) + 1,
+        points.get_exact_value( segment ), points.get_least_sigdig_exponent( segment ),
+        true, offset_digits, offset_exponent );
+
+    // Products and quotients keep the fewest digits.
+    const long double scaled = offset * rise_[ segment ] / run_[ segment ];
+    if ( scaled == 0.0L )
+    {
+        // At a breakpoint or on a flat segment, adding a zero term must not raise y0's least significant digit.
+        value = levels.get_exact_value( segment );
+        digits = levels.get_digit_count( segment );
+        exponent = levels.get_most_sigdig_exponent( segment );
+        return;
+    }
+    const unsigned int scaled_digits = std::min( offset_digits,
+        std::min( rise_digits_[ segment ], run_digits_[ segment ] ) );
+    const int scaled_exponent = lookup::calculate_exponent( scaled );
+
+    value = helper::calculate_sum( levels.get_exact_value( segment ), levels.get_least_sigdig_exponent( segment ),
+        scaled, scaled_exponent - static_cast< int >( scaled_digits ) + 1, false, digits, exponent );
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value interpolation_table::interpolate( const significant_value & x ) const
+{
+    long double value = 0.0L;
+    unsigned int digits = 0;
+    int exponent = 0;
+    interpolate( find_segment( x.get_exact_value() ), x.get_exact_value(),
+        x.get_digit_count(), x.get_most_sigdig_exponent(), value, digits, exponent );
+    return helper::make_calculated( value, digits, exponent );
+}
+
+// ----------------------------------------------------------------------------
+
+void interpolation_table::interpolate( const column_view & x,
+    significant_column & result ) const
+{
+    const long double * breakpoints = x_.view().get_values();
+    const std::size_t last_segment = x_.size() - 2;
+    const std::size_t count = x.size();
+    result.resize( count );
+    long double * values = result.get_values();
+    unsigned int * digits = result.get_digit_counts();
+    int * exponents = result.get_most_sigdig_exponents();
+    std::size_t segment = 0;
+    for ( std::size_t ii = 0; ii < count; ++ii )
+    {
+        const long double value = x.get_exact_value( ii );
+        if ( value < breakpoints[ segment ] )
+        {
+            segment = find_segment( value );
+        }
+        else
+        {
+            std::size_t steps = 0;
+            while ( ( segment < last_segment ) && ( breakpoints[ segment + 1 ] <= value )
+                 && ( steps < max_forward_steps ) )
+            {
+                ++segment;
+                ++steps;
+            }
+            if ( ( segment < last_segment ) && ( breakpoints[ segment + 1 ] <= value ) )
+            {
+                segment = find_segment( value );
+            }
+        }
+        interpolate( segment, value, x.get_digit_count( ii ), x.get_most_sigdig_exponent( ii ),
+            values[ ii ], digits[ ii ], exponents[ ii ] );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
@@ -0,0 +1,185 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#include "linear_algebra.hpp"
+
+#include <climits>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "helper.hpp"
+
+namespace sigdig {
+
+/// Number of rows, columns, or inner terms in each tile of gemm.
+static const std::size_t tile_size = 64;
+
+// ----------------------------------------------------------------------------
+
+/// Adds one product to a running sum, and keeps the highest least significant digit.
+static inline void accumulate_product( const column_view & left, std::size_t ll,
+    const column_view & right, std::size_t rr, long double & sum,
+    int & least_sigdig_exponent )
+{
+    const long double product = left.get_exact_value( ll ) * right.get_exact_value( rr );
+    const int exponent = helper::calculate_product_exponent( product,
+        left.get_most_sigdig_exponent( ll ) + right.get_most_sigdig_exponent( rr ) );
+    const unsigned int digits = std::min( left.get_digit_count( ll ), right.get_digit_count( rr ) );
+    sum += product;
+    least_sigdig_exponent = std::max( least_sigdig_exponent,
+        exponent - static_cast< int >( digits ) + 1 );
+}
+
+// ----------------------------------------------------------------------------
+
+matrix_view::matrix_view() :
+    elements_(),
+    rows_( 0 ),
+    columns_( 0 )
+{
+}
+
+// ----------------------------------------------------------------------------
+
+matrix_view::matrix_view( const column_view & elements, std::size_t rows,
+    std::size_t columns ) :
+    elements_( elements ),
+    rows_( rows ),
+    columns_( columns )
+{
+    if ( ( columns != 0 ) && ( rows > elements.size() / columns ) )
+    {
+        throw std::invalid_argument( "Error! Matrix has more elements than the column has values." );
+    }
+    if ( rows * columns != elements.size() )
+    {
+        throw std::invalid_argument( "Error! Matrix does not have as many elements as the column has values." );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value linear_algebra::dot( const column_view & left,
+    const column_view & right )
+{
+    if ( left.size() != right.size() )
+    {
+        throw std::invalid_argument( "Error! Columns for dot product have different sizes." );
+    }
+    if ( left.empty() )
+    {
+        throw std::invalid_argument( "Error! Columns for dot product are empty." );
+    }
+    long double sum = 0.0L;
+    int least_sigdig_exponent = INT_MIN;
+    for ( std::size_t ii = 0; ii < left.size(); ++ii )
+    {
+        accumulate_product( left, ii, right, ii, sum, least_sigdig_exponent );
+    }
+    int exponent = 0;
+    const unsigned int digits =
+        helper::calculate_sum_digits( sum, least_sigdig_exponent, exponent );
+    return helper::make_calculated( sum, digits, exponent );
+}
+
+// ----------------------------------------------------------------------------
+
+void linear_algebra::gemv( const matrix_view & matrix, const column_view & vector,
+    significant_column & result )
+{
+    if ( matrix.get_column_count() != vector.size() )
+    {
+        throw std::invalid_argument( "Error! Vector size does not match matrix columns." );
+    }
+    if ( vector.empty() )
+    {
+        throw std::invalid_argument( "Error! Matrix and vector are empty." );
+    }
+    const column_view & elements = matrix.get_elements();
+    const std::size_t rows = matrix.get_row_count();
+    result.resize( rows );
+    for ( std::size_t row = 0; row < rows; ++row )
+    {
+        long double sum = 0.0L;
+        int least_sigdig_exponent = INT_MIN;
+        const std::size_t first = matrix.get_index( row, 0 );
+        for ( std::size_t ii = 0; ii < vector.size(); ++ii )
+        {
+            accumulate_product( elements, first + ii, vector, ii, sum, least_sigdig_exponent );
+        }
+        int exponent = 0;
+        const unsigned int digits =
+            helper::calculate_sum_digits( sum, least_sigdig_exponent, exponent );
+        result.set( row, sum, digits, exponent );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void linear_algebra::gemm( const matrix_view & left, const matrix_view & right,
+    significant_column & result )
+{
+    if ( left.get_column_count() != right.get_row_count() )
+    {
+        throw std::invalid_argument( "Error! Matrix sizes do not match for multiplication." );
+    }
+    if ( left.get_column_count() == 0 )
+    {
+        throw std::invalid_argument( "Error! Matrices are empty." );
+    }
+    const column_view & a = left.get_elements();
+    const column_view & b = right.get_elements();
+    const std::size_t rows = left.get_row_count();
+    const std::size_t columns = right.get_column_count();
+    const std::size_t inner = left.get_column_count();
+    std::vector< long double > sums( rows * columns, 0.0L );
+    std::vector< int > least_sigdig_exponents( rows * columns, INT_MIN );
+
+    // Each tile of the output is revisited once per tile of inner terms, so
+    // the rows of right used by a tile stay in cache. Terms are still added in
+    // order for each output element, so results match a plain loop.
+    for ( std::size_t row_tile = 0; row_tile < rows; row_tile += tile_size )
+    {
+        const std::size_t row_end = std::min( rows, row_tile + tile_size );
+        for ( std::size_t inner_tile = 0; inner_tile < inner; inner_tile += tile_size )
+        {
+            const std::size_t inner_end = std::min( inner, inner_tile + tile_size );
+            for ( std::size_t column_tile = 0; column_tile < columns; column_tile += tile_size )
+            {
+                const std::size_t column_end = std::min( columns, column_tile + tile_size );
+                for ( std::size_t row = row_tile; row < row_end; ++row )
+                {
+                    long double * sum_row = sums.data() + row * columns;
+                    int * exponent_row = least_sigdig_exponents.data() + row * columns;
+                    for ( std::size_t kk = inner_tile; kk < inner_end; ++kk )
+                    {
+                        const std::size_t place = left.get_index( row, kk );
+                        for ( std::size_t column = column_tile; column < column_end; ++column )
+                        {
+                            accumulate_product( a, place, b, right.get_index( kk, column ),
+                                sum_row[ column ], exponent_row[ column ] );
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    result.resize( rows * columns );
+    for ( std::size_t ii = 0; ii < sums.size(); ++ii )
+    {
+        int exponent = 0;
+        const unsigned int digits =
+            helper::calculate_sum_digits( sums[ ii ], least_sigdig_exponents[ ii ], exponent );
+        result.set( ii, sums[ ii ], digits, exponent );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
@@ -5,6 +5,7 @@
 // both that copyright notice and this permission notice appear in supporting documentation.
 
 #include "lookup.hpp"
+#include "counters.hpp"
 
 #include <cassert>
 #include <cmath>
@@ -1715,6 +1716,7 @@ void set_initial_bounds( long double value, unsigned int & first,
 
 int lookup::calculate_exponent( long double value )
 {
+    SIGDIG_COUNT( exponent_calculations );
     if ( value == 0.0L )
     {
         return 0;
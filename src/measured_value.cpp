@@ -15,6 +15,7 @@
     #include <iostream>
 #endif
 
+#include "counters.hpp"
 #include "helper.hpp"
 
 namespace sigdig {
@@ -24,6 +25,7 @@ namespace sigdig {
 measured_value::measured_value( long double value  ) :
     significant_value( value )
 {
+    SIGDIG_COUNT( measured_value_constructions );
 }
 
 // ----------------------------------------------------------------------------
@@ -31,6 +33,15 @@ measured_value::measured_value( long double value  ) :
 measured_value::measured_value( long double value, unsigned int digits ) :
     significant_value( value, digits )
 {
+    SIGDIG_COUNT( measured_value_constructions );
+}
+
+// ----------------------------------------------------------------------------
+
+measured_value::measured_value( long double value, deferred_metadata deferred ) :
+    significant_value( value, deferred )
+{
+    SIGDIG_COUNT( measured_value_constructions );
 }
 
 // ----------------------------------------------------------------------------
@@ -38,6 +49,7 @@ measured_value::measured_value( long double value, unsigned int digits ) :
 measured_value::measured_value( long value ) :
     significant_value( value )
 {
+    SIGDIG_COUNT( measured_value_constructions );
 }
 
 // ----------------------------------------------------------------------------
@@ -45,6 +57,7 @@ measured_value::measured_value( long value ) :
 measured_value::measured_value( long value, unsigned int digits ) :
     significant_value( value, digits )
 {
+    SIGDIG_COUNT( measured_value_constructions );
 }
 
 // ----------------------------------------------------------------------------
@@ -52,6 +65,7 @@ measured_value::measured_value( long value, unsigned int digits ) :
 measured_value::measured_value( unsigned long value ) :
     significant_value( value )
 {
+    SIGDIG_COUNT( measured_value_constructions );
 }
 
 // ----------------------------------------------------------------------------
@@ -59,57 +73,153 @@ measured_value::measured_value( unsigned long value ) :
 measured_value::measured_value( unsigned long value, unsigned int digits ) :
     significant_value( value, digits )
 {
+    SIGDIG_COUNT( measured_value_constructions );
 }
 
 // ----------------------------------------------------------------------------
 
-measured_value::measured_value( const char * value ) :
+measured_value::measured_value( long long value ) :
     significant_value( value )
 {
+    SIGDIG_COUNT( measured_value_constructions );
 }
 
 // ----------------------------------------------------------------------------
 
-measured_value::measured_value( const char * value, unsigned int digits ) :
+measured_value::measured_value( long long value, unsigned int digits ) :
     significant_value( value, digits )
 {
+    SIGDIG_COUNT( measured_value_constructions );
 }
 
 // ----------------------------------------------------------------------------
 
-measured_value::measured_value( const std::string & value ) :
+measured_value::measured_value( unsigned long long value ) :
     significant_value( value )
 {
+    SIGDIG_COUNT( measured_value_constructions );
 }
 
 // ----------------------------------------------------------------------------
 
-measured_value::measured_value( const std::string & value,
-    unsigned int digits ) :
+measured_value::measured_value( unsigned long long value, unsigned int digits ) :
     significant_value( value, digits )
 {
+    SIGDIG_COUNT( measured_value_constructions );
 }
 
 // ----------------------------------------------------------------------------
 
-measured_value::measured_value( const measured_value & that ) :
-    significant_value( that )
+#ifdef __SIZEOF_INT128__
+
+measured_value::measured_value( __int128 value ) :
+    significant_value( value )
 {
+    SIGDIG_COUNT( measured_value_constructions );
 }
 
 // ----------------------------------------------------------------------------
 
-measured_value::measured_value( long double value, unsigned int digits,
-    int exponent, int least_sigdig_exponent ) :
-    significant_value( value, digits, exponent, least_sigdig_exponent )
+measured_value::measured_value( __int128 value, unsigned int digits ) :
+    significant_value( value, digits )
+{
+    SIGDIG_COUNT( measured_value_constructions );
+}
+
+// ----------------------------------------------------------------------------
+
+measured_value::measured_value( unsigned __int128 value ) :
+    significant_value( value )
 {
+    SIGDIG_COUNT( measured_value_constructions );
 }
 
 // ----------------------------------------------------------------------------
 
-measured_value::~measured_value()
+measured_value::measured_value( unsigned __int128 value, unsigned int digits ) :
+    significant_value( value, digits )
 {
-    // No need to call is_sane since base class destructor will do that.
+    SIGDIG_COUNT( measured_value_constructions );
+}
+
+// ----------------------------------------------------------------------------
+
+#endif
+
+// ----------------------------------------------------------------------------
+
+/// Finds the exponent of the least significant digit from the coefficient instead of the binary value.
+template < typename Traits >
+static int calculate_least_sigdig_exponent( const decimal_number< Traits > & value )
+{
+    return value.get_most_significant_exponent() -
+        static_cast< int >( value.count_significant_digits() ) + 1;
+}
+
+// ----------------------------------------------------------------------------
+
+measured_value::measured_value( const decimal64 & value ) :
+    significant_value( helper::validate_input_value( value.to_long_double() ),
+        helper::validate_digit_count( value.count_significant_digits() ),
+        value.get_most_significant_exponent(), calculate_least_sigdig_exponent( value ) )
+{
+    SIGDIG_COUNT( measured_value_constructions );
+}
+
+// ----------------------------------------------------------------------------
+
+#ifdef __SIZEOF_INT128__
+
+measured_value::measured_value( const decimal128 & value ) :
+    significant_value( helper::validate_input_value( value.to_long_double() ),
+        helper::validate_digit_count( value.count_significant_digits() ),
+        value.get_most_significant_exponent(), calculate_least_sigdig_exponent( value ) )
+{
+    SIGDIG_COUNT( measured_value_constructions );
+}
+
+#endif
+
+// ----------------------------------------------------------------------------
+
+measured_value::measured_value( const char * value ) :
+    significant_value( value )
+{
+    SIGDIG_COUNT( measured_value_constructions );
+}
+
+// ----------------------------------------------------------------------------
+
+measured_value::measured_value( const char * value, unsigned int digits ) :
+    significant_value( value, digits )
+{
+    SIGDIG_COUNT( measured_value_constructions );
+}
+
+// ----------------------------------------------------------------------------
+
+measured_value::measured_value( const std::string & value ) :
+    significant_value( value )
+{
+    SIGDIG_COUNT( measured_value_constructions );
+}
+
+// ----------------------------------------------------------------------------
+
+measured_value::measured_value( const std::string & value,
+    unsigned int digits ) :
+    significant_value( value, digits )
+{
+    SIGDIG_COUNT( measured_value_constructions );
+}
+
+// ----------------------------------------------------------------------------
+
+measured_value::measured_value( long double value, unsigned int digits,
+    int exponent, int least_sigdig_exponent ) :
+    significant_value( value, digits, exponent, least_sigdig_exponent )
+{
+    SIGDIG_COUNT( measured_value_constructions );
 }
 
 // ----------------------------------------------------------------------------
@@ -131,6 +241,14 @@ measured_value & measured_value::assign( long double value,
 
 // ----------------------------------------------------------------------------
 
+measured_value & measured_value::assign( long double value, deferred_metadata deferred )
+{
+    significant_value::assign( value, deferred );
+    return *this;
+}
+
+// ----------------------------------------------------------------------------
+
 measured_value & measured_value::assign( long value )
 {
     significant_value::assign( value );
@@ -200,6 +318,7 @@ measured_value & measured_value::assign( const std::string & value,
 
 measured_value & measured_value::assign( const measured_value & that )
 {
+    *this = that;
     return *this;
 }
 
@@ -229,28 +348,11 @@ measured_value & measured_value::operator = ( unsigned long value )
 
 // ----------------------------------------------------------------------------
 
-measured_value & measured_value::operator = ( const measured_value & that )
-{
-    assert( is_sane() );
-    assert( that.is_sane() );
-    if ( this != &that )
-    {
-        value_  = that.value_;
-        digits_ = that.digits_;
-        most_sigdig_exponent_  = that.most_sigdig_exponent_;
-        least_sigdig_exponent_ = that.least_sigdig_exponent_;
-        assert( is_sane() );
-    }
-    return *this;
-}
-
-// ----------------------------------------------------------------------------
-
 measured_value measured_value::operator - () const
 {
     assert( is_sane() );
-    measured_value difference( -value_, digits_, most_sigdig_exponent_,
-        least_sigdig_exponent_ );
+    measured_value difference( -value_, get_digit_count(), get_most_sigdig_exponent(),
+        get_least_sigdig_exponent() );
     return difference;
 }
 
@@ -260,8 +362,8 @@ measured_value measured_value::absolute() const
 {
     assert( is_sane() );
     const long double v = std::abs( value_ );
-    measured_value result( v, digits_, most_sigdig_exponent_,
-        least_sigdig_exponent_ );
+    measured_value result( v, get_digit_count(), get_most_sigdig_exponent(),
+        get_least_sigdig_exponent() );
     return result;
 }
 
@@ -272,8 +374,8 @@ measured_value measured_value::truncate() const
     assert( is_sane() );
     const long double v = std::trunc( value_ );
     const int least_sigdig_exponent = 0;
-    const int digits = most_sigdig_exponent_ + 1;
-    measured_value result( v, digits, most_sigdig_exponent_,
+    const int digits = get_most_sigdig_exponent() + 1;
+    measured_value result( v, digits, get_most_sigdig_exponent(),
         least_sigdig_exponent );
     return result;
 }
@@ -289,7 +391,7 @@ measured_value measured_value::square_root() const
             "Error. Cannot calculate the square root of a negative number." ); 
     }
     const long double v = std::sqrt( value_ );
-    measured_value result( v, digits_ );
+    measured_value result( v, get_digit_count() );
     return result;
 }
 
@@ -299,7 +401,7 @@ measured_value measured_value::cube_root() const
 {
     assert( is_sane() );
     const long double v = std::cbrt( value_ );
-    measured_value result( v, digits_ );
+    measured_value result( v, get_digit_count() );
     return result;
 }
 
@@ -308,8 +410,9 @@ measured_value measured_value::cube_root() const
 measured_value measured_value::sine() const
 {
     assert( is_sane() );
-    const long double v = std::sin( value_ );
-    measured_value result( v, digits_ );
+    const long double v = helper::calculate_at_precision( value_, get_digit_count(),
+        []( auto x ) { return std::sin( x ); } );
+    measured_value result( v, get_digit_count() );
     return result;
 }
 
@@ -318,8 +421,9 @@ measured_value measured_value::sine() const
 measured_value measured_value::cosine() const
 {
     assert( is_sane() );
-    const long double v = std::cos( value_ );
-    measured_value result( v, digits_ );
+    const long double v = helper::calculate_at_precision( value_, get_digit_count(),
+        []( auto x ) { return std::cos( x ); } );
+    measured_value result( v, get_digit_count() );
     return result;
 }
 
@@ -328,8 +432,9 @@ measured_value measured_value::cosine() const
 measured_value measured_value::tangent() const
 {
     assert( is_sane() );
-    const long double v = std::tan( value_ );
-    measured_value result( v, digits_ );
+    const long double v = helper::calculate_at_precision( value_, get_digit_count(),
+        []( auto x ) { return std::tan( x ); } );
+    measured_value result( v, get_digit_count() );
     return result;
 }
 
@@ -343,7 +448,7 @@ measured_value measured_value::arc_sine() const
         throw std::domain_error( "Error! Value for arc_sine must be from -1.0 to 1.0." );
     }
     const long double v = std::asin( value_ );
-    measured_value result( v, digits_ );
+    measured_value result( v, get_digit_count() );
     return result;
 }
 
@@ -357,7 +462,7 @@ measured_value measured_value::arc_cosine() const
         throw std::domain_error( "Error! Value for arc_cosine must be from -1.0 to 1.0." );
     }
     const long double v = std::acos( value_ );
-    measured_value result( v, digits_ );
+    measured_value result( v, get_digit_count() );
     return result;
 }
 
@@ -367,7 +472,7 @@ measured_value measured_value::arc_tangent() const
 {
     assert( is_sane() );
     const long double v = std::atan( value_ );
-    measured_value result( v, digits_ );
+    measured_value result( v, get_digit_count() );
     return result;
 }
 
@@ -381,7 +486,7 @@ measured_value measured_value::hyper_sine() const
         throw std::domain_error( "Error! Absolute value for hyper_sine may not be greater than 11357.0F." );
     }
     const long double v = std::sinh( value_ );
-    measured_value result( v, digits_ );
+    measured_value result( v, get_digit_count() );
     return result;
 }
 
@@ -395,7 +500,7 @@ measured_value measured_value::hyper_cosine() const
         throw std::domain_error( "Error! Absolute value for hyper_cosine may not be greater than 11357.0F." );
     }
     const long double v = std::cosh( value_ );
-    measured_value result( v, digits_ );
+    measured_value result( v, get_digit_count() );
     return result;
 }
 
@@ -405,7 +510,7 @@ measured_value measured_value::hyper_tangent() const
 {
     assert( is_sane() );
     const long double v = std::tanh( value_ );
-    measured_value result( v, digits_ );
+    measured_value result( v, get_digit_count() );
     return result;
 }
 
@@ -415,7 +520,7 @@ measured_value measured_value::hyper_arc_sine() const
 {
     assert( is_sane() );
     const long double v = std::asinh( value_ );
-    measured_value result( v, digits_ );
+    measured_value result( v, get_digit_count() );
     return result;
 }
 
@@ -429,7 +534,7 @@ measured_value measured_value::hyper_arc_cosine() const
         throw std::domain_error( "Error! Value for hyper_arc_cosine may not be less than 1.0." );
     }
     const long double v = std::acosh( value_ );
-    measured_value result( v, digits_ );
+    measured_value result( v, get_digit_count() );
     return result;
 }
 
@@ -443,7 +548,7 @@ measured_value measured_value::hyper_arc_tangent() const
         throw std::domain_error( "Error! Absolute value for hyper_arc_tangent must be less than 1.0." );
     }
     const long double v = std::atanh( value_ );
-    measured_value result( v, digits_ );
+    measured_value result( v, get_digit_count() );
     return result;
 }
 
@@ -453,7 +558,7 @@ measured_value measured_value::e_to_power_of() const
 {
     assert( is_sane() );
     const long double v = std::exp( value_ );
-    measured_value result( v, digits_ );
+    measured_value result( v, get_digit_count() );
     return result;
 }
 
@@ -463,7 +568,7 @@ measured_value measured_value::e_to_power_of_then_subtract_1() const
 {
     assert( is_sane() );
     const long double v = std::expm1( value_ );
-    measured_value result( v, digits_ );
+    measured_value result( v, get_digit_count() );
     return result;
 }
 
@@ -473,7 +578,7 @@ measured_value measured_value::two_to_power_of() const
 {
     assert( is_sane() );
     const long double v = std::exp2( value_ );
-    measured_value result( v, digits_ );
+    measured_value result( v, get_digit_count() );
     return result;
 }
 
@@ -483,7 +588,7 @@ measured_value measured_value::natural_log_of() const
 {
     assert( is_sane() );
     const long double v = std::log( value_ );
-    measured_value result( v, digits_ );
+    measured_value result( v, get_digit_count() );
     return result;
 }
 
@@ -493,7 +598,7 @@ measured_value measured_value::base_10_log_of() const
 {
     assert( is_sane() );
     const long double v = std::log10( value_ );
-    measured_value result( v, digits_ );
+    measured_value result( v, get_digit_count() );
     return result;
 }
 
@@ -503,7 +608,7 @@ measured_value measured_value::base_2_log_of() const
 {
     assert( is_sane() );
     const long double v = std::log2( value_ );
-    measured_value result( v, digits_ );
+    measured_value result( v, get_digit_count() );
     return result;
 }
 
@@ -0,0 +1,181 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#include "operation_counters.hpp"
+
+#include <cassert>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "counters.hpp"
+
+#ifdef SIGDIG_COUNTERS
+    #include <mutex>
+    #include <vector>
+#endif
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+#ifdef SIGDIG_COUNTERS
+
+/// Keeps track of the counters of every live thread, and the totals of threads that ended.
+struct counter_registry
+{
+    std::mutex guard;
+    std::vector< const thread_counters * > live;
+    std::array< unsigned long long, counter_snapshot::counter_count > retired;
+};
+
+// ----------------------------------------------------------------------------
+
+counter_registry & get_counter_registry()
+{
+    // Made on first use so it exists before any thread registers with it.
+    static counter_registry registry{ {}, {}, {} };
+    return registry;
+}
+
+// ----------------------------------------------------------------------------
+
+thread_local thread_counters local_counters;
+
+// ----------------------------------------------------------------------------
+
+thread_counters::thread_counters() :
+    counts_()
+{
+    counter_registry & registry = get_counter_registry();
+    std::lock_guard< std::mutex > lock( registry.guard );
+    registry.live.push_back( this );
+}
+
+// ----------------------------------------------------------------------------
+
+thread_counters::~thread_counters()
+{
+    counter_registry & registry = get_counter_registry();
+    std::lock_guard< std::mutex > lock( registry.guard );
+    for ( std::size_t ii = 0; ii < counter_snapshot::counter_count; ++ii )
+    {
+        registry.retired[ ii ] += get( ii );
+    }
+    registry.live.erase( std::find( registry.live.begin(), registry.live.end(), this ) );
+}
+
+#endif
+
+// ----------------------------------------------------------------------------
+
+bool counter_snapshot::is_enabled()
+{
+#ifdef SIGDIG_COUNTERS
+    return true;
+#else
+    return false;
+#endif
+}
+
+// ----------------------------------------------------------------------------
+
+counter_snapshot counter_snapshot::take()
+{
+    counter_snapshot snapshot;
+#ifdef SIGDIG_COUNTERS
+    counter_registry & registry = get_counter_registry();
+    std::lock_guard< std::mutex > lock( registry.guard );
+    snapshot.counts_ = registry.retired;
+    for ( const thread_counters * counters : registry.live )
+    {
+        for ( std::size_t ii = 0; ii < counter_count; ++ii )
+        {
+            snapshot.counts_[ ii ] += counters->get( ii );
+        }
+    }
+#endif
+    return snapshot;
+}
+
+// ----------------------------------------------------------------------------
+
+const char * counter_snapshot::get_name( operation_counter which )
+{
+    switch ( which )
+    {
+        case operation_counter::measured_value_constructions :   return "measured_value_constructions";
+        case operation_counter::calculated_value_constructions : return "calculated_value_constructions";
+        case operation_counter::defined_value_constructions :    return "defined_value_constructions";
+        case operation_counter::exponent_calculations :          return "exponent_calculations";
+        case operation_counter::digit_count_iterations :         return "digit_count_iterations";
+        case operation_counter::decimal_fixed_strings :          return "decimal_fixed_strings";
+        case operation_counter::decimal_exponent_strings :       return "decimal_exponent_strings";
+        case operation_counter::hexadecimal_exponent_strings :   return "hexadecimal_exponent_strings";
+        case operation_counter::invalid_input_values :           return "invalid_input_values";
+        case operation_counter::invalid_digit_counts :           return "invalid_digit_counts";
+    }
+    throw std::invalid_argument( "Error! Unknown operation counter." );
+}
+
+// ----------------------------------------------------------------------------
+
+counter_snapshot::counter_snapshot() :
+    counts_()
+{
+}
+
+// ----------------------------------------------------------------------------
+
+counter_snapshot counter_snapshot::operator - ( const counter_snapshot & earlier ) const
+{
+    counter_snapshot difference;
+    for ( std::size_t ii = 0; ii < counter_count; ++ii )
+    {
+        assert( earlier.counts_[ ii ] <= counts_[ ii ] );
+        difference.counts_[ ii ] = counts_[ ii ] - earlier.counts_[ ii ];
+    }
+    return difference;
+}
+
+// ----------------------------------------------------------------------------
+
+std::string counter_snapshot::to_json() const
+{
+    std::string result( "{" );
+    for ( std::size_t ii = 0; ii < counter_count; ++ii )
+    {
+        if ( ii != 0 )
+        {
+            result += ",";
+        }
+        result += "\"";
+        result += get_name( static_cast< operation_counter >( ii ) );
+        result += "\":";
+        result += std::to_string( counts_[ ii ] );
+    }
+    result += "}";
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+
+std::string counter_snapshot::to_prometheus() const
+{
+    std::string result;
+    for ( std::size_t ii = 0; ii < counter_count; ++ii )
+    {
+        const std::string name = std::string( "sigdig_" ) +
+            get_name( static_cast< operation_counter >( ii ) ) + "_total";
+        result += "# TYPE " + name + " counter\n";
+        result += name + " " + std::to_string( counts_[ ii ] ) + "\n";
+    }
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
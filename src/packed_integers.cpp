@@ -0,0 +1,643 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#include "packed_integers.hpp"
+
+#include <cassert>
+#include <climits>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace sigdig {
+
+// The header of an encoded sequence has these 4 words.
+//  word 0: encoding in bits 0-7, bit width in bits 8-15, entries in bits 32-63.
+//  word 1: count of integers.
+//  word 2: minimum in bits 0-31, maximum in bits 32-63.
+//  word 3: total number of words including the header.
+// Bit-packed sequences then store each integer as an offset from the minimum.
+// Dictionary sequences store the distinct offsets in 32 bits each, and then the
+// index of each integer. Run-length sequences store the end of each run in 32
+// bits, and then the offset of each run.
+
+static const unsigned int dictionary_entry_width = 32;
+static const unsigned int run_end_width = 32;
+
+// ----------------------------------------------------------------------------
+
+static unsigned int count_bits_needed( std::uint64_t range )
+{
+    unsigned int bits = 0;
+    while ( range != 0 )
+    {
+        ++bits;
+        range >>= 1;
+    }
+    return bits;
+}
+
+// ----------------------------------------------------------------------------
+
+/// Splits count into whole words of 64 entries so a count read from an
+/// untrusted header can not overflow when multiplied by a width up to 64.
+static inline std::size_t count_words_for_bits( std::size_t count, unsigned int width )
+{
+    assert( width <= 64 );
+    return ( count / 64 ) * width + ( ( count % 64 ) * width + 63 ) / 64;
+}
+
+// ----------------------------------------------------------------------------
+
+static inline std::uint64_t get_packed_bits( const std::uint64_t * words,
+    std::size_t index, unsigned int width )
+{
+    if ( width == 0 )
+    {
+        return 0;
+    }
+    const std::size_t bit_place = index * width;
+    const std::size_t word = bit_place / 64;
+    const unsigned int offset = bit_place % 64;
+    std::uint64_t bits = words[ word ] >> offset;
+    if ( offset + width > 64 )
+    {
+        bits |= words[ word + 1 ] << ( 64 - offset );
+    }
+    const std::uint64_t mask = ( width == 64 ) ? ~0ULL : ( ( 1ULL << width ) - 1 );
+    return bits & mask;
+}
+
+// ----------------------------------------------------------------------------
+
+static inline void set_packed_bits( std::uint64_t * words, std::size_t index,
+    unsigned int width, std::uint64_t bits )
+{
+    if ( width == 0 )
+    {
+        return;
+    }
+    const std::size_t bit_place = index * width;
+    const std::size_t word = bit_place / 64;
+    const unsigned int offset = bit_place % 64;
+    words[ word ] |= bits << offset;
+    if ( offset + width > 64 )
+    {
+        words[ word + 1 ] |= bits >> ( 64 - offset );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+static std::size_t count_payload_words( integer_encoding encoding, std::size_t count,
+    std::size_t entries, unsigned int width )
+{
+    switch ( encoding )
+    {
+        case integer_encoding::bit_packed:
+            return count_words_for_bits( count, width );
+        case integer_encoding::dictionary:
+            return count_words_for_bits( entries, dictionary_entry_width )
+                + count_words_for_bits( count, width );
+        case integer_encoding::run_length:
+            return count_words_for_bits( entries, run_end_width )
+                + count_words_for_bits( entries, width );
+        default: break;
+    }
+    throw std::invalid_argument( "Error! Unknown integer encoding." );
+}
+
+// ----------------------------------------------------------------------------
+
+packed_integers_view::packed_integers_view() :
+    words_( nullptr ),
+    count_( 0 ),
+    entries_( 0 ),
+    word_count_( 0 ),
+    encoding_( integer_encoding::bit_packed ),
+    width_( 0 ),
+    minimum_( 0 ),
+    maximum_( 0 )
+{
+}
+
+// ----------------------------------------------------------------------------
+
+packed_integers_view::packed_integers_view( const std::uint64_t * words,
+    std::size_t available_words ) :
+    words_( words ),
+    count_( 0 ),
+    entries_( 0 ),
+    word_count_( 0 ),
+    encoding_( integer_encoding::bit_packed ),
+    width_( 0 ),
+    minimum_( 0 ),
+    maximum_( 0 )
+{
+    if ( ( nullptr == words ) || ( available_words < header_words ) )
+    {
+        throw std::invalid_argument( "Error! Not enough words for encoded integers." );
+    }
+    const unsigned int encoding = words[ 0 ] & 0xFF;
+    width_ = ( words[ 0 ] >> 8 ) & 0xFF;
+    entries_ = words[ 0 ] >> 32;
+    count_ = words[ 1 ];
+    minimum_ = static_cast< std::int32_t >( words[ 2 ] & 0xFFFFFFFFULL );
+    maximum_ = static_cast< std::int32_t >( words[ 2 ] >> 32 );
+    word_count_ = words[ 3 ];
+    if ( ( encoding > integer_encoding::run_length ) || ( width_ > 32 ) )
+    {
+        throw std::invalid_argument( "Error! Encoded integers have an invalid header." );
+    }
+    encoding_ = static_cast< integer_encoding >( encoding );
+    const std::size_t expected_words = header_words +
+        count_payload_words( encoding_, count_, entries_, width_ );
+    if ( ( word_count_ != expected_words ) || ( word_count_ > available_words )
+      || ( minimum_ > maximum_ ) || ( ( encoding_ != integer_encoding::bit_packed ) && ( entries_ > count_ ) ) )
+    {
+        throw std::invalid_argument( "Error! Encoded integers have an invalid header." );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+int packed_integers_view::get( std::size_t index ) const
+{
+    if ( index >= count_ )
+    {
+        throw std::out_of_range( "Error! Index is outside of encoded integers." );
+    }
+    const std::uint64_t * payload = words_ + header_words;
+    switch ( encoding_ )
+    {
+        case integer_encoding::bit_packed:
+        {
+            return minimum_ + static_cast< int >( get_packed_bits( payload, index, width_ ) );
+        }
+        case integer_encoding::dictionary:
+        {
+            const std::uint64_t * indexes = payload +
+                count_words_for_bits( entries_, dictionary_entry_width );
+            const std::size_t entry = get_packed_bits( indexes, index, width_ );
+            if ( entry >= entries_ )
+            {
+                throw std::invalid_argument( "Error! Encoded integers have an invalid dictionary index." );
+            }
+            return minimum_ + static_cast< int >(
+                get_packed_bits( payload, entry, dictionary_entry_width ) );
+        }
+        case integer_encoding::run_length:
+        {
+            // Binary search for the first run which ends after index.
+            std::size_t first = 0;
+            std::size_t last = entries_;
+            while ( first < last )
+            {
+                const std::size_t place = ( first + last ) / 2;
+                if ( get_packed_bits( payload, place, run_end_width ) <= index )
+                {
+                    first = place + 1;
+                }
+                else
+                {
+                    last = place;
+                }
+            }
+            if ( first >= entries_ )
+            {
+                throw std::invalid_argument( "Error! Encoded integers have runs that end too soon." );
+            }
+            const std::uint64_t * run_values = payload +
+                count_words_for_bits( entries_, run_end_width );
+            return minimum_ + static_cast< int >( get_packed_bits( run_values, first, width_ ) );
+        }
+        default: break;
+    }
+    assert( false );
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+
+template < typename T >
+void packed_integers_view::decode_into( std::size_t first, std::size_t count,
+    T * target ) const
+{
+    if ( ( first > count_ ) || ( count > count_ - first ) )
+    {
+        throw std::out_of_range( "Error! Range is outside of encoded integers." );
+    }
+    const std::uint64_t * payload = words_ + header_words;
+    switch ( encoding_ )
+    {
+        case integer_encoding::bit_packed:
+        {
+            if ( width_ == 0 )
+            {
+                std::fill( target, target + count, static_cast< T >( minimum_ ) );
+                return;
+            }
+            for ( std::size_t ii = 0; ii < count; ++ii )
+            {
+                target[ ii ] = static_cast< T >( minimum_ +
+                    static_cast< int >( get_packed_bits( payload, first + ii, width_ ) ) );
+            }
+            return;
+        }
+        case integer_encoding::dictionary:
+        {
+            std::vector< T > entries( entries_ );
+            for ( std::size_t ii = 0; ii < entries_; ++ii )
+            {
+                entries[ ii ] = static_cast< T >( minimum_ + static_cast< int >(
+                    get_packed_bits( payload, ii, dictionary_entry_width ) ) );
+            }
+            const std::uint64_t * indexes = payload +
+                count_words_for_bits( entries_, dictionary_entry_width );
+            for ( std::size_t ii = 0; ii < count; ++ii )
+            {
+                const std::size_t entry = get_packed_bits( indexes, first + ii, width_ );
+                if ( entry >= entries_ )
+                {
+                    throw std::invalid_argument( "Error! Encoded integers have an invalid dictionary index." );
+                }
+                target[ ii ] = entries[ entry ];
+            }
+            return;
+        }
+        case integer_encoding::run_length:
+        {
+            const std::uint64_t * run_values = payload +
+                count_words_for_bits( entries_, run_end_width );
+            std::size_t place = first;
+            const std::size_t last = first + count;
+            for ( std::size_t run = 0; ( run < entries_ ) && ( place < last ); ++run )
+            {
+                const std::size_t run_end = std::min< std::size_t >( last,
+                    get_packed_bits( payload, run, run_end_width ) );
+                if ( run_end <= place )
+                {
+                    continue;
+                }
+                const T value = static_cast< T >( minimum_ +
+                    static_cast< int >( get_packed_bits( run_values, run, width_ ) ) );
+                std::fill( target + ( place - first ), target + ( run_end - first ), value );
+                place = run_end;
+            }
+            if ( place < last )
+            {
+                throw std::invalid_argument( "Error! Encoded integers have runs that end too soon." );
+            }
+            return;
+        }
+        default: break;
+    }
+    assert( false );
+}
+
+// ----------------------------------------------------------------------------
+
+void packed_integers_view::decode( std::size_t first, std::size_t count,
+    int * target ) const
+{
+    decode_into( first, count, target );
+}
+
+// ----------------------------------------------------------------------------
+
+void packed_integers_view::decode( std::size_t first, std::size_t count,
+    unsigned int * target ) const
+{
+    decode_into( first, count, target );
+}
+
+// ----------------------------------------------------------------------------
+
+std::size_t packed_integers_view::count_equal( int value ) const
+{
+    if ( ( count_ == 0 ) || ( value < minimum_ ) || ( maximum_ < value ) )
+    {
+        return 0;
+    }
+    const std::uint64_t * payload = words_ + header_words;
+    const std::uint64_t offset = static_cast< std::uint64_t >(
+        static_cast< std::int64_t >( value ) - minimum_ );
+    std::size_t matches = 0;
+    switch ( encoding_ )
+    {
+        case integer_encoding::bit_packed:
+        {
+            if ( width_ == 0 )
+            {
+                return count_;
+            }
+            for ( std::size_t ii = 0; ii < count_; ++ii )
+            {
+                matches += ( get_packed_bits( payload, ii, width_ ) == offset ) ? 1 : 0;
+            }
+            return matches;
+        }
+        case integer_encoding::dictionary:
+        {
+            std::size_t entry = 0;
+            while ( ( entry < entries_ ) &&
+                ( get_packed_bits( payload, entry, dictionary_entry_width ) != offset ) )
+            {
+                ++entry;
+            }
+            if ( entry == entries_ )
+            {
+                return 0;
+            }
+            const std::uint64_t * indexes = payload +
+                count_words_for_bits( entries_, dictionary_entry_width );
+            for ( std::size_t ii = 0; ii < count_; ++ii )
+            {
+                matches += ( get_packed_bits( indexes, ii, width_ ) == entry ) ? 1 : 0;
+            }
+            return matches;
+        }
+        case integer_encoding::run_length:
+        {
+            const std::uint64_t * run_values = payload +
+                count_words_for_bits( entries_, run_end_width );
+            std::size_t run_start = 0;
+            for ( std::size_t run = 0; run < entries_; ++run )
+            {
+                const std::size_t run_end = get_packed_bits( payload, run, run_end_width );
+                if ( get_packed_bits( run_values, run, width_ ) == offset )
+                {
+                    matches += run_end - run_start;
+                }
+                run_start = run_end;
+            }
+            return matches;
+        }
+        default: break;
+    }
+    assert( false );
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+
+std::size_t packed_integers_view::count_runs() const
+{
+    if ( count_ == 0 )
+    {
+        return 0;
+    }
+    if ( encoding_ == integer_encoding::run_length )
+    {
+        return entries_;
+    }
+    if ( minimum_ == maximum_ )
+    {
+        return 1;
+    }
+    std::size_t runs = 1;
+    int previous = get( 0 );
+    for ( std::size_t ii = 1; ii < count_; ++ii )
+    {
+        const int current = get( ii );
+        if ( current != previous )
+        {
+            ++runs;
+            previous = current;
+        }
+    }
+    return runs;
+}
+
+// ----------------------------------------------------------------------------
+
+packed_integers::packed_integers() :
+    words_(),
+    view_()
+{
+    encode( nullptr, 0, integer_encoding::bit_packed );
+}
+
+// ----------------------------------------------------------------------------
+
+packed_integers::packed_integers( const int * values, std::size_t count ) :
+    words_(),
+    view_()
+{
+    encode( values, count, choose_encoding( values, count ) );
+}
+
+// ----------------------------------------------------------------------------
+
+packed_integers::packed_integers( const unsigned int * values,
+    std::size_t count ) :
+    words_(),
+    view_()
+{
+    std::vector< int > converted( count );
+    for ( std::size_t ii = 0; ii < count; ++ii )
+    {
+        if ( values[ ii ] > static_cast< unsigned int >( INT_MAX ) )
+        {
+            throw std::invalid_argument( "Error! Integer is too large to encode." );
+        }
+        converted[ ii ] = static_cast< int >( values[ ii ] );
+    }
+    encode( converted.data(), count, choose_encoding( converted.data(), count ) );
+}
+
+// ----------------------------------------------------------------------------
+
+packed_integers::packed_integers( const int * values, std::size_t count,
+    integer_encoding encoding ) :
+    words_(),
+    view_()
+{
+    encode( values, count, encoding );
+}
+
+// ----------------------------------------------------------------------------
+
+packed_integers::packed_integers( const packed_integers & that ) :
+    words_( that.words_ ),
+    view_( words_.data(), words_.size() )
+{
+}
+
+// ----------------------------------------------------------------------------
+
+packed_integers & packed_integers::operator = ( const packed_integers & that )
+{
+    if ( this != &that )
+    {
+        words_ = that.words_;
+        view_ = packed_integers_view( words_.data(), words_.size() );
+    }
+    return *this;
+}
+
+// ----------------------------------------------------------------------------
+
+integer_encoding packed_integers::choose_encoding( const int * values,
+    std::size_t count )
+{
+    if ( count == 0 )
+    {
+        return integer_encoding::bit_packed;
+    }
+    const auto range = std::minmax_element( values, values + count );
+    const unsigned int width = count_bits_needed( static_cast< std::uint64_t >(
+        static_cast< std::int64_t >( *range.second ) - *range.first ) );
+    std::vector< int > distinct;
+    std::size_t runs = 1;
+    for ( std::size_t ii = 0; ii < count; ++ii )
+    {
+        if ( ( ii != 0 ) && ( values[ ii ] != values[ ii - 1 ] ) )
+        {
+            ++runs;
+        }
+        if ( ( distinct.size() <= 256 ) &&
+             ( std::find( distinct.begin(), distinct.end(), values[ ii ] ) == distinct.end() ) )
+        {
+            distinct.push_back( values[ ii ] );
+        }
+    }
+    const std::size_t packed_words =
+        count_payload_words( integer_encoding::bit_packed, count, 0, width );
+    const std::size_t run_words = ( count <= UINT32_MAX ) ?
+        count_payload_words( integer_encoding::run_length, count, runs, width ) :
+        SIZE_MAX;
+    const std::size_t dictionary_words = ( distinct.size() <= 256 ) ?
+        count_payload_words( integer_encoding::dictionary, count, distinct.size(),
+            count_bits_needed( distinct.size() - 1 ) ) :
+        SIZE_MAX;
+    // Prefer bit packing when sizes are equal since it is the fastest to decode.
+    if ( ( run_words < packed_words ) && ( run_words <= dictionary_words ) )
+    {
+        return integer_encoding::run_length;
+    }
+    if ( dictionary_words < packed_words )
+    {
+        return integer_encoding::dictionary;
+    }
+    return integer_encoding::bit_packed;
+}
+
+// ----------------------------------------------------------------------------
+
+void packed_integers::encode( const int * values, std::size_t count,
+    integer_encoding encoding )
+{
+    int minimum = 0;
+    int maximum = 0;
+    if ( 0 < count )
+    {
+        const auto range = std::minmax_element( values, values + count );
+        minimum = *range.first;
+        maximum = *range.second;
+    }
+    const unsigned int value_width = count_bits_needed( static_cast< std::uint64_t >(
+        static_cast< std::int64_t >( maximum ) - minimum ) );
+    auto offset_of = [ minimum ]( int value )
+    {
+        return static_cast< std::uint64_t >( static_cast< std::int64_t >( value ) - minimum );
+    };
+
+    std::size_t entries = 0;
+    unsigned int width = value_width;
+    std::vector< int > distinct;
+    if ( encoding == integer_encoding::dictionary )
+    {
+        distinct.assign( values, values + count );
+        std::sort( distinct.begin(), distinct.end() );
+        distinct.erase( std::unique( distinct.begin(), distinct.end() ), distinct.end() );
+        entries = distinct.size();
+        width = ( entries <= 1 ) ? 0 : count_bits_needed( entries - 1 );
+    }
+    else if ( encoding == integer_encoding::run_length )
+    {
+        if ( count > UINT32_MAX )
+        {
+            throw std::invalid_argument( "Error! Too many integers for run-length encoding." );
+        }
+        for ( std::size_t ii = 0; ii < count; ++ii )
+        {
+            if ( ( ii == 0 ) || ( values[ ii ] != values[ ii - 1 ] ) )
+            {
+                ++entries;
+            }
+        }
+    }
+
+    const std::size_t word_count = packed_integers_view::header_words +
+        count_payload_words( encoding, count, entries, width );
+    std::vector< std::uint64_t > words( word_count, 0 );
+    words[ 0 ] = static_cast< std::uint64_t >( encoding )
+        | ( static_cast< std::uint64_t >( width ) << 8 )
+        | ( static_cast< std::uint64_t >( entries ) << 32 );
+    words[ 1 ] = count;
+    words[ 2 ] = static_cast< std::uint32_t >( minimum )
+        | ( static_cast< std::uint64_t >( static_cast< std::uint32_t >( maximum ) ) << 32 );
+    words[ 3 ] = word_count;
+    std::uint64_t * payload = words.data() + packed_integers_view::header_words;
+
+    switch ( encoding )
+    {
+        case integer_encoding::bit_packed:
+        {
+            for ( std::size_t ii = 0; ii < count; ++ii )
+            {
+                set_packed_bits( payload, ii, width, offset_of( values[ ii ] ) );
+            }
+            break;
+        }
+        case integer_encoding::dictionary:
+        {
+            for ( std::size_t ii = 0; ii < entries; ++ii )
+            {
+                set_packed_bits( payload, ii, dictionary_entry_width, offset_of( distinct[ ii ] ) );
+            }
+            std::uint64_t * indexes = payload +
+                count_words_for_bits( entries, dictionary_entry_width );
+            for ( std::size_t ii = 0; ii < count; ++ii )
+            {
+                const std::size_t entry = std::lower_bound( distinct.begin(),
+                    distinct.end(), values[ ii ] ) - distinct.begin();
+                set_packed_bits( indexes, ii, width, entry );
+            }
+            break;
+        }
+        case integer_encoding::run_length:
+        {
+            std::uint64_t * run_values = payload +
+                count_words_for_bits( entries, run_end_width );
+            std::size_t run = 0;
+            for ( std::size_t ii = 0; ii < count; ++ii )
+            {
+                const bool is_last_of_run = ( ii + 1 == count ) || ( values[ ii + 1 ] != values[ ii ] );
+                if ( is_last_of_run )
+                {
+                    set_packed_bits( payload, run, run_end_width, ii + 1 );
+                    set_packed_bits( run_values, run, width, offset_of( values[ ii ] ) );
+                    ++run;
+                }
+            }
+            assert( run == entries );
+            break;
+        }
+        default:
+        {
+            throw std::invalid_argument( "Error! Unknown integer encoding." );
+        }
+    }
+
+    words_.swap( words );
+    view_ = packed_integers_view( words_.data(), words_.size() );
+}
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
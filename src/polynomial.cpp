@@ -0,0 +1,152 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#include "polynomial.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "defined_value.hpp"
+#include "helper.hpp"
+#include "lookup.hpp"
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+polynomial::polynomial() :
+    values_(),
+    digits_(),
+    exponents_()
+{
+}
+
+// ----------------------------------------------------------------------------
+
+polynomial::polynomial( const std::vector< defined_value > & coefficients ) :
+    values_(),
+    digits_(),
+    exponents_()
+{
+    for ( const defined_value & coefficient : coefficients )
+    {
+        add_term( coefficient );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+polynomial::polynomial( const column_view & coefficients ) :
+    values_( coefficients.get_values(), coefficients.get_values() + coefficients.size() ),
+    digits_( coefficients.get_digit_counts(), coefficients.get_digit_counts() + coefficients.size() ),
+    exponents_( coefficients.get_most_sigdig_exponents(),
+        coefficients.get_most_sigdig_exponents() + coefficients.size() )
+{
+}
+
+// ----------------------------------------------------------------------------
+
+void polynomial::add_term( const defined_value & coefficient )
+{
+    values_.push_back( coefficient.get_value() );
+    digits_.push_back( 0 );
+    exponents_.push_back( 0 );
+}
+
+// ----------------------------------------------------------------------------
+
+void polynomial::add_term( const significant_value & coefficient )
+{
+    values_.push_back( coefficient.get_exact_value() );
+    digits_.push_back( coefficient.get_digit_count() );
+    exponents_.push_back( coefficient.get_most_sigdig_exponent() );
+}
+
+// ----------------------------------------------------------------------------
+
+void polynomial::validate_terms() const
+{
+    if ( values_.empty() )
+    {
+        throw std::invalid_argument( "Error! Unable to evaluate a polynomial with no terms." );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void polynomial::evaluate( long double x, unsigned int x_digits, int x_exponent,
+    long double & value, unsigned int & digits, int & exponent ) const
+{
+    std::size_t term = values_.size() - 1;
+    value = values_[ term ];
+    digits = digits_[ term ];
+    exponent = exponents_[ term ];
+    bool is_defined = ( digits == 0 );
+    while ( term != 0 )
+    {
+        --term;
+        const long double product = value * x;
+        if ( is_defined )
+        {
+            // A defined value times x keeps the digits of x.
+            digits = x_digits;
+            exponent = lookup::calculate_exponent( product );
+            is_defined = false;
+        }
+        else
+        {
+            digits = std::min( digits, x_digits );
+            exponent = helper::calculate_product_exponent( product, exponent + x_exponent );
+        }
+        int least_sigdig_exponent = exponent - static_cast< int >( digits ) + 1;
+        if ( digits_[ term ] != 0 )
+        {
+            least_sigdig_exponent = std::max( least_sigdig_exponent,
+                exponents_[ term ] - static_cast< int >( digits_[ term ] ) + 1 );
+        }
+        value = product + values_[ term ];
+        digits = helper::calculate_sum_digits( value, least_sigdig_exponent, exponent );
+    }
+    if ( is_defined )
+    {
+        digits = x_digits;
+        exponent = lookup::calculate_exponent( value );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value polynomial::evaluate( const significant_value & x ) const
+{
+    validate_terms();
+    long double value = 0.0L;
+    unsigned int digits = 0;
+    int exponent = 0;
+    evaluate( x.get_exact_value(), x.get_digit_count(), x.get_most_sigdig_exponent(),
+        value, digits, exponent );
+    return helper::make_calculated( value, digits, exponent );
+}
+
+// ----------------------------------------------------------------------------
+
+void polynomial::evaluate( const column_view & x, significant_column & result ) const
+{
+    validate_terms();
+    const std::size_t count = x.size();
+    result.resize( count );
+    long double * values = result.get_values();
+    unsigned int * digits = result.get_digit_counts();
+    int * exponents = result.get_most_sigdig_exponents();
+    for ( std::size_t ii = 0; ii < count; ++ii )
+    {
+        evaluate( x.get_exact_value( ii ), x.get_digit_count( ii ),
+            x.get_most_sigdig_exponent( ii ), values[ ii ], digits[ ii ], exponents[ ii ] );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
@@ -0,0 +1,297 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#include "precision_telemetry.hpp"
+
+#include <cassert>
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+
+#include "telemetry.hpp"
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+class thread_histograms;
+
+/// Keeps the tag names, the histograms of every live thread, and the totals of threads that ended.
+struct telemetry_registry
+{
+    telemetry_registry() : guard(), names( 1, std::string( "untagged" ) ), live(), retired() {}
+
+    std::mutex guard;
+    std::vector< std::string > names;
+    std::vector< const thread_histograms * > live;
+    std::vector< precision_histograms::tag_bins > retired;
+};
+
+// ----------------------------------------------------------------------------
+
+telemetry_registry & get_telemetry_registry()
+{
+    // Made on first use so it exists before any thread registers with it.
+    static telemetry_registry registry;
+    return registry;
+}
+
+// ----------------------------------------------------------------------------
+
+#ifdef SIGDIG_TELEMETRY
+
+thread_local thread_histograms local_histograms;
+
+// ----------------------------------------------------------------------------
+
+thread_histograms::thread_histograms() :
+    tags_(),
+    current_( nullptr ),
+    tag_( precision_telemetry::untagged )
+{
+    telemetry_registry & registry = get_telemetry_registry();
+    std::lock_guard< std::mutex > lock( registry.guard );
+    registry.live.push_back( this );
+}
+
+// ----------------------------------------------------------------------------
+
+thread_histograms::~thread_histograms()
+{
+    telemetry_registry & registry = get_telemetry_registry();
+    std::lock_guard< std::mutex > lock( registry.guard );
+    add_to( registry.retired );
+    registry.live.erase( std::find( registry.live.begin(), registry.live.end(), this ) );
+}
+
+// ----------------------------------------------------------------------------
+
+void thread_histograms::select( unsigned int tag )
+{
+    if ( ( tag < tags_.size() ) && tags_[ tag ] )
+    {
+        tag_ = tag;
+        current_ = tags_[ tag ].get();
+        return;
+    }
+    // Growing the bins happens under the lock so a snapshot never sees it half done.
+    telemetry_registry & registry = get_telemetry_registry();
+    std::lock_guard< std::mutex > lock( registry.guard );
+    if ( tag >= registry.names.size() )
+    {
+        throw std::out_of_range( "Error! Unknown precision telemetry tag." );
+    }
+    if ( tag >= tags_.size() )
+    {
+        tags_.resize( tag + 1 );
+    }
+    tags_[ tag ].reset( new tag_counts() );
+    tag_ = tag;
+    current_ = tags_[ tag ].get();
+}
+
+// ----------------------------------------------------------------------------
+
+void thread_histograms::add_to( std::vector< precision_histograms::tag_bins > & counts ) const
+{
+    if ( counts.size() < tags_.size() )
+    {
+        counts.resize( tags_.size(), precision_histograms::tag_bins() );
+    }
+    for ( std::size_t tag = 0; tag < tags_.size(); ++tag )
+    {
+        if ( !tags_[ tag ] )
+        {
+            continue;
+        }
+        const tag_counts & source = *tags_[ tag ];
+        precision_histograms::tag_bins & target = counts[ tag ];
+        for ( std::size_t ii = 0; ii < precision_histograms::bins_per_tag; ++ii )
+        {
+            target[ ii ] += source.bins[ ii ].load( std::memory_order_relaxed );
+        }
+    }
+}
+
+#endif
+
+// ----------------------------------------------------------------------------
+
+bool precision_telemetry::is_enabled()
+{
+#ifdef SIGDIG_TELEMETRY
+    return true;
+#else
+    return false;
+#endif
+}
+
+// ----------------------------------------------------------------------------
+
+unsigned int precision_telemetry::find_tag( const std::string & name )
+{
+    telemetry_registry & registry = get_telemetry_registry();
+    std::lock_guard< std::mutex > lock( registry.guard );
+    const auto found = std::find( registry.names.begin(), registry.names.end(), name );
+    if ( found != registry.names.end() )
+    {
+        return static_cast< unsigned int >( found - registry.names.begin() );
+    }
+    registry.names.push_back( name );
+    return static_cast< unsigned int >( registry.names.size() - 1 );
+}
+
+// ----------------------------------------------------------------------------
+
+precision_histograms precision_telemetry::take()
+{
+    telemetry_registry & registry = get_telemetry_registry();
+    std::lock_guard< std::mutex > lock( registry.guard );
+#ifdef SIGDIG_TELEMETRY
+    std::vector< precision_histograms::tag_bins > counts( registry.retired );
+    for ( const thread_histograms * histograms : registry.live )
+    {
+        histograms->add_to( counts );
+    }
+#else
+    std::vector< precision_histograms::tag_bins > counts;
+#endif
+    counts.resize( registry.names.size(), precision_histograms::tag_bins() );
+    return precision_histograms( registry.names, counts );
+}
+
+// ----------------------------------------------------------------------------
+
+precision_telemetry::scope::scope( unsigned int tag ) :
+    previous_( precision_telemetry::untagged )
+{
+#ifdef SIGDIG_TELEMETRY
+    previous_ = local_histograms.get_tag();
+    local_histograms.select( tag );
+#else
+    telemetry_registry & registry = get_telemetry_registry();
+    std::lock_guard< std::mutex > lock( registry.guard );
+    if ( tag >= registry.names.size() )
+    {
+        throw std::out_of_range( "Error! Unknown precision telemetry tag." );
+    }
+#endif
+}
+
+// ----------------------------------------------------------------------------
+
+precision_telemetry::scope::~scope()
+{
+#ifdef SIGDIG_TELEMETRY
+    local_histograms.restore( previous_ );
+#endif
+}
+
+// ----------------------------------------------------------------------------
+
+precision_histograms::precision_histograms( const std::vector< std::string > & names,
+    const std::vector< tag_bins > & counts ) :
+    names_( names ),
+    counts_( counts )
+{
+    assert( names_.size() == counts_.size() );
+}
+
+// ----------------------------------------------------------------------------
+
+const std::string & precision_histograms::get_tag_name( unsigned int tag ) const
+{
+    if ( tag >= names_.size() )
+    {
+        throw std::out_of_range( "Error! Unknown precision telemetry tag." );
+    }
+    return names_[ tag ];
+}
+
+// ----------------------------------------------------------------------------
+
+unsigned long long precision_histograms::get_count( unsigned int tag,
+    digit_operation operation, unsigned int input_digits, unsigned int output_digits ) const
+{
+    if ( ( tag >= counts_.size() ) || ( input_digits > max_digits ) || ( output_digits > max_digits ) )
+    {
+        throw std::out_of_range( "Error! Unknown precision telemetry tag or digit count." );
+    }
+    return counts_[ tag ][ get_bin( operation, input_digits, static_cast< int >( output_digits ) ) ];
+}
+
+// ----------------------------------------------------------------------------
+
+unsigned long long precision_histograms::get_loss_count( unsigned int tag,
+    digit_operation operation ) const
+{
+    if ( tag >= counts_.size() )
+    {
+        throw std::out_of_range( "Error! Unknown precision telemetry tag." );
+    }
+    unsigned long long total = 0;
+    for ( unsigned int input = 1; input <= max_digits; ++input )
+    {
+        for ( unsigned int output = 0; output < input; ++output )
+        {
+            total += counts_[ tag ][ get_bin( operation, input, static_cast< int >( output ) ) ];
+        }
+    }
+    return total;
+}
+
+// ----------------------------------------------------------------------------
+
+std::string precision_histograms::to_json() const
+{
+    static const char * const operation_names[ operation_count ] =
+        { "add", "subtract", "multiply", "divide" };
+    std::string result( "{\"tags\":[" );
+    for ( std::size_t tag = 0; tag < names_.size(); ++tag )
+    {
+        if ( tag != 0 )
+        {
+            result += ",";
+        }
+        // Tag names are written as given, so they should not need escaping.
+        result += "{\"tag\":\"" + names_[ tag ] + "\"";
+        for ( std::size_t operation = 0; operation < operation_count; ++operation )
+        {
+            result += ",\"";
+            result += operation_names[ operation ];
+            result += "\":[";
+            bool first = true;
+            for ( unsigned int input = 0; input <= max_digits; ++input )
+            {
+                for ( unsigned int output = 0; output <= max_digits; ++output )
+                {
+                    const unsigned long long count = counts_[ tag ][ get_bin(
+                        static_cast< digit_operation >( operation ), input, static_cast< int >( output ) ) ];
+                    if ( count == 0 )
+                    {
+                        continue;
+                    }
+                    if ( !first )
+                    {
+                        result += ",";
+                    }
+                    first = false;
+                    result += "[" + std::to_string( input ) + "," + std::to_string( output ) + "," +
+                        std::to_string( count ) + "]";
+                }
+            }
+            result += "]";
+        }
+        result += "}";
+    }
+    result += "]}";
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
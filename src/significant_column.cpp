@@ -0,0 +1,200 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#include "significant_column.hpp"
+
+#include <cassert>
+
+#include <stdexcept>
+
+#include "helper.hpp"
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+column_view::column_view() :
+    values_( nullptr ),
+    digits_( nullptr ),
+    exponents_( nullptr ),
+    count_( 0 )
+{
+}
+
+// ----------------------------------------------------------------------------
+
+column_view::column_view( const long double * values,
+    const unsigned int * digits, const int * exponents, std::size_t count ) :
+    values_( values ),
+    digits_( digits ),
+    exponents_( exponents ),
+    count_( count )
+{
+    if ( ( count != 0 ) &&
+         ( ( nullptr == values ) || ( nullptr == digits ) || ( nullptr == exponents ) ) )
+    {
+        throw std::invalid_argument(
+            "Error! A column_view with values may not have a null array." );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+column_view column_view::slice( std::size_t first, std::size_t count ) const
+{
+    if ( ( first > count_ ) || ( count > count_ - first ) )
+    {
+        throw std::out_of_range( "Error! Slice is outside of column_view." );
+    }
+    column_view result( values_ + first, digits_ + first, exponents_ + first,
+        count );
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value column_view::get( std::size_t index ) const
+{
+    if ( index >= count_ )
+    {
+        throw std::out_of_range( "Error! Index is outside of column_view." );
+    }
+    const unsigned int digits = digits_[ index ];
+    const int exponent = exponents_[ index ];
+    calculated_value result = helper::make_calculated( values_[ index ], digits, exponent );
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+
+static std::pmr::memory_resource * validate_resource( std::pmr::memory_resource * resource )
+{
+    if ( nullptr == resource )
+    {
+        throw std::invalid_argument( "Error! Memory resource may not be null." );
+    }
+    return resource;
+}
+
+// ----------------------------------------------------------------------------
+
+significant_column::significant_column() :
+    values_(),
+    digits_(),
+    exponents_()
+{
+}
+
+// ----------------------------------------------------------------------------
+
+significant_column::significant_column( std::pmr::memory_resource * resource ) :
+    values_( validate_resource( resource ) ),
+    digits_( resource ),
+    exponents_( resource )
+{
+}
+
+// ----------------------------------------------------------------------------
+
+significant_column::significant_column( const column_view & that ) :
+    values_( that.get_values(), that.get_values() + that.size() ),
+    digits_( that.get_digit_counts(), that.get_digit_counts() + that.size() ),
+    exponents_( that.get_most_sigdig_exponents(),
+        that.get_most_sigdig_exponents() + that.size() )
+{
+}
+
+// ----------------------------------------------------------------------------
+
+significant_column::significant_column( const column_view & that,
+    std::pmr::memory_resource * resource ) :
+    values_( that.get_values(), that.get_values() + that.size(),
+        validate_resource( resource ) ),
+    digits_( that.get_digit_counts(), that.get_digit_counts() + that.size(),
+        resource ),
+    exponents_( that.get_most_sigdig_exponents(),
+        that.get_most_sigdig_exponents() + that.size(), resource )
+{
+}
+
+// ----------------------------------------------------------------------------
+
+void significant_column::reserve( std::size_t count )
+{
+    values_.reserve( count );
+    digits_.reserve( count );
+    exponents_.reserve( count );
+}
+
+// ----------------------------------------------------------------------------
+
+void significant_column::resize( std::size_t count )
+{
+    values_.resize( count, 0.0L );
+    digits_.resize( count, 1 );
+    exponents_.resize( count, 0 );
+}
+
+// ----------------------------------------------------------------------------
+
+void significant_column::clear()
+{
+    values_.clear();
+    digits_.clear();
+    exponents_.clear();
+}
+
+// ----------------------------------------------------------------------------
+
+void significant_column::push_back( const significant_value & value )
+{
+    push_back( value.get_exact_value(), value.get_digit_count(),
+        value.get_most_sigdig_exponent() );
+}
+
+// ----------------------------------------------------------------------------
+
+void significant_column::push_back( long double value, unsigned int digits,
+    int exponent )
+{
+    assert( 1 <= digits );
+    assert( digits <= helper::max_range_of_digits_for_long_double );
+    values_.push_back( value );
+    digits_.push_back( digits );
+    exponents_.push_back( exponent );
+}
+
+// ----------------------------------------------------------------------------
+
+void significant_column::set( std::size_t index, long double value,
+    unsigned int digits, int exponent )
+{
+    assert( 1 <= digits );
+    assert( digits <= helper::max_range_of_digits_for_long_double );
+    values_.at( index ) = value;
+    digits_[ index ] = digits;
+    exponents_[ index ] = exponent;
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value significant_column::get( std::size_t index ) const
+{
+    return view().get( index );
+}
+
+// ----------------------------------------------------------------------------
+
+column_view significant_column::view() const
+{
+    column_view result( values_.data(), digits_.data(), exponents_.data(),
+        values_.size() );
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
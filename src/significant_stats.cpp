@@ -0,0 +1,217 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#include "significant_stats.hpp"
+
+#include <cmath>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "helper.hpp"
+#include "lookup.hpp"
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+significant_stats::significant_stats() :
+    count_( 0 ),
+    mean_( 0.0L ),
+    squared_distance_( 0.0L ),
+    least_sigdig_exponent_( 0 ),
+    min_digits_( 0 ),
+    min_value_( 0.0L ),
+    min_value_digits_( 0 ),
+    min_value_exponent_( 0 ),
+    max_value_( 0.0L ),
+    max_value_digits_( 0 ),
+    max_value_exponent_( 0 )
+{
+}
+
+// ----------------------------------------------------------------------------
+
+void significant_stats::add( const significant_value & value )
+{
+    add( value.get_exact_value(), value.get_digit_count(),
+        value.get_most_sigdig_exponent() );
+}
+
+// ----------------------------------------------------------------------------
+
+void significant_stats::add( long double value, unsigned int digits,
+    int most_sigdig_exponent )
+{
+    const int least_sigdig_exponent = most_sigdig_exponent - static_cast< int >( digits ) + 1;
+    ++count_;
+    const long double distance = value - mean_;
+    mean_ += distance / static_cast< long double >( count_ );
+    squared_distance_ += distance * ( value - mean_ );
+    if ( count_ == 1 )
+    {
+        least_sigdig_exponent_ = least_sigdig_exponent;
+        min_digits_ = digits;
+        min_value_ = max_value_ = value;
+        min_value_digits_ = max_value_digits_ = digits;
+        min_value_exponent_ = max_value_exponent_ = most_sigdig_exponent;
+        return;
+    }
+    least_sigdig_exponent_ = std::max( least_sigdig_exponent_, least_sigdig_exponent );
+    min_digits_ = std::min( min_digits_, digits );
+    if ( value < min_value_ )
+    {
+        min_value_ = value;
+        min_value_digits_ = digits;
+        min_value_exponent_ = most_sigdig_exponent;
+    }
+    if ( max_value_ < value )
+    {
+        max_value_ = value;
+        max_value_digits_ = digits;
+        max_value_exponent_ = most_sigdig_exponent;
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void significant_stats::add( const column_view & column )
+{
+    for ( std::size_t ii = 0; ii < column.size(); ++ii )
+    {
+        add( column.get_exact_value( ii ), column.get_digit_count( ii ),
+            column.get_most_sigdig_exponent( ii ) );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void significant_stats::merge( const significant_stats & that )
+{
+    if ( that.count_ == 0 )
+    {
+        return;
+    }
+    if ( count_ == 0 )
+    {
+        *this = that;
+        return;
+    }
+    const long double this_count = static_cast< long double >( count_ );
+    const long double that_count = static_cast< long double >( that.count_ );
+    const long double total = this_count + that_count;
+    const long double distance = that.mean_ - mean_;
+    mean_ += distance * that_count / total;
+    squared_distance_ += that.squared_distance_ +
+        distance * distance * this_count * that_count / total;
+    count_ += that.count_;
+    least_sigdig_exponent_ = std::max( least_sigdig_exponent_, that.least_sigdig_exponent_ );
+    min_digits_ = std::min( min_digits_, that.min_digits_ );
+    if ( that.min_value_ < min_value_ )
+    {
+        min_value_ = that.min_value_;
+        min_value_digits_ = that.min_value_digits_;
+        min_value_exponent_ = that.min_value_exponent_;
+    }
+    if ( max_value_ < that.max_value_ )
+    {
+        max_value_ = that.max_value_;
+        max_value_digits_ = that.max_value_digits_;
+        max_value_exponent_ = that.max_value_exponent_;
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void significant_stats::clear()
+{
+    *this = significant_stats();
+}
+
+// ----------------------------------------------------------------------------
+
+void significant_stats::validate_count( std::size_t needed ) const
+{
+    if ( count_ < needed )
+    {
+        throw std::domain_error( "Error! Not enough samples to calculate statistic." );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+unsigned int significant_stats::calculate_mean_digits() const
+{
+    int exponent = 0;
+    const long double sum = mean_ * static_cast< long double >( count_ );
+    return helper::calculate_sum_digits( sum, least_sigdig_exponent_, exponent );
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value significant_stats::get_sum() const
+{
+    validate_count( 1 );
+    const long double sum = mean_ * static_cast< long double >( count_ );
+    int exponent = 0;
+    const unsigned int digits =
+        helper::calculate_sum_digits( sum, least_sigdig_exponent_, exponent );
+    return helper::make_calculated( sum, digits, exponent );
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value significant_stats::get_mean() const
+{
+    validate_count( 1 );
+    const unsigned int digits = calculate_mean_digits();
+    const int exponent = lookup::calculate_exponent( mean_ );
+    return helper::make_calculated( mean_, digits, exponent );
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value significant_stats::get_minimum() const
+{
+    validate_count( 1 );
+    return helper::make_calculated( min_value_, min_value_digits_, min_value_exponent_ );
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value significant_stats::get_maximum() const
+{
+    validate_count( 1 );
+    return helper::make_calculated( max_value_, max_value_digits_, max_value_exponent_ );
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value significant_stats::get_variance() const
+{
+    validate_count( 2 );
+    const long double variance = std::max( 0.0L,
+        squared_distance_ / static_cast< long double >( count_ - 1 ) );
+    const unsigned int digits = std::min( min_digits_, calculate_mean_digits() );
+    const int exponent = lookup::calculate_exponent( variance );
+    return helper::make_calculated( variance, digits, exponent );
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value significant_stats::get_standard_deviation() const
+{
+    validate_count( 2 );
+    const long double deviation = std::sqrt( std::max( 0.0L,
+        squared_distance_ / static_cast< long double >( count_ - 1 ) ) );
+    const unsigned int digits = std::min( min_digits_, calculate_mean_digits() );
+    const int exponent = lookup::calculate_exponent( deviation );
+    return helper::make_calculated( deviation, digits, exponent );
+}
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
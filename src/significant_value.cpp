@@ -19,6 +19,7 @@
 #include "lookup.hpp"
 #include "calculated_value.hpp"
 #include "defined_value.hpp"
+#include "telemetry.hpp"
 
 namespace sigdig {
 
@@ -47,6 +48,17 @@ significant_value::significant_value( long double value,
 
 // ----------------------------------------------------------------------------
 
+significant_value::significant_value( long double value, deferred_metadata ) :
+    value_( helper::validate_input_value( value ) ),
+    digits_( 0 ),
+    most_sigdig_exponent_( 0 ),
+    least_sigdig_exponent_( 0 )
+{
+    assert( is_sane() );
+}
+
+// ----------------------------------------------------------------------------
+
 significant_value::significant_value( long value ) :
     value_( static_cast< long double >( value ) ),
     digits_( utility::count_significant_digits( value ) ),
@@ -92,6 +104,100 @@ significant_value::significant_value( unsigned long value,
 
 // ----------------------------------------------------------------------------
 
+significant_value::significant_value( long long value ) :
+    value_( static_cast< long double >( value ) ),
+    digits_( utility::count_significant_digits( value ) ),
+    most_sigdig_exponent_( utility::calculate_exponent( value ) ),
+    least_sigdig_exponent_( most_sigdig_exponent_ - digits_ + 1 )
+{
+    assert( is_sane() );
+}
+
+// ----------------------------------------------------------------------------
+
+significant_value::significant_value( long long value, unsigned int digits ) :
+    value_( static_cast< long double >( value ) ),
+    digits_( helper::validate_digit_count( digits ) ),
+    most_sigdig_exponent_( utility::calculate_exponent( value ) ),
+    least_sigdig_exponent_( most_sigdig_exponent_ - digits_ + 1 )
+{
+    assert( is_sane() );
+}
+
+// ----------------------------------------------------------------------------
+
+significant_value::significant_value( unsigned long long value ) :
+    value_( static_cast< long double >( value ) ),
+    digits_( utility::count_significant_digits( value ) ),
+    most_sigdig_exponent_( utility::calculate_exponent( value ) ),
+    least_sigdig_exponent_( most_sigdig_exponent_ - digits_ + 1 )
+{
+    assert( is_sane() );
+}
+
+// ----------------------------------------------------------------------------
+
+significant_value::significant_value( unsigned long long value, unsigned int digits ) :
+    value_( static_cast< long double >( value ) ),
+    digits_( helper::validate_digit_count( digits ) ),
+    most_sigdig_exponent_( utility::calculate_exponent( value ) ),
+    least_sigdig_exponent_( most_sigdig_exponent_ - digits_ + 1 )
+{
+    assert( is_sane() );
+}
+
+// ----------------------------------------------------------------------------
+
+#ifdef __SIZEOF_INT128__
+
+significant_value::significant_value( __int128 value ) :
+    value_( static_cast< long double >( value ) ),
+    digits_( helper::cap_digit_count( utility::count_significant_digits( value ) ) ),
+    most_sigdig_exponent_( utility::calculate_exponent( value ) ),
+    least_sigdig_exponent_( most_sigdig_exponent_ - digits_ + 1 )
+{
+    assert( is_sane() );
+}
+
+// ----------------------------------------------------------------------------
+
+significant_value::significant_value( __int128 value, unsigned int digits ) :
+    value_( static_cast< long double >( value ) ),
+    digits_( helper::validate_digit_count( digits ) ),
+    most_sigdig_exponent_( utility::calculate_exponent( value ) ),
+    least_sigdig_exponent_( most_sigdig_exponent_ - digits_ + 1 )
+{
+    assert( is_sane() );
+}
+
+// ----------------------------------------------------------------------------
+
+significant_value::significant_value( unsigned __int128 value ) :
+    value_( static_cast< long double >( value ) ),
+    digits_( helper::cap_digit_count( utility::count_significant_digits( value ) ) ),
+    most_sigdig_exponent_( utility::calculate_exponent( value ) ),
+    least_sigdig_exponent_( most_sigdig_exponent_ - digits_ + 1 )
+{
+    assert( is_sane() );
+}
+
+// ----------------------------------------------------------------------------
+
+significant_value::significant_value( unsigned __int128 value, unsigned int digits ) :
+    value_( static_cast< long double >( value ) ),
+    digits_( helper::validate_digit_count( digits ) ),
+    most_sigdig_exponent_( utility::calculate_exponent( value ) ),
+    least_sigdig_exponent_( most_sigdig_exponent_ - digits_ + 1 )
+{
+    assert( is_sane() );
+}
+
+// ----------------------------------------------------------------------------
+
+#endif
+
+// ----------------------------------------------------------------------------
+
 significant_value::significant_value( const char * value ) :
     value_( 0.0L ),
     digits_( 0 ),
@@ -144,17 +250,6 @@ significant_value::significant_value( const std::string & value,
 
 // ----------------------------------------------------------------------------
 
-significant_value::significant_value( const significant_value & that ) :
-    value_ ( that.value_ ),
-    digits_( that.digits_ ),
-    most_sigdig_exponent_( that.most_sigdig_exponent_ ),
-    least_sigdig_exponent_( that.least_sigdig_exponent_ )
-{
-    assert( is_sane() );
-}
-
-// ----------------------------------------------------------------------------
-
 significant_value::significant_value( long double value, unsigned int digits,
     int exponent, int least_sigdig_exponent ) :
     value_( value ),
@@ -171,13 +266,6 @@ significant_value::significant_value( long double value, unsigned int digits,
 
 // ----------------------------------------------------------------------------
 
-significant_value::~significant_value()
-{
-    assert( is_sane() );
-}
-
-// ----------------------------------------------------------------------------
-
 void significant_value::assign( long double value )
 {
     assert( is_sane() );
@@ -211,6 +299,18 @@ void significant_value::assign( long double value, unsigned int digits )
 
 // ----------------------------------------------------------------------------
 
+void significant_value::assign( long double value, deferred_metadata )
+{
+    assert( is_sane() );
+    value_ = helper::validate_input_value( value );
+    digits_ = 0;
+    most_sigdig_exponent_ = 0;
+    least_sigdig_exponent_ = 0;
+    assert( is_sane() );
+}
+
+// ----------------------------------------------------------------------------
+
 void significant_value::assign( long value )
 {
     assert( is_sane() );
@@ -356,7 +456,7 @@ bool significant_value::equals( long double value, unsigned int digits ) const
     helper::validate_input_value( value, digits );
     assert( is_sane() );
     const int below_least_sigdig_exponent =
-        most_sigdig_exponent_ - static_cast< int >( digits );
+        get_most_sigdig_exponent() - static_cast< int >( digits );
     const long double tolerance =
         lookup::lookup_tolerance( below_least_sigdig_exponent );
     const long double lower_end = value_ - tolerance;
@@ -377,9 +477,9 @@ bool significant_value::equals( const significant_value & that ) const
     assert( is_sane() );
     assert( that.is_sane() );
     const long double this_tolerance =
-        lookup::lookup_tolerance( least_sigdig_exponent_ - 1 );
+        lookup::lookup_tolerance( get_least_sigdig_exponent() - 1 );
     const long double that_tolerance =
-        lookup::lookup_tolerance( that.least_sigdig_exponent_ - 1 );
+        lookup::lookup_tolerance( that.get_least_sigdig_exponent() - 1 );
     const long double this_upper_end = value_ + this_tolerance;
     const long double that_lower_end = that.value_ - that_tolerance;
     const bool that_is_more_than = this_upper_end < that_lower_end;
@@ -400,7 +500,7 @@ bool significant_value::equals( const defined_value & that ) const
     // No need to call is_sane since this calls another equals function that
     // checks for sanity.
     const long double value = that.get_value();
-    const bool is_equal = equals( value, digits_ );
+    const bool is_equal = equals( value, get_digit_count() );
     return is_equal;
 }
 
@@ -425,7 +525,7 @@ bool significant_value::less_than( long double value,
     helper::validate_input_value( value, digits );
     assert( is_sane() );
     const int below_least_sigdig_exponent =
-        most_sigdig_exponent_ - static_cast< int >( digits );
+        get_most_sigdig_exponent() - static_cast< int >( digits );
     const long double tolerance =
         lookup::lookup_tolerance( below_least_sigdig_exponent );
     const long double upper_end = value_ + tolerance;
@@ -445,9 +545,9 @@ bool significant_value::less_than( const significant_value & that ) const
     assert( is_sane() );
     assert( that.is_sane() );
     const long double this_tolerance =
-        lookup::lookup_tolerance( least_sigdig_exponent_ - 1 );
+        lookup::lookup_tolerance( get_least_sigdig_exponent() - 1 );
     const long double that_tolerance =
-        lookup::lookup_tolerance( that.least_sigdig_exponent_ - 1 );
+        lookup::lookup_tolerance( that.get_least_sigdig_exponent() - 1 );
     const long double this_upper_end = value_ + this_tolerance;
     const long double that_upper_end = that.value_ - that_tolerance;
     const bool this_is_less_than = this_upper_end < that_upper_end;
@@ -461,7 +561,7 @@ bool significant_value::less_than( const defined_value & that ) const
     // No need to call is_sane since this calls another less_than function that
     // checks for sanity.
     const long double value = that.get_value();
-    const bool is_less_than = less_than( value, digits_ );
+    const bool is_less_than = less_than( value, get_digit_count() );
     return is_less_than;
 }
 
@@ -486,7 +586,7 @@ bool significant_value::greater_than( long double value,
     helper::validate_input_value( value, digits );
     assert( is_sane() );
     const int below_least_sigdig_exponent =
-        most_sigdig_exponent_ - static_cast< int >( digits );
+        get_most_sigdig_exponent() - static_cast< int >( digits );
     const long double tolerance =
         lookup::lookup_tolerance( below_least_sigdig_exponent );
     const long double lower_end = value_ - tolerance;
@@ -501,9 +601,9 @@ bool significant_value::greater_than( const significant_value & that ) const
     assert( is_sane() );
     assert( that.is_sane() );
     const long double this_tolerance =
-        lookup::lookup_tolerance( least_sigdig_exponent_ -  1 );
+        lookup::lookup_tolerance( get_least_sigdig_exponent() -  1 );
     const long double that_tolerance =
-        lookup::lookup_tolerance( that.least_sigdig_exponent_ - 1 );
+        lookup::lookup_tolerance( that.get_least_sigdig_exponent() - 1 );
     const long double this_lower_end = value_ - this_tolerance;
     const long double that_upper_end = that.value_ + that_tolerance;
     const bool this_is_more_than = that_upper_end < this_lower_end;
@@ -517,7 +617,7 @@ bool significant_value::greater_than( const defined_value & that ) const
     // No need to call is_sane since this calls another greater_than function
     // that checks for sanity.
     const long double value = that.get_value();
-    const bool is_more_than = greater_than( value, digits_ );
+    const bool is_more_than = greater_than( value, get_digit_count() );
     return is_more_than;
 }
 
@@ -527,7 +627,7 @@ calculated_value significant_value::remainder(
     const significant_value & divisor ) const
 {
     assert( is_sane() );
-    const unsigned int digits = std::min( divisor.get_digit_count(), digits_ );
+    const unsigned int digits = std::min( divisor.get_digit_count(), get_digit_count() );
     const long double v = std::remainder( value_, digits );
     calculated_value result( v, divisor.get_digit_count() );
     return result;
@@ -540,7 +640,7 @@ calculated_value significant_value::remainder(
 {
     assert( is_sane() );
     const long double v = std::remainder( value_, divisor.get_value() );
-    calculated_value result( v, digits_ );
+    calculated_value result( v, get_digit_count() );
     return result;
 }
 
@@ -550,7 +650,8 @@ calculated_value significant_value::operator / (
     const significant_value & divisor ) const
 {
     assert( is_sane() );
-    const unsigned int digits = std::min( digits_, divisor.get_digit_count() );
+    const unsigned int digits = std::min( get_digit_count(), divisor.get_digit_count() );
+    SIGDIG_RECORD_DIGITS( divide, std::max( get_digit_count(), divisor.get_digit_count() ), digits );
     calculated_value quotient( value_ / divisor.get_exact_value(), digits );
     return quotient;
 }
@@ -559,9 +660,17 @@ calculated_value significant_value::operator / (
 
 calculated_value significant_value::operator / (
     const defined_value & divisor ) const
+{
+    return operator / ( divisor.get_value() );
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value significant_value::operator / ( long double divisor ) const
 {
     assert( is_sane() );
-    calculated_value quotient( value_ / divisor.get_value(), digits_ );
+    helper::validate_input_value( divisor );
+    calculated_value quotient( value_ / divisor, get_digit_count() );
     return quotient;
 }
 
@@ -571,7 +680,8 @@ calculated_value significant_value::operator * (
     const significant_value & factor ) const
 {
     assert( is_sane() );
-    const unsigned int digits = std::min( digits_, factor.get_digit_count() );
+    const unsigned int digits = std::min( get_digit_count(), factor.get_digit_count() );
+    SIGDIG_RECORD_DIGITS( multiply, std::max( get_digit_count(), factor.get_digit_count() ), digits );
     calculated_value product( value_ * factor.get_exact_value(), digits );
     return product;
 }
@@ -580,9 +690,17 @@ calculated_value significant_value::operator * (
 
 calculated_value significant_value::operator * (
     const defined_value & factor ) const
+{
+    return operator * ( factor.get_value() );
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value significant_value::operator * ( long double factor ) const
 {
     assert( is_sane() );
-    calculated_value product( value_ * factor.get_value(), digits_ );
+    helper::validate_input_value( factor );
+    calculated_value product( value_ * factor, get_digit_count() );
     return product;
 }
 
@@ -592,13 +710,26 @@ calculated_value significant_value::operator - (
     const significant_value & subtrahend ) const
 {
     assert( is_sane() );
+    if ( get_least_sigdig_exponent() == subtrahend.get_least_sigdig_exponent() )
+    {
+        long double difference = 0.0L;
+        unsigned int digits = 0;
+        int exponent = 0;
+        if ( helper::add_scaled_integers( value_, subtrahend.get_exact_value(), true,
+            get_least_sigdig_exponent(), difference, digits, exponent ) )
+        {
+            SIGDIG_RECORD_DIGITS( subtract, std::max( get_digit_count(), subtrahend.get_digit_count() ), digits );
+            return helper::make_calculated( difference, digits, exponent );
+        }
+    }
     const long double difference = value_ - subtrahend.get_exact_value();
     const int highest_least_sigdig = std::max(
-        least_sigdig_exponent_, subtrahend.get_least_sigdig_exponent() );
-    const int exponent = lookup::calculate_exponent( difference );
-    const int digits = exponent - highest_least_sigdig + 1;
-    calculated_value result(
-        difference, digits, exponent, highest_least_sigdig );
+        get_least_sigdig_exponent(), subtrahend.get_least_sigdig_exponent() );
+    int exponent = 0;
+    const unsigned int digits = helper::calculate_sum_digits( difference, highest_least_sigdig, exponent );
+    SIGDIG_RECORD_DIGITS( subtract, std::max( get_digit_count(), subtrahend.get_digit_count() ), digits );
+    calculated_value result = helper::make_calculated(
+        difference, digits, exponent );
     return result;
 }
 
@@ -606,13 +737,22 @@ calculated_value significant_value::operator - (
 
 calculated_value significant_value::operator - (
     const defined_value & subtrahend ) const
+{
+    return operator - ( subtrahend.get_value() );
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value significant_value::operator - ( long double subtrahend ) const
 {
     assert( is_sane() );
-    const long double difference = value_ - subtrahend.get_value();
-    const int exponent = lookup::calculate_exponent( difference );
-    const int digits = exponent - least_sigdig_exponent_ + 1;
-    calculated_value result(
-        difference, digits, exponent, least_sigdig_exponent_ );
+    helper::validate_input_value( subtrahend );
+    const long double difference = value_ - subtrahend;
+    int exponent = 0;
+    const unsigned int digits = helper::calculate_sum_digits( difference, get_least_sigdig_exponent(), exponent );
+    SIGDIG_RECORD_DIGITS( subtract, get_digit_count(), digits );
+    calculated_value result = helper::make_calculated(
+        difference, digits, exponent );
     return result;
 }
 
@@ -622,12 +762,25 @@ calculated_value significant_value::operator + (
     const significant_value & addend ) const
 {
     assert( is_sane() );
+    if ( get_least_sigdig_exponent() == addend.get_least_sigdig_exponent() )
+    {
+        long double sum = 0.0L;
+        unsigned int digits = 0;
+        int exponent = 0;
+        if ( helper::add_scaled_integers( value_, addend.get_exact_value(), false,
+            get_least_sigdig_exponent(), sum, digits, exponent ) )
+        {
+            SIGDIG_RECORD_DIGITS( add, std::max( get_digit_count(), addend.get_digit_count() ), digits );
+            return helper::make_calculated( sum, digits, exponent );
+        }
+    }
     const long double sum = value_ + addend.get_exact_value();
     const int highest_least_sigdig =
-        std::max( least_sigdig_exponent_, addend.get_least_sigdig_exponent() );
-    const int exponent = lookup::calculate_exponent( sum );
-    const int digits = exponent - highest_least_sigdig + 1;
-    calculated_value result( sum, digits, exponent, highest_least_sigdig );
+        std::max( get_least_sigdig_exponent(), addend.get_least_sigdig_exponent() );
+    int exponent = 0;
+    const unsigned int digits = helper::calculate_sum_digits( sum, highest_least_sigdig, exponent );
+    SIGDIG_RECORD_DIGITS( add, std::max( get_digit_count(), addend.get_digit_count() ), digits );
+    calculated_value result = helper::make_calculated( sum, digits, exponent );
     return result;
 }
 
@@ -635,12 +788,21 @@ calculated_value significant_value::operator + (
 
 calculated_value significant_value::operator + (
     const defined_value & addend ) const
+{
+    return operator + ( addend.get_value() );
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value significant_value::operator + ( long double addend ) const
 {
     assert( is_sane() );
-    const long double sum = value_ + addend.get_value();
-    const int exponent = lookup::calculate_exponent( sum );
-    const int digits = exponent - least_sigdig_exponent_ + 1;
-    calculated_value result( sum, digits, exponent, least_sigdig_exponent_ );
+    helper::validate_input_value( addend );
+    const long double sum = value_ + addend;
+    int exponent = 0;
+    const unsigned int digits = helper::calculate_sum_digits( sum, get_least_sigdig_exponent(), exponent );
+    SIGDIG_RECORD_DIGITS( add, get_digit_count(), digits );
+    calculated_value result = helper::make_calculated( sum, digits, exponent );
     return result;
 }
 
@@ -656,7 +818,7 @@ calculated_value significant_value::to_power_of(
             "Error. Cannot calculate power of negative numbers where absolute value of power is less than 1.0" ); 
     }
     const long double v = std::pow( value_, exponent.get_value() );
-    calculated_value result( v, digits_ );
+    calculated_value result( v, get_digit_count() );
     return result;
 }
 
@@ -674,7 +836,7 @@ calculated_value significant_value::to_power_of(
     }
     const long double v = std::pow( value_, exponent.get_exact_value() );
     const unsigned int digits =
-        std::min( digits_, exponent.get_digit_count() );
+        std::min( get_digit_count(), exponent.get_digit_count() );
     calculated_value result( v, digits );
     return result;
 }
@@ -685,11 +847,8 @@ long double significant_value::get_value( int digits,
     rounding_style rounding ) const
 {
     assert( is_sane() );
-    const std::string result =
-        to_string( digits, format_style::decimal_fixed, rounding );
-    char * place = nullptr;
-    const long double value = std::strtold( result.c_str(), &place );
-    return value;
+    helper::validate_digit_count( digits );
+    return helper::round_to_digits( value_, get_most_sigdig_exponent(), digits, rounding );
 }
 
 // ----------------------------------------------------------------------------
@@ -698,8 +857,8 @@ std::string significant_value::to_string( format_style formatting,
     rounding_style rounding, bool show_decimal ) const
 {
     assert( is_sane() );
-    std::string result = helper::to_string( value_, most_sigdig_exponent_,
-        digits_, formatting, rounding, show_decimal );
+    std::string result = helper::to_string( value_, get_most_sigdig_exponent(),
+        get_digit_count(), formatting, rounding, show_decimal );
     return result;
 }
 
@@ -710,18 +869,67 @@ std::string significant_value::to_string( unsigned int digits,
 {
     assert( is_sane() );
     helper::validate_digit_count( digits );
-    std::string result = helper::to_string( value_, most_sigdig_exponent_,
+    std::string result = helper::to_string( value_, get_most_sigdig_exponent(),
         digits, formatting, rounding, show_decimal );
     return result;
 }
 
 // ----------------------------------------------------------------------------
 
+std::pmr::string significant_value::to_string( std::pmr::memory_resource * resource,
+    format_style formatting, rounding_style rounding, bool show_decimal ) const
+{
+    assert( is_sane() );
+    return helper::to_string( resource, value_, get_most_sigdig_exponent(),
+        get_digit_count(), formatting, rounding, show_decimal );
+}
+
+// ----------------------------------------------------------------------------
+
+std::pmr::string significant_value::to_string( std::pmr::memory_resource * resource,
+    unsigned int digits, format_style formatting, rounding_style rounding,
+    bool show_decimal ) const
+{
+    assert( is_sane() );
+    helper::validate_digit_count( digits );
+    return helper::to_string( resource, value_, get_most_sigdig_exponent(),
+        digits, formatting, rounding, show_decimal );
+}
+
+// ----------------------------------------------------------------------------
+
+template < format_style Formatting, rounding_style Rounding >
+std::string significant_value::to_string( unsigned int digits, bool show_decimal ) const
+{
+    assert( is_sane() );
+    helper::validate_digit_count( digits );
+    return helper::to_string< Formatting, Rounding >( value_, get_most_sigdig_exponent(),
+        digits, show_decimal );
+}
+
+template std::string significant_value::to_string< decimal_fixed, truncate >( unsigned int, bool ) const;
+template std::string significant_value::to_string< decimal_fixed, floor >( unsigned int, bool ) const;
+template std::string significant_value::to_string< decimal_fixed, round_half >( unsigned int, bool ) const;
+template std::string significant_value::to_string< decimal_fixed, ceiling >( unsigned int, bool ) const;
+template std::string significant_value::to_string< decimal_fixed, from_zero >( unsigned int, bool ) const;
+template std::string significant_value::to_string< decimal_exponent, truncate >( unsigned int, bool ) const;
+template std::string significant_value::to_string< decimal_exponent, floor >( unsigned int, bool ) const;
+template std::string significant_value::to_string< decimal_exponent, round_half >( unsigned int, bool ) const;
+template std::string significant_value::to_string< decimal_exponent, ceiling >( unsigned int, bool ) const;
+template std::string significant_value::to_string< decimal_exponent, from_zero >( unsigned int, bool ) const;
+template std::string significant_value::to_string< hexadecimal_exponent, truncate >( unsigned int, bool ) const;
+template std::string significant_value::to_string< hexadecimal_exponent, floor >( unsigned int, bool ) const;
+template std::string significant_value::to_string< hexadecimal_exponent, round_half >( unsigned int, bool ) const;
+template std::string significant_value::to_string< hexadecimal_exponent, ceiling >( unsigned int, bool ) const;
+template std::string significant_value::to_string< hexadecimal_exponent, from_zero >( unsigned int, bool ) const;
+
+// ----------------------------------------------------------------------------
+
 long double significant_value::get_tolerance() const
 {
     assert( is_sane() );
     const long double tolerance =
-        lookup::lookup_tolerance( least_sigdig_exponent_ - 1 );
+        lookup::lookup_tolerance( get_least_sigdig_exponent() - 1 );
     return tolerance;
 }
 
@@ -759,6 +967,26 @@ void significant_value::swap( significant_value & that )
 
 // ----------------------------------------------------------------------------
 
+void significant_value::calculate_metadata()
+{
+    assert( digits_ == 0 );
+    most_sigdig_exponent_ = lookup::calculate_exponent( value_ );
+    digits_ = utility::count_significant_digits( value_ );
+    least_sigdig_exponent_ = most_sigdig_exponent_ - digits_ + 1;
+    assert( is_sane() );
+}
+
+// ----------------------------------------------------------------------------
+
+significant_value significant_value::get_resolved() const
+{
+    significant_value resolved( *this );
+    resolved.resolve_metadata();
+    return resolved;
+}
+
+// ----------------------------------------------------------------------------
+
 bool significant_value::is_sane() const
 {
     assert( this != nullptr );
@@ -766,6 +994,13 @@ bool significant_value::is_sane() const
     assert( number_type != FP_INFINITE );
     assert( number_type != FP_NAN );
     assert( number_type != FP_SUBNORMAL );
+    if ( digits_ == 0 )
+    {
+        // The digits and exponents were deferred and are not calculated yet.
+        assert( most_sigdig_exponent_ == 0 );
+        assert( least_sigdig_exponent_ == 0 );
+        return true;
+    }
     assert( most_sigdig_exponent_ >= least_sigdig_exponent_ );
     assert( most_sigdig_exponent_ >= helper::lowest_exponent );
     assert( most_sigdig_exponent_ <= helper::highest_exponent );
@@ -787,4 +1022,44 @@ std::ostream & operator << ( std::ostream & os, const significant_value & value
 
 // ----------------------------------------------------------------------------
 
+calculated_value operator / ( long double dividend, const significant_value & divisor )
+{
+    helper::validate_input_value( dividend );
+    if ( divisor.get_exact_value() == 0.0L )
+    {
+        throw std::invalid_argument( "Division by zero error in operator /" );
+    }
+    calculated_value result( dividend / divisor.get_exact_value(), divisor.get_digit_count() );
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value operator * ( long double multiplier, const significant_value & factor )
+{
+    helper::validate_input_value( multiplier );
+    calculated_value result( multiplier * factor.get_exact_value(), factor.get_digit_count() );
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value operator - ( long double minuend, const significant_value & subtrahend )
+{
+    helper::validate_input_value( minuend );
+    calculated_value result( minuend - subtrahend.get_exact_value(), subtrahend.get_digit_count() );
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value operator + ( long double augend, const significant_value & addend )
+{
+    helper::validate_input_value( augend );
+    calculated_value result( augend + addend.get_exact_value(), addend.get_digit_count() );
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+
 } // end namespace
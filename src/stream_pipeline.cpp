@@ -0,0 +1,412 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#include "stream_pipeline.hpp"
+
+#include <cctype>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "measured_value.hpp"
+
+namespace sigdig {
+
+namespace {
+
+// ----------------------------------------------------------------------------
+
+/** @class block_queue A bounded queue for exactly one producer thread and one
+ consumer thread. Items are swapped in and out instead of copied, so the
+ producer gets back a block the consumer is done with, and can reuse its memory.
+ */
+
+template < typename T >
+class block_queue
+{
+public:
+
+    explicit block_queue( std::size_t capacity ) :
+        slots_( capacity + 1 ),
+        head_( 0 ),
+        tail_( 0 )
+    {
+    }
+
+    block_queue( const block_queue & ) = delete;
+
+    block_queue & operator = ( const block_queue & ) = delete;
+
+    /// Swaps item into the queue, and returns false if the queue is full.
+    bool try_push( T & item )
+    {
+        const std::size_t tail = tail_.load( std::memory_order_relaxed );
+        const std::size_t next = ( tail + 1 == slots_.size() ) ? 0 : tail + 1;
+        if ( next == head_.load( std::memory_order_acquire ) )
+        {
+            return false;
+        }
+        std::swap( slots_[ tail ], item );
+        tail_.store( next, std::memory_order_release );
+        return true;
+    }
+
+    /// Swaps the oldest item out of the queue, and returns false if the queue is empty.
+    bool try_pop( T & item )
+    {
+        const std::size_t head = head_.load( std::memory_order_relaxed );
+        if ( head == tail_.load( std::memory_order_acquire ) )
+        {
+            return false;
+        }
+        std::swap( item, slots_[ head ] );
+        const std::size_t next = ( head + 1 == slots_.size() ) ? 0 : head + 1;
+        head_.store( next, std::memory_order_release );
+        return true;
+    }
+
+private:
+
+    std::vector< T > slots_;
+    // Keep the indexes on separate cache lines so the two threads do not share one.
+    alignas( 64 ) std::atomic< std::size_t > head_;
+    alignas( 64 ) std::atomic< std::size_t > tail_;
+
+};
+
+// ----------------------------------------------------------------------------
+
+/// A block of values passed between stages. The last block has no values.
+struct pipeline_block
+{
+    pipeline_block() : values(), last( false ) {}
+
+    significant_column values;
+    bool last;
+};
+
+typedef block_queue< pipeline_block > pipeline_queue;
+
+// ----------------------------------------------------------------------------
+
+/** @class pipeline_state What the stages share besides their queues. A stage
+ that finds its queue full or empty spins briefly in case the other stage is
+ about to catch up, and then sleeps until the other stage changes a queue or
+ the pipeline stops, so a stage waiting on slow input does not use a whole core.
+ */
+class pipeline_state
+{
+public:
+
+    pipeline_state() : stopped_( false ), error_(), guard_(), wake_guard_(), wake_() {}
+
+    inline bool is_stopped() const { return stopped_.load( std::memory_order_relaxed ); }
+
+    /// Keeps the first exception thrown by any stage, and tells all the stages to stop.
+    void fail( std::exception_ptr error )
+    {
+        {
+            std::lock_guard< std::mutex > lock( guard_ );
+            if ( !error_ )
+            {
+                error_ = error;
+            }
+        }
+        stop();
+    }
+
+    void stop()
+    {
+        stopped_.store( true );
+        wake_all();
+    }
+
+    void rethrow() const
+    {
+        if ( error_ )
+        {
+            std::rethrow_exception( error_ );
+        }
+    }
+
+    /// Waits for room in the queue, and returns false if the pipeline stopped first.
+    bool push( pipeline_queue & queue, pipeline_block & block )
+    {
+        return wait_until( [ &queue, &block ]() { return queue.try_push( block ); } );
+    }
+
+    /// Waits for a block in the queue, and returns false if the pipeline stopped first.
+    bool pop( pipeline_queue & queue, pipeline_block & block )
+    {
+        return wait_until( [ &queue, &block ]() { return queue.try_pop( block ); } );
+    }
+
+private:
+
+    /// How many times a stage tries its queue before it sleeps.
+    static const unsigned int spins_before_sleeping = 64;
+
+    template < typename Attempt >
+    bool wait_until( Attempt attempt )
+    {
+        bool done = false;
+        for ( unsigned int ii = 0; !done && ( ii < spins_before_sleeping ); ++ii )
+        {
+            if ( is_stopped() )
+            {
+                return false;
+            }
+            done = attempt();
+            if ( !done )
+            {
+                std::this_thread::yield();
+            }
+        }
+        if ( !done )
+        {
+            std::unique_lock< std::mutex > lock( wake_guard_ );
+            wake_.wait( lock, [ this, &attempt, &done ]()
+            {
+                done = !is_stopped() && attempt();
+                return done || is_stopped();
+            } );
+        }
+        if ( done )
+        {
+            // Each block sent or taken may be what the other stage sleeps on.
+            wake_all();
+        }
+        return done;
+    }
+
+    void wake_all()
+    {
+        // Taking the lock means a stage can not miss this between checking its queue and sleeping.
+        {
+            std::lock_guard< std::mutex > lock( wake_guard_ );
+        }
+        wake_.notify_all();
+    }
+
+    std::atomic< bool > stopped_;
+    std::exception_ptr error_;
+    std::mutex guard_;
+    std::mutex wake_guard_;
+    std::condition_variable wake_;
+
+};
+
+// ----------------------------------------------------------------------------
+
+void parse_stage( std::istream & input, std::size_t block_size,
+    pipeline_queue & parsed, pipeline_state & state )
+{
+    // Read text in chunks and keep any partial number for the next chunk.
+    std::vector< char > chunk( 65536 );
+    std::string token;
+    pipeline_block block;
+    block.values.reserve( block_size );
+    for ( ;; )
+    {
+        input.read( chunk.data(), static_cast< std::streamsize >( chunk.size() ) );
+        const std::size_t count = static_cast< std::size_t >( input.gcount() );
+        for ( std::size_t ii = 0; ii <= count; ++ii )
+        {
+            const bool at_end = ( ii == count );
+            if ( !at_end && !std::isspace( static_cast< unsigned char >( chunk[ ii ] ) ) )
+            {
+                token.push_back( chunk[ ii ] );
+                continue;
+            }
+            if ( token.empty() || ( at_end && ( count == chunk.size() ) ) )
+            {
+                continue;
+            }
+            block.values.push_back( measured_value( token.c_str() ) );
+            token.clear();
+            if ( block.values.size() == block_size )
+            {
+                if ( !state.push( parsed, block ) )
+                {
+                    return;
+                }
+                block.values.clear();
+            }
+        }
+        if ( count < chunk.size() )
+        {
+            break;
+        }
+    }
+    if ( input.bad() )
+    {
+        throw std::runtime_error( "Error! Unable to read input for stream_pipeline." );
+    }
+    if ( !block.values.empty() )
+    {
+        if ( !state.push( parsed, block ) )
+        {
+            return;
+        }
+        block.values.clear();
+    }
+    block.last = true;
+    state.push( parsed, block );
+}
+
+// ----------------------------------------------------------------------------
+
+void compute_stage( const stream_pipeline::calculation & calculate,
+    pipeline_queue & parsed, pipeline_queue & results, pipeline_state & state )
+{
+    pipeline_block input;
+    pipeline_block output;
+    for ( ;; )
+    {
+        if ( !state.pop( parsed, input ) )
+        {
+            return;
+        }
+        output.last = input.last;
+        if ( input.last )
+        {
+            output.values.clear();
+        }
+        else
+        {
+            calculate( input.values.view(), output.values );
+        }
+        if ( !state.push( results, output ) || input.last )
+        {
+            return;
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+std::size_t format_stage( const format_spec & spec, std::ostream & output,
+    pipeline_queue & results, pipeline_state & state )
+{
+    std::size_t written = 0;
+    std::array< char, format_spec::max_length > chars;
+    std::string text;
+    pipeline_block block;
+    for ( ;; )
+    {
+        if ( !state.pop( results, block ) || block.last )
+        {
+            return written;
+        }
+        text.clear();
+        const column_view view = block.values.view();
+        for ( std::size_t ii = 0; ii < view.size(); ++ii )
+        {
+            const std::size_t size = spec.write( view.get( ii ), chars.data(), chars.size() );
+            text.append( chars.data(), size );
+            text.push_back( '\n' );
+        }
+        output.write( text.data(), static_cast< std::streamsize >( text.size() ) );
+        if ( !output )
+        {
+            throw std::runtime_error( "Error! Unable to write output for stream_pipeline." );
+        }
+        written += view.size();
+    }
+}
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+
+stream_pipeline::stream_pipeline( const calculation & calculate,
+    const format_spec & spec, std::size_t block_size, std::size_t queue_depth ) :
+    calculate_( calculate ),
+    spec_( spec ),
+    block_size_( block_size ),
+    queue_depth_( queue_depth )
+{
+    if ( !calculate_ )
+    {
+        throw std::invalid_argument( "Error! stream_pipeline needs a calculation." );
+    }
+    if ( ( block_size_ == 0 ) || ( queue_depth_ == 0 ) )
+    {
+        throw std::invalid_argument(
+            "Error! Block size and queue depth of stream_pipeline must not be zero." );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+std::size_t stream_pipeline::run( std::istream & input, std::ostream & output ) const
+{
+    pipeline_state state;
+    pipeline_queue parsed( queue_depth_ );
+    pipeline_queue results( queue_depth_ );
+
+    std::thread parser( [ & ]()
+    {
+        try
+        {
+            parse_stage( input, block_size_, parsed, state );
+        }
+        catch ( ... )
+        {
+            state.fail( std::current_exception() );
+        }
+    } );
+
+    std::thread calculator;
+    try
+    {
+        calculator = std::thread( [ & ]()
+        {
+            try
+            {
+                compute_stage( calculate_, parsed, results, state );
+            }
+            catch ( ... )
+            {
+                state.fail( std::current_exception() );
+            }
+        } );
+    }
+    catch ( ... )
+    {
+        state.stop();
+        parser.join();
+        throw;
+    }
+
+    std::size_t written = 0;
+    try
+    {
+        written = format_stage( spec_, output, results, state );
+    }
+    catch ( ... )
+    {
+        state.fail( std::current_exception() );
+    }
+    parser.join();
+    calculator.join();
+    state.rethrow();
+    return written;
+}
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
@@ -0,0 +1,97 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#pragma once
+
+#ifndef SIGDIG_TELEMETRY_HPP
+#define SIGDIG_TELEMETRY_HPP
+
+#include "precision_telemetry.hpp"
+
+#ifdef SIGDIG_TELEMETRY
+
+#include <atomic>
+#include <memory>
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+/** @class thread_histograms The digit histograms of one thread, with one set
+ of bins per tag. Only the owning thread records into them, so recording is a
+ plain load and store instead of a locked add. The bins are atomic only so a
+ snapshot can read them from another thread. A thread only takes a lock when it
+ uses a tag for the first time.
+ */
+
+class thread_histograms
+{
+public:
+
+    struct tag_counts
+    {
+        std::atomic< unsigned long long > bins[ precision_histograms::bins_per_tag ];
+    };
+
+    thread_histograms();
+
+    ~thread_histograms();
+
+    thread_histograms( const thread_histograms & ) = delete;
+
+    thread_histograms & operator = ( const thread_histograms & ) = delete;
+
+    inline unsigned int get_tag() const { return tag_; }
+
+    /// Makes tag the current tag, and makes bins for it if this thread has not used it before.
+    void select( unsigned int tag );
+
+    /// Makes tag current again without making bins for it, so this never throws.
+    inline void restore( unsigned int tag )
+    {
+        tag_ = tag;
+        current_ = ( tag < tags_.size() ) ? tags_[ tag ].get() : nullptr;
+    }
+
+    inline void record( digit_operation operation, unsigned int input_digits, int output_digits )
+    {
+        if ( nullptr == current_ )
+        {
+            select( tag_ );
+        }
+        std::atomic< unsigned long long > & bin =
+            current_->bins[ precision_histograms::get_bin( operation, input_digits, output_digits ) ];
+        bin.store( bin.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+    }
+
+    /// Adds this thread's bins into counts. The caller must hold the registry lock.
+    void add_to( std::vector< precision_histograms::tag_bins > & counts ) const;
+
+private:
+
+    std::vector< std::unique_ptr< tag_counts > > tags_;
+    tag_counts * current_;
+    unsigned int tag_;
+
+};
+
+extern thread_local thread_histograms local_histograms;
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
+
+#define SIGDIG_RECORD_DIGITS( operation, input_digits, output_digits ) \
+    ::sigdig::local_histograms.record( ::sigdig::digit_operation::operation, \
+        ( input_digits ), static_cast< int >( output_digits ) )
+
+#else
+
+#define SIGDIG_RECORD_DIGITS( operation, input_digits, output_digits ) static_cast< void >( 0 )
+
+#endif
+
+#endif
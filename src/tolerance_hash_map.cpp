@@ -0,0 +1,246 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#include "tolerance_hash_map.hpp"
+
+#include <cassert>
+#include <cmath>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "defined_value.hpp"
+#include "lookup.hpp"
+
+namespace sigdig {
+
+/// A search over more cells than this looks at every key instead.
+static const long double max_cells_to_search = 64.0L;
+
+/// Cell numbers at or above this, which is 2^63, may not be whole numbers a long double can hold exactly.
+static const long double max_exact_cell = 9223372036854775808.0L;
+
+// ----------------------------------------------------------------------------
+
+static bool is_exact_cell( long double cell )
+{
+    return std::fabs( cell ) < max_exact_cell;
+}
+
+// ----------------------------------------------------------------------------
+
+tolerance_hash_map::tolerance_hash_map() :
+    keys_(),
+    lower_(),
+    upper_(),
+    cells_(),
+    uncelled_(),
+    cell_exponent_( 0 )
+{
+}
+
+// ----------------------------------------------------------------------------
+
+void tolerance_hash_map::clear()
+{
+    keys_.clear();
+    lower_.clear();
+    upper_.clear();
+    cells_.clear();
+    uncelled_.clear();
+    cell_exponent_ = 0;
+}
+
+// ----------------------------------------------------------------------------
+
+long double tolerance_hash_map::calculate_cell( long double value ) const
+{
+    const long double cell = std::floor( value / lookup::lookup_ceiling_offset( cell_exponent_ ) );
+    // Avoid having both +0 and -0 as cells.
+    return ( cell == 0.0L ) ? 0.0L : cell;
+}
+
+// ----------------------------------------------------------------------------
+
+std::size_t tolerance_hash_map::find_in_range( long double lower,
+    long double upper, std::vector< std::size_t > * groups ) const
+{
+    if ( keys_.empty() )
+    {
+        return npos;
+    }
+    std::size_t found = npos;
+    const std::size_t first_new = ( nullptr == groups ) ? 0 : groups->size();
+    auto check = [ & ]( std::size_t group )
+    {
+        if ( ( lower <= upper_[ group ] ) && ( lower_[ group ] <= upper ) )
+        {
+            found = std::min( found, group );
+            if ( nullptr != groups )
+            {
+                groups->push_back( group );
+            }
+        }
+    };
+
+    const long double first_cell = calculate_cell( lower );
+    const long double last_cell = calculate_cell( upper );
+    if ( !is_exact_cell( first_cell ) || !is_exact_cell( last_cell ) ||
+         ( last_cell - first_cell > max_cells_to_search ) )
+    {
+        for ( std::size_t ii = 0; ii < keys_.size(); ++ii )
+        {
+            check( ii );
+        }
+        return found;
+    }
+    for ( std::size_t group : uncelled_ )
+    {
+        check( group );
+    }
+    const std::size_t cell_count = static_cast< std::size_t >( last_cell - first_cell );
+    for ( std::size_t offset = 0; offset <= cell_count; ++offset )
+    {
+        const auto here = cells_.find( first_cell + static_cast< long double >( offset ) );
+        if ( here != cells_.end() )
+        {
+            for ( std::size_t group : here->second )
+            {
+                check( group );
+            }
+        }
+    }
+    if ( ( nullptr != groups ) && ( ( first_cell != last_cell ) || !uncelled_.empty() ) )
+    {
+        // A key touching both cells was found twice, and uncelled keys were not found in order.
+        std::sort( groups->begin() + first_new, groups->end() );
+        groups->erase( std::unique( groups->begin() + first_new, groups->end() ), groups->end() );
+    }
+    return found;
+}
+
+// ----------------------------------------------------------------------------
+
+std::size_t tolerance_hash_map::find( const significant_value & value ) const
+{
+    return find_in_range( value.get_tolerance_lower(), value.get_tolerance_upper(), nullptr );
+}
+
+// ----------------------------------------------------------------------------
+
+std::size_t tolerance_hash_map::find( const defined_value & value ) const
+{
+    return find_in_range( value.get_value(), value.get_value(), nullptr );
+}
+
+// ----------------------------------------------------------------------------
+
+void tolerance_hash_map::find_all( const significant_value & value,
+    std::vector< std::size_t > & groups ) const
+{
+    find_in_range( value.get_tolerance_lower(), value.get_tolerance_upper(), &groups );
+}
+
+// ----------------------------------------------------------------------------
+
+std::size_t tolerance_hash_map::find_or_insert( const significant_value & value )
+{
+    return find_or_insert( value.get_exact_value(), value.get_digit_count(),
+        value.get_most_sigdig_exponent() );
+}
+
+// ----------------------------------------------------------------------------
+
+std::size_t tolerance_hash_map::find_or_insert( long double value,
+    unsigned int digits, int most_sigdig_exponent )
+{
+    const int least_sigdig_exponent = most_sigdig_exponent - static_cast< int >( digits ) + 1;
+    const long double tolerance = lookup::lookup_tolerance( least_sigdig_exponent - 1 );
+    const long double lower = value - tolerance;
+    const long double upper = value + tolerance;
+    const std::size_t found = find_in_range( lower, upper, nullptr );
+    if ( found != npos )
+    {
+        return found;
+    }
+
+    if ( keys_.empty() )
+    {
+        cell_exponent_ = least_sigdig_exponent;
+    }
+    else if ( cell_exponent_ < least_sigdig_exponent )
+    {
+        widen_cells( least_sigdig_exponent );
+    }
+    const std::size_t group = keys_.size();
+    keys_.push_back( value, digits, most_sigdig_exponent );
+    lower_.push_back( lower );
+    upper_.push_back( upper );
+    add_to_cells( group );
+    return group;
+}
+
+// ----------------------------------------------------------------------------
+
+void tolerance_hash_map::group( const column_view & column,
+    std::vector< std::size_t > & groups )
+{
+    groups.resize( column.size() );
+    for ( std::size_t ii = 0; ii < column.size(); ++ii )
+    {
+        groups[ ii ] = find_or_insert( column.get_exact_value( ii ),
+            column.get_digit_count( ii ), column.get_most_sigdig_exponent( ii ) );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value tolerance_hash_map::get_key( std::size_t group ) const
+{
+    if ( group >= keys_.size() )
+    {
+        throw std::out_of_range( "Error! Group number is outside of tolerance_hash_map." );
+    }
+    return keys_.get( group );
+}
+
+// ----------------------------------------------------------------------------
+
+void tolerance_hash_map::add_to_cells( std::size_t group )
+{
+    const long double first_cell = calculate_cell( lower_[ group ] );
+    const long double last_cell = calculate_cell( upper_[ group ] );
+    if ( !is_exact_cell( first_cell ) || !is_exact_cell( last_cell ) )
+    {
+        // Nearby values might share a cell number or skip one, so every search checks this key instead.
+        uncelled_.push_back( group );
+        return;
+    }
+    cells_[ first_cell ].push_back( group );
+    if ( last_cell != first_cell )
+    {
+        assert( last_cell - first_cell <= 1.0L );
+        cells_[ last_cell ].push_back( group );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void tolerance_hash_map::widen_cells( int cell_exponent )
+{
+    assert( cell_exponent_ < cell_exponent );
+    cell_exponent_ = cell_exponent;
+    cells_.clear();
+    uncelled_.clear();
+    for ( std::size_t ii = 0; ii < keys_.size(); ++ii )
+    {
+        add_to_cells( ii );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
@@ -0,0 +1,224 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#include "tolerance_index.hpp"
+
+#include <cassert>
+
+#include <algorithm>
+#include <numeric>
+
+#include "defined_value.hpp"
+#include "lookup.hpp"
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+/// One node of the implicit tree waiting to be searched.
+struct tolerance_node
+{
+    std::size_t place;
+    int level;
+    bool left_done;
+};
+
+// ----------------------------------------------------------------------------
+
+tolerance_index::tolerance_index() :
+    lower_(),
+    upper_(),
+    max_upper_(),
+    positions_(),
+    max_level_( -1 )
+{
+}
+
+// ----------------------------------------------------------------------------
+
+tolerance_index::tolerance_index( const column_view & column ) :
+    lower_(),
+    upper_(),
+    max_upper_(),
+    positions_(),
+    max_level_( -1 )
+{
+    build( column );
+}
+
+// ----------------------------------------------------------------------------
+
+void tolerance_index::build( const column_view & column )
+{
+    const std::size_t count = column.size();
+    std::vector< long double > lower( count );
+    std::vector< long double > upper( count );
+    for ( std::size_t ii = 0; ii < count; ++ii )
+    {
+        const long double tolerance =
+            lookup::lookup_tolerance( column.get_least_sigdig_exponent( ii ) - 1 );
+        lower[ ii ] = column.get_exact_value( ii ) - tolerance;
+        upper[ ii ] = column.get_exact_value( ii ) + tolerance;
+    }
+
+    std::vector< std::size_t > positions( count );
+    std::iota( positions.begin(), positions.end(), 0 );
+    std::sort( positions.begin(), positions.end(),
+        [ &lower ]( std::size_t left, std::size_t right )
+        { return lower[ left ] < lower[ right ]; } );
+
+    lower_.resize( count );
+    upper_.resize( count );
+    for ( std::size_t ii = 0; ii < count; ++ii )
+    {
+        lower_[ ii ] = lower[ positions[ ii ] ];
+        upper_[ ii ] = upper[ positions[ ii ] ];
+    }
+    positions_.swap( positions );
+    max_upper_ = upper_;
+    max_level_ = -1;
+    if ( count == 0 )
+    {
+        return;
+    }
+
+    // Leaves are at even places. Each level up, a node at place p has children
+    // at p - half and p + half. A child past the end is treated as holding the
+    // highest upper end of the last node at that level.
+    std::size_t last_place = 0;
+    long double last_upper = 0.0L;
+    for ( std::size_t ii = 0; ii < count; ii += 2 )
+    {
+        last_place = ii;
+        last_upper = upper_[ ii ];
+    }
+    int level = 1;
+    for ( ; ( std::size_t( 1 ) << level ) <= count; ++level )
+    {
+        const std::size_t half = std::size_t( 1 ) << ( level - 1 );
+        const std::size_t first = ( half << 1 ) - 1;
+        const std::size_t step = half << 2;
+        for ( std::size_t ii = first; ii < count; ii += step )
+        {
+            const long double left_upper = max_upper_[ ii - half ];
+            const long double right_upper = ( ii + half < count ) ? max_upper_[ ii + half ] : last_upper;
+            max_upper_[ ii ] = std::max( upper_[ ii ], std::max( left_upper, right_upper ) );
+        }
+        last_place = ( ( last_place >> level ) & 1 ) ? last_place - half : last_place + half;
+        if ( ( last_place < count ) && ( max_upper_[ last_place ] > last_upper ) )
+        {
+            last_upper = max_upper_[ last_place ];
+        }
+    }
+    max_level_ = level - 1;
+}
+
+// ----------------------------------------------------------------------------
+
+template < typename Visitor >
+void tolerance_index::visit_overlapping( long double lower, long double upper,
+    Visitor & visitor ) const
+{
+    if ( max_level_ < 0 )
+    {
+        return;
+    }
+    const std::size_t count = lower_.size();
+    tolerance_node stack[ 128 ];
+    std::size_t depth = 0;
+    stack[ depth++ ] = { ( std::size_t( 1 ) << max_level_ ) - 1, max_level_, false };
+    while ( depth != 0 )
+    {
+        const tolerance_node node = stack[ --depth ];
+        if ( node.level <= 3 )
+        {
+            // Small subtrees are faster to scan than to search.
+            const std::size_t first = ( node.place >> node.level ) << node.level;
+            const std::size_t last = std::min( count,
+                first + ( std::size_t( 1 ) << ( node.level + 1 ) ) - 1 );
+            for ( std::size_t ii = first; ( ii < last ) && ( lower_[ ii ] <= upper ); ++ii )
+            {
+                if ( lower <= upper_[ ii ] )
+                {
+                    visitor( positions_[ ii ] );
+                }
+            }
+        }
+        else if ( !node.left_done )
+        {
+            const std::size_t left = node.place - ( std::size_t( 1 ) << ( node.level - 1 ) );
+            stack[ depth++ ] = { node.place, node.level, true };
+            if ( ( left >= count ) || ( lower <= max_upper_[ left ] ) )
+            {
+                stack[ depth++ ] = { left, node.level - 1, false };
+            }
+        }
+        else if ( ( node.place < count ) && ( lower_[ node.place ] <= upper ) )
+        {
+            if ( lower <= upper_[ node.place ] )
+            {
+                visitor( positions_[ node.place ] );
+            }
+            stack[ depth++ ] = { node.place + ( std::size_t( 1 ) << ( node.level - 1 ) ), node.level - 1, false };
+        }
+        assert( depth < 128 );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void tolerance_index::find_overlapping( long double lower, long double upper,
+    std::vector< std::size_t > & matches ) const
+{
+    auto append = [ &matches ]( std::size_t position ) { matches.push_back( position ); };
+    visit_overlapping( lower, upper, append );
+}
+
+// ----------------------------------------------------------------------------
+
+void tolerance_index::find_equal( const significant_value & value,
+    std::vector< std::size_t > & matches ) const
+{
+    find_overlapping( value.get_tolerance_lower(), value.get_tolerance_upper(), matches );
+}
+
+// ----------------------------------------------------------------------------
+
+void tolerance_index::find_equal( const defined_value & value,
+    std::vector< std::size_t > & matches ) const
+{
+    find_overlapping( value.get_value(), value.get_value(), matches );
+}
+
+// ----------------------------------------------------------------------------
+
+std::size_t tolerance_index::count_equal( const significant_value & value ) const
+{
+    std::size_t count = 0;
+    auto increment = [ &count ]( std::size_t ) { ++count; };
+    visit_overlapping( value.get_tolerance_lower(), value.get_tolerance_upper(), increment );
+    return count;
+}
+
+// ----------------------------------------------------------------------------
+
+void tolerance_index::join( const column_view & other,
+    std::vector< match > & matches ) const
+{
+    for ( std::size_t ii = 0; ii < other.size(); ++ii )
+    {
+        const long double tolerance =
+            lookup::lookup_tolerance( other.get_least_sigdig_exponent( ii ) - 1 );
+        const long double value = other.get_exact_value( ii );
+        auto append = [ &matches, ii ]( std::size_t position )
+        { matches.push_back( match( position, ii ) ); };
+        visit_overlapping( value - tolerance, value + tolerance, append );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
@@ -0,0 +1,280 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#include "tolerance_sort.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#include "lookup.hpp"
+
+namespace sigdig {
+
+// ----------------------------------------------------------------------------
+
+namespace {
+
+/// A value whose tolerance range may still overlap values not yet reached.
+struct open_range
+{
+    long double upper;
+    std::size_t position;
+};
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+
+static void calculate_tolerance_bounds( const column_view & column,
+    std::vector< long double > & lower, std::vector< long double > & upper )
+{
+    const std::size_t count = column.size();
+    lower.resize( count );
+    upper.resize( count );
+    for ( std::size_t ii = 0; ii < count; ++ii )
+    {
+        const long double tolerance =
+            lookup::lookup_tolerance( column.get_least_sigdig_exponent( ii ) - 1 );
+        lower[ ii ] = column.get_exact_value( ii ) - tolerance;
+        upper[ ii ] = column.get_exact_value( ii ) + tolerance;
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+static void run_in_threads( const std::vector< std::function< void() > > & tasks )
+{
+    std::vector< std::thread > workers;
+    workers.reserve( tasks.size() );
+    for ( std::size_t ii = 1; ii < tasks.size(); ++ii )
+    {
+        try
+        {
+            workers.emplace_back( tasks[ ii ] );
+        }
+        catch ( const std::system_error & )
+        {
+            // Do the task in this thread if no more threads can be made.
+            tasks[ ii ]();
+        }
+    }
+    if ( !tasks.empty() )
+    {
+        tasks[ 0 ]();
+    }
+    for ( std::thread & worker : workers )
+    {
+        worker.join();
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+static void remove_closed_ranges( std::vector< open_range > & ranges, long double lower )
+{
+    ranges.erase( std::remove_if( ranges.begin(), ranges.end(),
+        [ lower ]( const open_range & range ) { return range.upper < lower; } ),
+        ranges.end() );
+}
+
+// ----------------------------------------------------------------------------
+
+void tolerance_sort::sort( const column_view & column,
+    std::vector< std::size_t > & order, unsigned int thread_count )
+{
+    std::vector< long double > lower;
+    std::vector< long double > upper;
+    calculate_tolerance_bounds( column, lower, upper );
+    const std::size_t count = column.size();
+    order.resize( count );
+    std::iota( order.begin(), order.end(), 0 );
+    auto is_before = [ &lower, &upper ]( std::size_t left, std::size_t right )
+    {
+        if ( lower[ left ] != lower[ right ] )
+        {
+            return lower[ left ] < lower[ right ];
+        }
+        if ( upper[ left ] != upper[ right ] )
+        {
+            return upper[ left ] < upper[ right ];
+        }
+        return left < right;
+    };
+
+    if ( thread_count == 0 )
+    {
+        thread_count = std::max( 1U, std::thread::hardware_concurrency() );
+    }
+    if ( ( count < parallel_threshold ) || ( thread_count < 2 ) )
+    {
+        std::sort( order.begin(), order.end(), is_before );
+        return;
+    }
+
+    // Sort a chunk in each thread, then merge pairs of chunks until one is left.
+    std::vector< std::size_t > bounds;
+    for ( unsigned int ii = 0; ii <= thread_count; ++ii )
+    {
+        bounds.push_back( count * ii / thread_count );
+    }
+    std::vector< std::function< void() > > tasks;
+    for ( std::size_t ii = 0; ii + 1 < bounds.size(); ++ii )
+    {
+        const std::size_t first = bounds[ ii ];
+        const std::size_t last = bounds[ ii + 1 ];
+        tasks.push_back( [ &order, &is_before, first, last ]()
+            { std::sort( order.begin() + first, order.begin() + last, is_before ); } );
+    }
+    run_in_threads( tasks );
+
+    std::vector< std::size_t > merged( count );
+    while ( bounds.size() > 2 )
+    {
+        tasks.clear();
+        std::vector< std::size_t > next_bounds;
+        for ( std::size_t ii = 0; ii + 1 < bounds.size(); ii += 2 )
+        {
+            const std::size_t first = bounds[ ii ];
+            const std::size_t middle = bounds[ ii + 1 ];
+            const std::size_t last = ( ii + 2 < bounds.size() ) ? bounds[ ii + 2 ] : middle;
+            next_bounds.push_back( first );
+            tasks.push_back( [ &order, &merged, &is_before, first, middle, last ]()
+                {
+                    std::merge( order.begin() + first, order.begin() + middle,
+                        order.begin() + middle, order.begin() + last,
+                        merged.begin() + first, is_before );
+                } );
+        }
+        next_bounds.push_back( count );
+        run_in_threads( tasks );
+        order.swap( merged );
+        bounds.swap( next_bounds );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void tolerance_sort::sort( significant_column & column, unsigned int thread_count )
+{
+    std::vector< std::size_t > order;
+    sort( column.view(), order, thread_count );
+    const column_view unsorted = column.view();
+    significant_column sorted;
+    sorted.reserve( order.size() );
+    for ( std::size_t position : order )
+    {
+        sorted.push_back( unsorted.get_exact_value( position ),
+            unsorted.get_digit_count( position ),
+            unsorted.get_most_sigdig_exponent( position ) );
+    }
+    column = sorted;
+}
+
+// ----------------------------------------------------------------------------
+
+bool tolerance_sort::is_sorted( const column_view & column )
+{
+    std::vector< long double > lower;
+    std::vector< long double > upper;
+    calculate_tolerance_bounds( column, lower, upper );
+    for ( std::size_t ii = 1; ii < column.size(); ++ii )
+    {
+        if ( ( lower[ ii ] < lower[ ii - 1 ] ) ||
+             ( ( lower[ ii ] == lower[ ii - 1 ] ) && ( upper[ ii ] < upper[ ii - 1 ] ) ) )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+
+void tolerance_sort::group_equal( const column_view & sorted,
+    std::vector< std::size_t > & starts )
+{
+    if ( !is_sorted( sorted ) )
+    {
+        throw std::invalid_argument( "Error! Column must be sorted to group equal values." );
+    }
+    std::vector< long double > lower;
+    std::vector< long double > upper;
+    calculate_tolerance_bounds( sorted, lower, upper );
+    // Since lower ends only increase, every value in a run equals every other
+    // value exactly when the newest lower end is within the lowest upper end.
+    long double lowest_upper = 0.0L;
+    for ( std::size_t ii = 0; ii < sorted.size(); ++ii )
+    {
+        if ( ( ii == 0 ) || ( lowest_upper < lower[ ii ] ) )
+        {
+            starts.push_back( ii );
+            lowest_upper = upper[ ii ];
+        }
+        else
+        {
+            lowest_upper = std::min( lowest_upper, upper[ ii ] );
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void tolerance_sort::merge_join( const column_view & left,
+    const column_view & right, std::vector< match > & matches )
+{
+    if ( !is_sorted( left ) || !is_sorted( right ) )
+    {
+        throw std::invalid_argument( "Error! Columns must be sorted to merge them." );
+    }
+    std::vector< long double > left_lower;
+    std::vector< long double > left_upper;
+    std::vector< long double > right_lower;
+    std::vector< long double > right_upper;
+    calculate_tolerance_bounds( left, left_lower, left_upper );
+    calculate_tolerance_bounds( right, right_lower, right_upper );
+
+    std::vector< open_range > open_left;
+    std::vector< open_range > open_right;
+    std::size_t ll = 0;
+    std::size_t rr = 0;
+    while ( ( ll < left.size() ) || ( rr < right.size() ) )
+    {
+        const bool take_left = ( rr == right.size() ) ||
+            ( ( ll < left.size() ) && ( left_lower[ ll ] <= right_lower[ rr ] ) );
+        if ( take_left )
+        {
+            const long double lower = left_lower[ ll ];
+            remove_closed_ranges( open_left, lower );
+            remove_closed_ranges( open_right, lower );
+            for ( const open_range & range : open_right )
+            {
+                matches.push_back( match( ll, range.position ) );
+            }
+            open_left.push_back( open_range{ left_upper[ ll ], ll } );
+            ++ll;
+        }
+        else
+        {
+            const long double lower = right_lower[ rr ];
+            remove_closed_ranges( open_left, lower );
+            remove_closed_ranges( open_right, lower );
+            for ( const open_range & range : open_left )
+            {
+                matches.push_back( match( range.position, rr ) );
+            }
+            open_right.push_back( open_range{ right_upper[ rr ], rr } );
+            ++rr;
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+} // end namespace
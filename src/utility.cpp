@@ -14,6 +14,7 @@
 
 #include "lookup.hpp"
 #include "helper.hpp"
+#include "counters.hpp"
 
 #include <iostream>
 
@@ -23,93 +24,63 @@ namespace sigdig {
 
 int utility::calculate_exponent( long value )
 {
-    if ( value == 0L )
-    {
-        return 0;
-    }
-    const unsigned long v = std::abs( value );
-    int exponent = calculate_exponent( v );
-    return exponent;
+    return calculate_exponent( static_cast< long long >( value ) );
 }
 
 // ----------------------------------------------------------------------------
 
-static const unsigned long integerExponentLookupTable[] =
+int utility::calculate_exponent( unsigned long value )
 {
-              0UL,
-             10UL,
-            100UL,
-           1000UL,
-          10000UL,
-         100000UL,
-        1000000UL,
-       10000000UL,
-      100000000UL,
-     1000000000UL
-};
-
-static const unsigned int integerExponentLookupTableSize =
-    sizeof( integerExponentLookupTable )
-        / sizeof( integerExponentLookupTable[0] );
+    return calculate_exponent( static_cast< unsigned long long >( value ) );
+}
 
 // ----------------------------------------------------------------------------
 
-int utility::calculate_exponent( unsigned long value )
+int utility::calculate_exponent( long long value )
 {
+    // Negate as unsigned so the lowest long long does not overflow.
+    const unsigned long long v = ( value < 0 ) ?
+        0ULL - static_cast< unsigned long long >( value ) : static_cast< unsigned long long >( value );
+    return calculate_exponent( v );
+}
 
-    unsigned int first = 0;
-    unsigned int last = integerExponentLookupTableSize;
-    unsigned int place;
-    while ( first < last )
-    {
-        place = ( first + last ) / 2;
-        if ( integerExponentLookupTable[ place ] <= value )
-        {
-            if ( integerExponentLookupTable[ place+1 ] > value )
-            {
-                break;
-            }
-            first = place;
-        }
-        else
-        {
-            last = place;
-        }
-    }
+// ----------------------------------------------------------------------------
 
-    return place;
+int utility::calculate_exponent( unsigned long long value )
+{
+    const int exponent = static_cast< int >( helper::count_decimal_digits( value ) ) - 1;
+    return exponent;
 }
 
 // ----------------------------------------------------------------------------
 
-int utility::calculate_exponent( long double value )
+#ifdef __SIZEOF_INT128__
+
+int utility::calculate_exponent( __int128 value )
 {
-    const int exponent = lookup::calculate_exponent(
-        helper::validate_input_value( value ) );
+    const unsigned __int128 v = ( value < 0 ) ?
+        static_cast< unsigned __int128 >( 0 ) - static_cast< unsigned __int128 >( value ) :
+        static_cast< unsigned __int128 >( value );
+    return calculate_exponent( v );
+}
+
+// ----------------------------------------------------------------------------
+
+int utility::calculate_exponent( unsigned __int128 value )
+{
+    const int exponent = static_cast< int >( helper::count_decimal_digits( value ) ) - 1;
     return exponent;
 }
 
 // ----------------------------------------------------------------------------
 
-int count_integer_significant_digits( const char * chars, unsigned int bytes )
+#endif
+
+int utility::calculate_exponent( long double value )
 {
-    if ( *chars == '-' )
-    {
-        ++chars;
-        --bytes;
-    }
-    const char * p = chars + bytes - 1;
-    while ( p >= chars )
-    {
-        if ( '0' != *p )
-        {
-            break;
-        }
-        --p;
-    }
-    const int count = ( p <= chars ) ? 1 : ( p - chars ) + 1;
-    assert( 0 < count );
-    return count;
+    const int exponent = lookup::calculate_exponent(
+        helper::validate_input_value( value ) );
+    return exponent;
 }
 
 // ----------------------------------------------------------------------------
@@ -131,6 +102,7 @@ unsigned int utility::count_significant_digits( long double value, int & exponen
     unsigned int count = 1;
     for ( unsigned int i = 0; i <= helper::max_range_of_digits_for_long_double; i++ )
     {
+        SIGDIG_COUNT( digit_count_iterations );
         power_of_ten = std::pow( 10.0L, magnitude );
         const long double y = std::round( value / power_of_ten ) * power_of_ten;
         if ( std::abs( value - y ) < underflow_threshold )
@@ -160,24 +132,67 @@ unsigned int utility::count_significant_digits( long double value )
 
 unsigned int utility::count_significant_digits( long value )
 {
-    const unsigned long v = std::abs( value );
-    const unsigned int count = count_significant_digits( v );
-    return count;
+    return count_significant_digits( static_cast< long long >( value ) );
 }
 
 // ----------------------------------------------------------------------------
 
 unsigned int utility::count_significant_digits( unsigned long value )
 {
-    std::array< char, 256 > chars;
-    const int bytes = std::snprintf( chars.data(), chars.size(), "%lu", value );
-    assert( bytes > 0 );
-    const unsigned int counted = count_integer_significant_digits( chars.data(), bytes );
+    return count_significant_digits( static_cast< unsigned long long >( value ) );
+}
+
+// ----------------------------------------------------------------------------
+
+unsigned int utility::count_significant_digits( long long value )
+{
+    const unsigned long long v = ( value < 0 ) ?
+        0ULL - static_cast< unsigned long long >( value ) : static_cast< unsigned long long >( value );
+    return count_significant_digits( v );
+}
+
+// ----------------------------------------------------------------------------
+
+unsigned int utility::count_significant_digits( unsigned long long value )
+{
+    if ( value == 0 )
+    {
+        return 1;
+    }
+    const unsigned int counted = helper::count_decimal_digits( value )
+        - helper::count_trailing_decimal_zeros( value );
+    return counted;
+}
+
+// ----------------------------------------------------------------------------
+
+#ifdef __SIZEOF_INT128__
+
+unsigned int utility::count_significant_digits( __int128 value )
+{
+    const unsigned __int128 v = ( value < 0 ) ?
+        static_cast< unsigned __int128 >( 0 ) - static_cast< unsigned __int128 >( value ) :
+        static_cast< unsigned __int128 >( value );
+    return count_significant_digits( v );
+}
+
+// ----------------------------------------------------------------------------
+
+unsigned int utility::count_significant_digits( unsigned __int128 value )
+{
+    if ( value == 0 )
+    {
+        return 1;
+    }
+    const unsigned int counted = helper::count_decimal_digits( value )
+        - helper::count_trailing_decimal_zeros( value );
     return counted;
 }
 
 // ----------------------------------------------------------------------------
 
+#endif
+
 bool count_digits_in_fixed_string( const char * source, unsigned int & digits, int & exponent )
 {
 
@@ -359,6 +374,43 @@ void utility::count_digits_in_string( const char * source,
 
 // ----------------------------------------------------------------------------
 
+long double utility::round_to_digits( long double value, int exponent,
+    unsigned int digits, rounding_style rounding )
+{
+    helper::validate_input_value( value );
+    helper::validate_digit_count( digits );
+    return helper::round_to_digits( value, exponent, digits, rounding );
+}
+
+// ----------------------------------------------------------------------------
+
+long double utility::round_to_digits( long double value, unsigned int digits,
+    rounding_style rounding )
+{
+    helper::validate_input_value( value );
+    helper::validate_digit_count( digits );
+    const int exponent = lookup::calculate_exponent( value );
+    return helper::round_to_digits( value, exponent, digits, rounding );
+}
+
+// ----------------------------------------------------------------------------
+
+void utility::round_to_digits( const long double * values, const int * exponents,
+    const unsigned int * digits, std::size_t count, rounding_style rounding,
+    long double * results )
+{
+    for ( std::size_t ii = 0; ii < count; ++ii )
+    {
+        helper::validate_digit_count( digits[ ii ] );
+    }
+    for ( std::size_t ii = 0; ii < count; ++ii )
+    {
+        results[ ii ] = helper::round_to_digits( values[ ii ], exponents[ ii ], digits[ ii ], rounding );
+    }
+}
+
+// ----------------------------------------------------------------------------
+
 int utility::get_lowest_exponent_allowed()
 {
     return helper::lowest_exponent;
@@ -0,0 +1,94 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+// Compares counting digits of integers through snprintf, which is how SigDig
+// used to do it, against the count-leading-zeros path in utility. This also
+// times constructing measured_value objects from integer counters.
+
+#include <utility.hpp>
+#include <measured_value.hpp>
+
+#include <cstdio>
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace sigdig;
+
+// ----------------------------------------------------------------------------
+
+unsigned int CountDigitsWithString( unsigned long long value )
+{
+    std::array< char, 32 > chars;
+    const int bytes = std::snprintf( chars.data(), chars.size(), "%llu", value );
+    const char * p = chars.data() + bytes - 1;
+    while ( ( p > chars.data() ) && ( '0' == *p ) )
+    {
+        --p;
+    }
+    return static_cast< unsigned int >( p - chars.data() ) + 1;
+}
+
+// ----------------------------------------------------------------------------
+
+template < typename Function >
+double TimeIt( const char * name, const std::vector< unsigned long long > & values,
+    Function function )
+{
+    const auto start = std::chrono::steady_clock::now();
+    unsigned long long total = 0;
+    for ( unsigned long long value : values )
+    {
+        total += function( value );
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    const double nanoseconds = std::chrono::duration< double, std::nano >( stop - start ).count()
+        / static_cast< double >( values.size() );
+    std::cout << name << ": " << nanoseconds << " ns per value (checksum " << total << ")" << std::endl;
+    return nanoseconds;
+}
+
+// ----------------------------------------------------------------------------
+
+int main()
+{
+    const std::size_t count = 10000000;
+    std::vector< unsigned long long > values( count );
+    unsigned long long state = 88172645463325252ULL;
+    for ( std::size_t ii = 0; ii < count; ++ii )
+    {
+        // Mix of small counters and full width values, some with trailing zeros.
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        const unsigned int shift = static_cast< unsigned int >( state % 60 );
+        values[ ii ] = ( ( ii % 4 ) == 0 ) ? ( state >> shift ) * 1000ULL : ( state >> shift );
+    }
+
+    std::size_t mismatches = 0;
+    for ( std::size_t ii = 0; ii < count; ii += 97 )
+    {
+        mismatches += ( CountDigitsWithString( values[ ii ] ) ==
+            utility::count_significant_digits( values[ ii ] ) ) ? 0 : 1;
+    }
+    std::cout << "mismatches: " << mismatches << std::endl;
+
+    const double old_time = TimeIt( "snprintf digit count", values,
+        []( unsigned long long v ) { return CountDigitsWithString( v ); } );
+    const double new_time = TimeIt( "clz digit count", values,
+        []( unsigned long long v ) { return utility::count_significant_digits( v ); } );
+    TimeIt( "clz exponent", values,
+        []( unsigned long long v ) { return static_cast< unsigned int >( utility::calculate_exponent( v ) ); } );
+    TimeIt( "measured_value from integer", values,
+        []( unsigned long long v ) { return measured_value( v ).get_digit_count(); } );
+    std::cout << "speed up: " << old_time / new_time << std::endl;
+
+    return ( mismatches == 0 ) ? 0 : 1;
+}
+
+// ----------------------------------------------------------------------------
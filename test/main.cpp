@@ -2303,6 +2303,7 @@ int main( int argc, const char * argv[] )
 	TestSigDigCounting();
 	TestStringDigitCounting();
 	TestComparisons();
+	TestPrecisionDispatch();
 
 	TestDefinedValueBasics();
 	TestDefinedStringOutput();
@@ -2347,6 +2348,33 @@ int main( int argc, const char * argv[] )
 	TestValuePowers< calculated_value >( "calculated Powers" );
 	TestValueTrig< calculated_value >( "calculated Trig" );
 
+	TestColumnBasics();
+	TestBatchArithmetic();
+	TestColumnFile();
+	TestPackedIntegers();
+	TestCompressedColumn();
+	TestToleranceIndex();
+	TestToleranceSort();
+	TestToleranceHashMap();
+	TestSignificantStats();
+	TestLinearAlgebra();
+	TestPolynomial();
+	TestInterpolationTable();
+	TestDecimalNumber();
+	TestScaledIntegerSums();
+	TestRoundToDigits();
+	TestFormatSpec();
+	TestValueFormatter();
+	TestScalarArithmetic();
+	TestDeferredMetadata();
+	TestTrivialCopies();
+	TestFormula();
+	TestDependencyGraph();
+	TestStreamPipeline();
+	TestOperationCounters();
+	TestPrecisionTelemetry();
+	TestMemoryResources();
+
 #ifdef PRINT_LIMITS
 	PrintLimits();
 #endif
@@ -0,0 +1,763 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#ifdef __CYGWIN__
+	#undef _REENT_ONLY
+#endif
+
+#include "test_functions.hpp"
+
+#include <utility.hpp>
+#include <defined_value.hpp>
+#include <measured_value.hpp>
+#include <calculated_value.hpp>
+#include <significant_column.hpp>
+#include <column_file.hpp>
+#include <compressed_column.hpp>
+#include <packed_integers.hpp>
+#include <batch.hpp>
+#include <format_spec.hpp>
+#include <formula.hpp>
+#include <stream_pipeline.hpp>
+
+#include <UnitTest.hpp>
+
+#include <cstdint>
+#include <cstdio>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iterator>
+#include <memory_resource>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ut;
+using namespace sigdig;
+
+// ----------------------------------------------------------------------------
+
+void TestColumnBasics()
+{
+    ut::UnitTestSet & uts = ut::UnitTestSet::GetIt();
+    ut::UnitTest * u = uts.AddUnitTest( "Column_Basics" );
+
+	significant_column column;
+	UNIT_TEST( u, column.empty() );
+	column.push_back( measured_value( "12.34" ) );
+	column.push_back( measured_value( "-0.0050" ) );
+	column.push_back( measured_value( "6.02E+23" ) );
+	UNIT_TEST( u, column.size() == 3 );
+
+	const column_view view = column.view();
+	UNIT_TEST( u, view.size() == 3 );
+	UNIT_TEST( u, view.get_digit_count( 0 ) == 4 );
+	UNIT_TEST( u, view.get_most_sigdig_exponent( 0 ) == 1 );
+	UNIT_TEST( u, view.get_least_sigdig_exponent( 0 ) == -2 );
+	UNIT_TEST( u, view.get_digit_count( 1 ) == 2 );
+	UNIT_TEST( u, view.get_least_sigdig_exponent( 1 ) == -4 );
+	UNIT_TEST( u, view.get_most_sigdig_exponent( 2 ) == 23 );
+
+	const calculated_value v = view.get( 1 );
+	UNIT_TEST( u, v.get_digit_count() == 2 );
+	UNIT_TEST( u, v.get_most_sigdig_exponent() == -3 );
+	UNIT_TEST( u, v.to_string() == "-0.0050" );
+
+	const column_view tail = view.slice( 1, 2 );
+	UNIT_TEST( u, tail.size() == 2 );
+	UNIT_TEST( u, tail.get_most_sigdig_exponent( 1 ) == 23 );
+
+	bool caught = false;
+	try
+	{
+		view.slice( 2, 2 );
+	}
+	catch ( const std::out_of_range & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+}
+
+// ----------------------------------------------------------------------------
+
+void TestBatchArithmetic()
+{
+    ut::UnitTestSet & uts = ut::UnitTestSet::GetIt();
+    ut::UnitTest * u = uts.AddUnitTest( "Batch_Arithmetic" );
+
+	const measured_value a1( "12.34" );
+	const measured_value a2( "1.5" );
+	const measured_value a3( "-250" );
+	const measured_value b1( "0.012" );
+	const measured_value b2( "2.25" );
+	const measured_value b3( "4.0" );
+	significant_column left;
+	left.push_back( a1 );
+	left.push_back( a2 );
+	left.push_back( a3 );
+	significant_column right;
+	right.push_back( b1 );
+	right.push_back( b2 );
+	right.push_back( b3 );
+
+	significant_column result;
+	batch::add( left.view(), right.view(), result );
+	UNIT_TEST( u, result.size() == 3 );
+	const calculated_value sum1 = a1 + b1;
+	const calculated_value sum2 = a2 + b2;
+	UNIT_TEST( u, result.get( 0 ).get_digit_count() == sum1.get_digit_count() );
+	UNIT_TEST( u, result.get( 0 ).get_least_sigdig_exponent() == sum1.get_least_sigdig_exponent() );
+	UNIT_TEST( u, result.get( 1 ).get_digit_count() == sum2.get_digit_count() );
+	UNIT_TEST( u, result.get( 1 ).get_exact_value() == sum2.get_exact_value() );
+
+	batch::subtract( left.view(), right.view(), result );
+	const calculated_value difference = a2 - b2;
+	UNIT_TEST( u, result.get( 1 ).get_exact_value() == difference.get_exact_value() );
+	UNIT_TEST( u, result.get( 1 ).get_digit_count() == difference.get_digit_count() );
+
+	// Cancellation keeps 1 digit at the highest least significant place, whether or not the places match.
+	const char * minuends[] = { "5.00", "5.00", "5E+2" };
+	const char * subtrahends[] = { "5.00", "5.0", "4.8E+2" };
+	significant_column cancelling_left;
+	significant_column cancelling_right;
+	for ( std::size_t ii = 0; ii < 3; ++ii )
+	{
+		cancelling_left.push_back( measured_value( minuends[ ii ] ) );
+		cancelling_right.push_back( measured_value( subtrahends[ ii ] ) );
+	}
+	batch::subtract( cancelling_left.view(), cancelling_right.view(), result );
+	const int cancelled_places[] = { -2, -1, 2 };
+	bool same_cancellation = true;
+	for ( std::size_t ii = 0; ii < 3; ++ii )
+	{
+		const calculated_value scalar = measured_value( minuends[ ii ] ) - measured_value( subtrahends[ ii ] );
+		calculated_value running( minuends[ ii ] );
+		running -= measured_value( subtrahends[ ii ] );
+		same_cancellation = same_cancellation && ( scalar.get_digit_count() == 1 )
+			&& ( scalar.get_most_sigdig_exponent() == cancelled_places[ ii ] )
+			&& ( result.get( ii ).get_digit_count() == scalar.get_digit_count() )
+			&& ( result.get( ii ).get_most_sigdig_exponent() == scalar.get_most_sigdig_exponent() )
+			&& ( result.get( ii ).get_exact_value() == scalar.get_exact_value() )
+			&& ( running.get_digit_count() == 1 )
+			&& ( running.get_most_sigdig_exponent() == cancelled_places[ ii ] );
+	}
+	UNIT_TEST( u, same_cancellation );
+
+	batch::multiply( left.view(), right.view(), result );
+	const calculated_value product = a3 * b3;
+	UNIT_TEST( u, result.get( 2 ).get_exact_value() == product.get_exact_value() );
+	UNIT_TEST( u, result.get( 2 ).get_digit_count() == product.get_digit_count() );
+	UNIT_TEST( u, result.get( 2 ).get_most_sigdig_exponent() == product.get_most_sigdig_exponent() );
+
+	batch::multiply( left.view(), defined_value( 1000L ), result );
+	UNIT_TEST( u, result.get( 0 ).get_exact_value() == a1.get_exact_value() * 1000.0L );
+	UNIT_TEST( u, result.get( 0 ).get_digit_count() == 4 );
+	UNIT_TEST( u, result.get( 0 ).get_most_sigdig_exponent() == 4 );
+
+	batch::divide( left.view(), right.view(), result );
+	const calculated_value quotient = a1 / b1;
+	UNIT_TEST( u, result.get( 0 ).get_digit_count() == quotient.get_digit_count() );
+	UNIT_TEST( u, result.get( 0 ).get_most_sigdig_exponent() == quotient.get_most_sigdig_exponent() );
+
+	bool flags[ 3 ] = { false, false, false };
+	batch::equals( left.view(), left.view(), flags );
+	UNIT_TEST( u, flags[ 0 ] && flags[ 1 ] && flags[ 2 ] );
+	batch::less_than( left.view(), right.view(), flags );
+	UNIT_TEST( u, flags[ 0 ] == a1.less_than( b1 ) );
+	UNIT_TEST( u, flags[ 1 ] == a2.less_than( b2 ) );
+	UNIT_TEST( u, flags[ 2 ] == a3.less_than( b3 ) );
+	batch::greater_than( left.view(), right.view(), flags );
+	UNIT_TEST( u, flags[ 0 ] == a1.greater_than( b1 ) );
+	UNIT_TEST( u, flags[ 1 ] == a2.greater_than( b2 ) );
+	UNIT_TEST( u, flags[ 2 ] == a3.greater_than( b3 ) );
+
+	significant_column shorter;
+	shorter.push_back( a1 );
+	bool caught = false;
+	try
+	{
+		batch::add( left.view(), shorter.view(), result );
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+}
+
+// ----------------------------------------------------------------------------
+
+void TestColumnFile()
+{
+    ut::UnitTestSet & uts = ut::UnitTestSet::GetIt();
+    ut::UnitTest * u = uts.AddUnitTest( "Column_File" );
+
+	significant_column column;
+	for ( long ii = 0; ii < 1000; ++ii )
+	{
+		const unsigned int digits = ( ii % 10 == 0 ) ? 3 : 4;
+		column.push_back( measured_value( static_cast< long double >( ii ) * 0.25L - 100.0L, digits ) );
+	}
+
+	const char * path = "sigdig_column_test.bin";
+	column_file::write( path, column.view(), 300 );
+	{
+		mapped_column_file file( path );
+		UNIT_TEST( u, file.size() == 1000 );
+		UNIT_TEST( u, file.get_block_count() == 4 );
+		const column_block_stats & stats = file.get_block_stats( 0 );
+		UNIT_TEST( u, stats.first == 0 );
+		UNIT_TEST( u, stats.count == 300 );
+		UNIT_TEST( u, stats.min_value == -100.0L );
+		UNIT_TEST( u, stats.max_value == 299.0L * 0.25L - 100.0L );
+		UNIT_TEST( u, stats.min_digits == 3 );
+		UNIT_TEST( u, stats.max_digits == 4 );
+		UNIT_TEST( u, stats.most_common_digits == 4 );
+		UNIT_TEST( u, file.get_block_stats( 3 ).count == 100 );
+
+		const column_view block = file.get_block( 2 );
+		UNIT_TEST( u, block.size() == 300 );
+		UNIT_TEST( u, block.get_exact_value( 0 ) == column.get( 600 ).get_exact_value() );
+
+		bool same = true;
+		for ( std::size_t ii = 0; ii < column.size(); ++ii )
+		{
+			same = same && ( file.view().get_exact_value( ii ) == column.view().get_exact_value( ii ) )
+				&& ( file.view().get_digit_count( ii ) == column.view().get_digit_count( ii ) )
+				&& ( file.view().get_most_sigdig_exponent( ii ) == column.view().get_most_sigdig_exponent( ii ) );
+		}
+		UNIT_TEST( u, same );
+
+		significant_column doubled;
+		batch::add( file.view(), column.view(), doubled );
+		UNIT_TEST( u, doubled.get( 4 ).get_exact_value() == 2.0L * column.get( 4 ).get_exact_value() );
+	}
+	std::remove( path );
+
+	bool caught = false;
+	try
+	{
+		mapped_column_file missing( "sigdig_no_such_file.bin" );
+	}
+	catch ( const std::runtime_error & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+
+	// These offsets follow the file layout: the header's file size is at byte
+	// 40, the block records start at byte 64, and each record is 96 bytes with
+	// its values offset at byte 8.
+	auto patch = [ path ]( std::streamoff place, std::uint64_t number )
+	{
+		std::fstream file( path, std::ios::binary | std::ios::in | std::ios::out );
+		file.seekp( place );
+		file.write( reinterpret_cast< const char * >( &number ), sizeof( number ) );
+	};
+	auto fails_to_map = [ path ]()
+	{
+		try
+		{
+			mapped_column_file corrupt( path );
+		}
+		catch ( const std::runtime_error & )
+		{
+			return true;
+		}
+		return false;
+	};
+	column_file::write( path, column.view(), 300 );
+	std::uint64_t values_offset = 0;
+	{
+		std::ifstream file( path, std::ios::binary );
+		file.seekg( 64 + 96 + 8 );
+		file.read( reinterpret_cast< char * >( &values_offset ), sizeof( values_offset ) );
+	}
+	patch( 64 + 96 + 8, values_offset + 16 );
+	UNIT_TEST( u, fails_to_map() );
+
+	// A file cut short, with its header changed to match, must not be mapped past its end.
+	column_file::write( path, column.view(), 300 );
+	std::string bytes;
+	{
+		std::ifstream file( path, std::ios::binary );
+		bytes.assign( std::istreambuf_iterator< char >( file ), std::istreambuf_iterator< char >() );
+	}
+	bytes.resize( bytes.size() - 64 );
+	{
+		std::ofstream file( path, std::ios::binary | std::ios::trunc );
+		file.write( bytes.data(), static_cast< std::streamsize >( bytes.size() ) );
+	}
+	patch( 40, bytes.size() );
+	UNIT_TEST( u, fails_to_map() );
+	std::remove( path );
+}
+
+// ----------------------------------------------------------------------------
+
+void TestPackedIntegers()
+{
+    ut::UnitTestSet & uts = ut::UnitTestSet::GetIt();
+    ut::UnitTest * u = uts.AddUnitTest( "Packed_Integers" );
+
+	std::vector< int > same( 1000, 4 );
+	const packed_integers constant( same.data(), same.size() );
+	UNIT_TEST( u, constant.size() == 1000 );
+	UNIT_TEST( u, constant.view().get_bit_width() == 0 );
+	UNIT_TEST( u, constant.view().get( 999 ) == 4 );
+	UNIT_TEST( u, constant.view().count_equal( 4 ) == 1000 );
+	UNIT_TEST( u, constant.view().count_equal( 3 ) == 0 );
+	UNIT_TEST( u, constant.get_byte_count() < 100 );
+
+	std::vector< int > exponents( 1000 );
+	for ( std::size_t ii = 0; ii < exponents.size(); ++ii )
+	{
+		exponents[ ii ] = static_cast< int >( ii % 4 ) - 1;
+	}
+	std::vector< int > sorted( exponents );
+	std::sort( sorted.begin(), sorted.end() );
+	std::vector< int > scattered( 1000 );
+	for ( std::size_t ii = 0; ii < scattered.size(); ++ii )
+	{
+		scattered[ ii ] = ( ii % 4 == 0 ) ? -300 : ( ( ii % 4 == 1 ) ? 20000 : 7 );
+	}
+	UNIT_TEST( u, packed_integers::choose_encoding( exponents.data(), exponents.size() ) == integer_encoding::bit_packed );
+	UNIT_TEST( u, packed_integers::choose_encoding( sorted.data(), sorted.size() ) == integer_encoding::run_length );
+	UNIT_TEST( u, packed_integers::choose_encoding( scattered.data(), scattered.size() ) == integer_encoding::dictionary );
+
+	const std::vector< int > * inputs[] = { &exponents, &sorted, &scattered };
+	const integer_encoding encodings[] = { integer_encoding::bit_packed, integer_encoding::dictionary, integer_encoding::run_length };
+	for ( const std::vector< int > * input : inputs )
+	{
+		for ( integer_encoding encoding : encodings )
+		{
+			const packed_integers packed( input->data(), input->size(), encoding );
+			const packed_integers copied( packed );
+			const packed_integers_view & view = copied.view();
+			UNIT_TEST( u, view.get_encoding() == encoding );
+			std::vector< int > decoded( 900 );
+			view.decode( 50, 900, decoded.data() );
+			bool same_values = true;
+			for ( std::size_t ii = 0; ii < decoded.size(); ++ii )
+			{
+				same_values = same_values && ( decoded[ ii ] == ( *input )[ ii + 50 ] ) && ( view.get( ii ) == ( *input )[ ii ] );
+			}
+			UNIT_TEST( u, same_values );
+			UNIT_TEST( u, view.count_equal( ( *input )[ 0 ] ) ==
+				static_cast< std::size_t >( std::count( input->begin(), input->end(), ( *input )[ 0 ] ) ) );
+			const packed_integers_view reopened( packed.get_words().data(), packed.get_words().size() );
+			UNIT_TEST( u, reopened.get( 999 ) == ( *input )[ 999 ] );
+		}
+	}
+	const packed_integers runs( sorted.data(), sorted.size() );
+	UNIT_TEST( u, runs.view().count_runs() == 4 );
+	UNIT_TEST( u, packed_integers( exponents.data(), exponents.size() ).view().count_runs() == 1000 );
+
+	bool caught = false;
+	try
+	{
+		const packed_integers_view truncated( runs.get_words().data(), runs.get_words().size() - 1 );
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+	caught = false;
+	try
+	{
+		runs.view().get( 1000 );
+	}
+	catch ( const std::out_of_range & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+
+	// A count of 2^59 at 32 bits each would need 2^64 bits, which wraps to 0 payload words if unchecked.
+	std::vector< std::uint64_t > huge_count = packed_integers( sorted.data(), sorted.size(),
+		integer_encoding::bit_packed ).get_words();
+	huge_count.resize( packed_integers_view::header_words );
+	huge_count[ 0 ] = static_cast< std::uint64_t >( integer_encoding::bit_packed ) | ( 32ULL << 8 );
+	huge_count[ 1 ] = 1ULL << 59;
+	huge_count[ 3 ] = packed_integers_view::header_words;
+	caught = false;
+	try
+	{
+		const packed_integers_view overflowed( huge_count.data(), huge_count.size() );
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+
+	// Point the first index past the 3 dictionary entries, which start the payload in 2 words.
+	std::vector< std::uint64_t > bad_index = packed_integers( scattered.data(), scattered.size(),
+		integer_encoding::dictionary ).get_words();
+	bad_index[ packed_integers_view::header_words + 2 ] |= 3;
+	const packed_integers_view bad_dictionary( bad_index.data(), bad_index.size() );
+	caught = false;
+	try
+	{
+		bad_dictionary.get( 0 );
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+	caught = false;
+	try
+	{
+		std::vector< int > decoded( 4 );
+		bad_dictionary.decode( 0, 4, decoded.data() );
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+
+	// End the last of the 4 runs at 900 instead of 1000.
+	std::vector< std::uint64_t > short_runs = runs.get_words();
+	std::uint64_t & last_end = short_runs[ packed_integers_view::header_words + 1 ];
+	last_end = ( last_end & 0xFFFFFFFFULL ) | ( 900ULL << 32 );
+	const packed_integers_view bad_runs( short_runs.data(), short_runs.size() );
+	UNIT_TEST( u, bad_runs.get( 899 ) == sorted[ 899 ] );
+	caught = false;
+	try
+	{
+		bad_runs.get( 950 );
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+	std::vector< int > short_decoded( 200 );
+	bad_runs.decode( 700, 200, short_decoded.data() );
+	UNIT_TEST( u, short_decoded[ 199 ] == sorted[ 899 ] );
+	caught = false;
+	try
+	{
+		bad_runs.decode( 800, 200, short_decoded.data() );
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+}
+
+// ----------------------------------------------------------------------------
+
+void TestCompressedColumn()
+{
+    ut::UnitTestSet & uts = ut::UnitTestSet::GetIt();
+    ut::UnitTest * u = uts.AddUnitTest( "Compressed_Column" );
+
+	significant_column column;
+	for ( long ii = 0; ii < 1000; ++ii )
+	{
+		column.push_back( measured_value( 20.0L + static_cast< long double >( ii % 200 ) * 0.5L, 4 ) );
+	}
+	const compressed_column compressed( column.view() );
+	UNIT_TEST( u, compressed.size() == 1000 );
+	UNIT_TEST( u, compressed.get_byte_count() < column.size() * ( sizeof( long double ) + 1 ) );
+	UNIT_TEST( u, compressed.get_digit_counts().count_equal( 4 ) == 1000 );
+	UNIT_TEST( u, compressed.get_most_sigdig_exponents().minimum() == 1 );
+	UNIT_TEST( u, compressed.get_most_sigdig_exponents().maximum() == 2 );
+	UNIT_TEST( u, compressed.get_digit_count( 7 ) == 4 );
+	UNIT_TEST( u, compressed.get( 150 ).to_string() == column.get( 150 ).to_string() );
+
+	significant_column decoded;
+	compressed.decode( 100, 500, decoded );
+	UNIT_TEST( u, decoded.size() == 500 );
+	bool same = true;
+	for ( std::size_t ii = 0; ii < decoded.size(); ++ii )
+	{
+		same = same && ( decoded.view().get_exact_value( ii ) == column.view().get_exact_value( ii + 100 ) )
+			&& ( decoded.view().get_digit_count( ii ) == column.view().get_digit_count( ii + 100 ) )
+			&& ( decoded.view().get_most_sigdig_exponent( ii ) == column.view().get_most_sigdig_exponent( ii + 100 ) );
+	}
+	UNIT_TEST( u, same );
+
+	bool caught = false;
+	try
+	{
+		compressed.decode( 900, 200, decoded );
+	}
+	catch ( const std::out_of_range & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+}
+
+// ----------------------------------------------------------------------------
+
+void TestFormula()
+{
+    ut::UnitTestSet & uts = ut::UnitTestSet::GetIt();
+    ut::UnitTest * u = uts.AddUnitTest( "Formula" );
+
+	// Use more rows than one block so the blocks are stitched together.
+	const std::size_t count = formula::block_size * 2 + 37;
+	significant_column p1;
+	significant_column p2;
+	significant_column t;
+	for ( std::size_t ii = 0; ii < count; ++ii )
+	{
+		const long double x = static_cast< long double >( ii );
+		p1.push_back( calculated_value( 1.0L + x * 0.37L, 3 + ii % 5 ) );
+		p2.push_back( calculated_value( 100.0L + x * 1.3L, 4 + ii % 3 ) );
+		t.push_back( calculated_value( 0.5L + x * 0.01L, 2 + ii % 4 ) );
+	}
+
+	const formula rate( "(p2 - p1) * k / t" );
+	UNIT_TEST( u, rate.get_variable_names().size() == 4 );
+	UNIT_TEST( u, rate.get_variable_names()[ 0 ] == "p2" );
+	UNIT_TEST( u, rate.find_variable( "k" ) == 2 );
+	UNIT_TEST( u, rate.find_variable( "q" ) == 4 );
+	UNIT_TEST( u, rate.get_instruction_count() == 3 );
+	UNIT_TEST( u, rate.get_register_count() == 1 );
+	significant_column result;
+	rate.evaluate( { p2.view(), p1.view(), t.view(), t.view() }, result );
+	UNIT_TEST( u, result.size() == count );
+	bool same = true;
+	for ( std::size_t ii = 0; ii < count; ++ii )
+	{
+		const calculated_value expected = ( p2.get( ii ) - p1.get( ii ) ) * t.get( ii ) / t.get( ii );
+		const calculated_value actual = result.get( ii );
+		same = same && ( actual.get_exact_value() == expected.get_exact_value() )
+			&& ( actual.get_digit_count() == expected.get_digit_count() )
+			&& ( actual.get_most_sigdig_exponent() == expected.get_most_sigdig_exponent() );
+	}
+	UNIT_TEST( u, same );
+
+	// The numbers are defined values, and (1.5 + 0.5) folds into one number.
+	const formula scaled( "-(p2 - p1) * (1.5 + 0.5) / t + 10 - 3 * p1" );
+	UNIT_TEST( u, scaled.get_instruction_count() == 7 );
+	scaled.evaluate( { p2.view(), p1.view(), t.view() }, result );
+	same = true;
+	for ( std::size_t ii = 0; ii < count; ++ii )
+	{
+		const calculated_value difference = -( p2.get( ii ) - p1.get( ii ) );
+		const calculated_value expected = difference * defined_value( 2.0L ) / t.get( ii ) +
+			defined_value( 10.0L ) - defined_value( 3.0L ) * p1.get( ii );
+		const calculated_value actual = result.get( ii );
+		same = same && ( actual.get_exact_value() == expected.get_exact_value() )
+			&& ( actual.get_digit_count() == expected.get_digit_count() )
+			&& ( actual.get_most_sigdig_exponent() == expected.get_most_sigdig_exponent() );
+	}
+	UNIT_TEST( u, same );
+
+	const formula single( " t " );
+	single.evaluate( { t.view() }, result );
+	UNIT_TEST( u, result.size() == count );
+	UNIT_TEST( u, result.get( 5 ).to_string() == t.get( 5 ).to_string() );
+
+	const formula inverse( "1 / t" );
+	significant_column zero;
+	zero.push_back( calculated_value( 0.0L, 2 ) );
+	bool caught = false;
+	try
+	{
+		inverse.evaluate( { zero.view() }, result );
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+
+	caught = false;
+	try
+	{
+		rate.evaluate( { p2.view(), p1.view() }, result );
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+
+	const char * const bad[] = { "", "p1 +", "(p1 - p2", "p1 $ p2", "3 + 4", "p1 / (2 - 2)", "p1 * 1e", "p1 p2" };
+	for ( const char * expression : bad )
+	{
+		caught = false;
+		try
+		{
+			formula broken( expression );
+		}
+		catch ( const std::invalid_argument & )
+		{
+			caught = true;
+		}
+		UNIT_TEST( u, caught );
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+void TestStreamPipeline()
+{
+    ut::UnitTestSet & uts = ut::UnitTestSet::GetIt();
+    ut::UnitTest * u = uts.AddUnitTest( "Stream_Pipeline" );
+
+	// Use small blocks and queues so the stages have to wait on each other.
+	std::string text;
+	std::vector< measured_value > expected;
+	for ( std::size_t ii = 0; ii < 5000; ++ii )
+	{
+		const std::string number = std::to_string( ii % 97 ) + "." + std::to_string( 10 + ii % 83 );
+		text += number;
+		text += ( ii % 7 == 0 ) ? "\n" : "  ";
+		expected.push_back( measured_value( number ) );
+	}
+
+	const defined_value factor( 2.5L );
+	const stream_pipeline doubler(
+		[ &factor ]( const column_view & input, significant_column & output )
+		{
+			batch::multiply( input, factor, output );
+		}, format_spec(), 64, 2 );
+	UNIT_TEST( u, doubler.get_block_size() == 64 );
+	UNIT_TEST( u, doubler.get_queue_depth() == 2 );
+	std::istringstream input( text );
+	std::ostringstream output;
+	UNIT_TEST( u, doubler.run( input, output ) == expected.size() );
+	std::istringstream lines( output.str() );
+	std::string line;
+	std::size_t count = 0;
+	bool same = true;
+	while ( std::getline( lines, line ) )
+	{
+		same = same && ( count < expected.size() ) &&
+			( line == ( expected[ count ] * factor ).to_string() );
+		++count;
+	}
+	UNIT_TEST( u, same );
+	UNIT_TEST( u, count == expected.size() );
+
+	std::istringstream empty( "  \n " );
+	std::ostringstream nothing;
+	UNIT_TEST( u, doubler.run( empty, nothing ) == 0 );
+	UNIT_TEST( u, nothing.str().empty() );
+
+	bool caught = false;
+	try
+	{
+		std::istringstream bad( "1.5 2.5 hello 3.5" );
+		doubler.run( bad, nothing );
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+
+	const stream_pipeline failing(
+		[]( const column_view &, significant_column & )
+		{
+			throw std::domain_error( "calculation failed" );
+		}, format_spec(), 4, 1 );
+	caught = false;
+	try
+	{
+		std::istringstream many( text );
+		failing.run( many, nothing );
+	}
+	catch ( const std::domain_error & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+
+	caught = false;
+	try
+	{
+		const stream_pipeline broken( stream_pipeline::calculation(), format_spec(), 0, 1 );
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+}
+
+// ----------------------------------------------------------------------------
+
+void TestMemoryResources()
+{
+    ut::UnitTestSet & uts = ut::UnitTestSet::GetIt();
+    ut::UnitTest * u = uts.AddUnitTest( "Memory_Resources" );
+
+	std::array< char, 4096 > buffer;
+	std::pmr::monotonic_buffer_resource arena( buffer.data(), buffer.size(),
+		std::pmr::null_memory_resource() );
+	// Anything that falls back to the default resource fails while this is set.
+	std::pmr::memory_resource * const previous =
+		std::pmr::set_default_resource( std::pmr::null_memory_resource() );
+
+	const measured_value avogadro( "6.02E+23" );
+	const std::pmr::string fixed = avogadro.to_string( &arena );
+	UNIT_TEST( u, fixed.get_allocator().resource() == &arena );
+	const std::pmr::string exponent = avogadro.to_string( &arena, 5, format_style::decimal_exponent );
+	const defined_value pi( 3.14159265358979L );
+	const std::pmr::string digits = pi.to_string( &arena, 20 );
+
+	significant_column column( &arena );
+	column.push_back( avogadro );
+	column.push_back( measured_value( "-0.0050" ) );
+	UNIT_TEST( u, column.get_memory_resource() == &arena );
+	const significant_column copied( column.view(), &arena );
+	std::pmr::vector< std::pmr::string > strings( &arena );
+	format_spec( format_style::decimal_fixed ).format( copied.view(), strings );
+
+	std::pmr::set_default_resource( previous );
+
+	UNIT_TEST( u, fixed.c_str() == avogadro.to_string() );
+	UNIT_TEST( u, exponent.c_str() == avogadro.to_string( 5, format_style::decimal_exponent ) );
+	UNIT_TEST( u, digits.c_str() == pi.to_string( 20 ) );
+	UNIT_TEST( u, copied.size() == 2 );
+	UNIT_TEST( u, copied.get_memory_resource() == &arena );
+	UNIT_TEST( u, strings.size() == 2 );
+	UNIT_TEST( u, strings[ 0 ].c_str() == avogadro.to_string() );
+	UNIT_TEST( u, strings[ 1 ] == "-0.0050" );
+	UNIT_TEST( u, strings[ 0 ].get_allocator().resource() == &arena );
+
+	const significant_column plain;
+	UNIT_TEST( u, plain.get_memory_resource() == std::pmr::get_default_resource() );
+
+	bool caught = false;
+	try
+	{
+		avogadro.to_string( nullptr, 3 );
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+	caught = false;
+	try
+	{
+		const significant_column orphan( nullptr );
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+}
+
+// ----------------------------------------------------------------------------
@@ -9,6 +9,7 @@ void TestRounding();
 void TestSigDigCounting();
 void TestStringDigitCounting();
 void TestComparisons();
+void TestPrecisionDispatch();
 
 void TestDefinedValueBasics();
 void TestDefinedStringOutput();
@@ -22,3 +23,31 @@ void TestDefinedSubtraction();
 void TestDefinedMultiplication();
 void TestDefinedDivision();
 void TestDefinedPowers();
+
+void TestColumnBasics();
+void TestBatchArithmetic();
+void TestColumnFile();
+void TestPackedIntegers();
+void TestCompressedColumn();
+void TestToleranceIndex();
+void TestToleranceSort();
+void TestToleranceHashMap();
+
+void TestSignificantStats();
+void TestLinearAlgebra();
+void TestPolynomial();
+void TestInterpolationTable();
+void TestDecimalNumber();
+void TestScaledIntegerSums();
+void TestRoundToDigits();
+void TestFormatSpec();
+void TestValueFormatter();
+void TestScalarArithmetic();
+void TestDeferredMetadata();
+void TestTrivialCopies();
+void TestFormula();
+void TestDependencyGraph();
+void TestStreamPipeline();
+void TestOperationCounters();
+void TestPrecisionTelemetry();
+void TestMemoryResources();
@@ -11,6 +11,9 @@
 
 #include <helper.hpp>
 #include <utility.hpp>
+#include <defined_value.hpp>
+#include <measured_value.hpp>
+#include <calculated_value.hpp>
 
 #include <UnitTest.hpp>
 
@@ -695,7 +698,97 @@ void TestSigDigCounting()
 	UNIT_TEST( u, utility::count_significant_digits( 12300000.0L     ) == 3 );
 	UNIT_TEST( u, utility::count_significant_digits( 12000000.0L     ) == 2 );
 	UNIT_TEST( u, utility::count_significant_digits( 10000000.0L     ) == 1 );
+
+	UNIT_TEST( u, utility::count_significant_digits( 9223372036854775807LL ) == 19 );
+	UNIT_TEST( u, utility::count_significant_digits( -9223372036854775807LL - 1 ) == 19 );
+	UNIT_TEST( u, utility::count_significant_digits( 18446744073709551615ULL ) == 20 );
+	UNIT_TEST( u, utility::count_significant_digits( 10000000000000000000ULL ) == 1 );
+	UNIT_TEST( u, utility::count_significant_digits( 12345000000000000ULL ) == 5 );
+	UNIT_TEST( u, utility::count_significant_digits( 99999999999ULL ) == 11 );
+	UNIT_TEST( u, utility::count_significant_digits( 0ULL ) == 1 );
+	UNIT_TEST( u, utility::calculate_exponent( 0ULL ) == 0 );
+	UNIT_TEST( u, utility::calculate_exponent( 9ULL ) == 0 );
+	UNIT_TEST( u, utility::calculate_exponent( 10ULL ) == 1 );
+	UNIT_TEST( u, utility::calculate_exponent( 9999999999ULL ) == 9 );
+	UNIT_TEST( u, utility::calculate_exponent( 10000000000UL ) == 10 );
+	UNIT_TEST( u, utility::calculate_exponent( -123456789012345LL ) == 14 );
+	UNIT_TEST( u, utility::calculate_exponent( 18446744073709551615ULL ) == 19 );
+	bool all_match = true;
+	unsigned long long power = 1;
+	for ( int exponent = 0; exponent < 20; ++exponent, power *= 10 )
+	{
+		all_match = all_match && ( utility::calculate_exponent( power ) == exponent )
+			&& ( utility::calculate_exponent( power - 1 ) == ( ( exponent == 0 ) ? 0 : exponent - 1 ) )
+			&& ( utility::count_significant_digits( power ) == 1 );
+	}
+	UNIT_TEST( u, all_match );
+
+	const measured_value big( 123456789012345000LL );
+	UNIT_TEST( u, big.get_digit_count() == 15 );
+	UNIT_TEST( u, big.get_most_sigdig_exponent() == 17 );
+	const measured_value counter( 4200ULL, 4 );
+	UNIT_TEST( u, counter.get_least_sigdig_exponent() == 0 );
+	UNIT_TEST( u, defined_value( 5000000000LL ).get_value() == 5000000000.0L );
+
+#ifdef __SIZEOF_INT128__
+	const unsigned __int128 huge = static_cast< unsigned __int128 >( 18446744073709551615ULL ) * 1000000ULL;
+	UNIT_TEST( u, utility::calculate_exponent( huge ) == 25 );
+	UNIT_TEST( u, utility::count_significant_digits( huge ) == 20 );
+	UNIT_TEST( u, utility::count_significant_digits( -static_cast< __int128 >( huge ) ) == 20 );
+	const calculated_value wide( static_cast< __int128 >( huge ) );
+	UNIT_TEST( u, wide.get_most_sigdig_exponent() == 25 );
+	UNIT_TEST( u, wide.get_digit_count() == 20 );
+#endif
 }
 
 // ----------------------------------------------------------------------------
 
+void TestPrecisionDispatch()
+{
+    ut::UnitTestSet & uts = ut::UnitTestSet::GetIt();
+    ut::UnitTest * u = uts.AddUnitTest( "Precision Dispatch" );
+
+	UNIT_TEST( u, helper::count_lost_bits( 0.0L, 1.0L ) == 0 );
+	UNIT_TEST( u, helper::count_lost_bits( 0.5L, 0.479L ) == 1 );
+	UNIT_TEST( u, helper::count_lost_bits( 100.0L, 0.5L ) == 13 );
+	UNIT_TEST( u, helper::count_lost_bits( 1.5L, 1000.0L ) == 9 );
+
+	// Few digits are worked out as a double, which stops at 53 bits.
+	const long double quarter_pi = 0.785398163397448309616L;
+	const auto sine = []( auto x ) { return std::sin( x ); };
+	UNIT_TEST( u, helper::calculate_at_precision( quarter_pi, 4, sine ) == std::sin( static_cast< double >( quarter_pi ) ) );
+	UNIT_TEST( u, helper::calculate_at_precision( quarter_pi, 13, sine ) == std::sin( quarter_pi ) );
+	// Close to a root, a double does not have enough bits left, so this uses long double.
+	UNIT_TEST( u, helper::calculate_at_precision( 3.14159265L, 9, sine ) == std::sin( 3.14159265L ) );
+	UNIT_TEST( u, helper::calculate_at_precision( 0.0L, 4, sine ) == 0.0L );
+
+	// Each result must be within a hundredth of a unit in its last significant digit of the long double result.
+	// The angles come close to several roots and poles, and to the largest arguments where range reduction
+	// loses bits.
+	unsigned int misses = 0;
+	for ( unsigned int digits = 1; digits <= 16; ++digits )
+	{
+		const long double tolerance = std::pow( 10.0L, -static_cast< int >( digits + helper::guard_digits - 1 ) );
+		for ( int ii = -2000; ii <= 2000; ++ii )
+		{
+			const long double angles[] = { ii * 0.3721L, ii * 1.5707963L, ii * 3.14159265358979L, ii * 0.001L };
+			for ( long double angle : angles )
+			{
+				const measured_value m( angle, digits );
+				const long double results[] = { m.sine().get_exact_value(), m.cosine().get_exact_value(),
+					m.tangent().get_exact_value() };
+				const long double expected[] = { std::sin( angle ), std::cos( angle ), std::tan( angle ) };
+				for ( unsigned int jj = 0; jj < 3; ++jj )
+				{
+					if ( std::abs( results[ jj ] - expected[ jj ] ) > std::abs( expected[ jj ] ) * tolerance )
+					{
+						++misses;
+					}
+				}
+			}
+		}
+	}
+	UNIT_TEST( u, misses == 0 );
+}
+
+// ----------------------------------------------------------------------------
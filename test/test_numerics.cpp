@@ -0,0 +1,1199 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#ifdef __CYGWIN__
+	#undef _REENT_ONLY
+#endif
+
+#include "test_functions.hpp"
+
+#include <utility.hpp>
+#include <defined_value.hpp>
+#include <measured_value.hpp>
+#include <calculated_value.hpp>
+#include <significant_column.hpp>
+#include <batch.hpp>
+#include <significant_stats.hpp>
+#include <linear_algebra.hpp>
+#include <polynomial.hpp>
+#include <interpolation_table.hpp>
+#include <dependency_graph.hpp>
+#include <operation_counters.hpp>
+#include <precision_telemetry.hpp>
+#include <decimal_number.hpp>
+#include <format_spec.hpp>
+
+// The tests do not link to the fmt library, so use it as header only.
+#define FMT_HEADER_ONLY
+#include <significant_format.hpp>
+
+#include <UnitTest.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ut;
+using namespace sigdig;
+
+#ifdef SIGDIG_FORMAT_NAMESPACE
+// Compile time format string checks need formatters made in constant expressions.
+static_assert( []() { value_formatter< significant_value > f; ( void )f; return true; }(),
+	"Error! value_formatter must be constexpr constructible." );
+#endif
+
+// ----------------------------------------------------------------------------
+
+void TestSignificantStats()
+{
+    ut::UnitTestSet & uts = ut::UnitTestSet::GetIt();
+    ut::UnitTest * u = uts.AddUnitTest( "Significant_Stats" );
+
+	significant_stats stats;
+	UNIT_TEST( u, stats.empty() );
+	bool caught = false;
+	try
+	{
+		stats.get_mean();
+	}
+	catch ( const std::domain_error & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+
+	const measured_value a( "21.4" );
+	const measured_value b( "22.06" );
+	const measured_value c( "19.9" );
+	const measured_value d( "23.15" );
+	stats.add( a );
+	caught = false;
+	try
+	{
+		stats.get_variance();
+	}
+	catch ( const std::domain_error & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+	stats.add( b );
+	stats.add( c );
+	stats.add( d );
+	UNIT_TEST( u, stats.size() == 4 );
+	UNIT_TEST( u, stats.get_least_sigdig_exponent() == -1 );
+	UNIT_TEST( u, stats.get_min_digit_count() == 3 );
+
+	const calculated_value sum = a + b + c + d;
+	const calculated_value mean = sum / defined_value( 4L );
+	UNIT_TEST( u, utility::are_nearly_equal( stats.get_sum().get_exact_value(), sum.get_exact_value() ) );
+	UNIT_TEST( u, stats.get_sum().get_digit_count() == sum.get_digit_count() );
+	UNIT_TEST( u, utility::are_nearly_equal( stats.get_mean().get_exact_value(), mean.get_exact_value() ) );
+	UNIT_TEST( u, stats.get_mean().get_digit_count() == mean.get_digit_count() );
+	UNIT_TEST( u, stats.get_mean().get_most_sigdig_exponent() == mean.get_most_sigdig_exponent() );
+	UNIT_TEST( u, stats.get_minimum().to_string() == "19.9" );
+	UNIT_TEST( u, stats.get_maximum().to_string() == "23.15" );
+
+	const long double m = ( 21.4L + 22.06L + 19.9L + 23.15L ) / 4.0L;
+	const long double variance = ( ( 21.4L - m ) * ( 21.4L - m ) + ( 22.06L - m ) * ( 22.06L - m )
+		+ ( 19.9L - m ) * ( 19.9L - m ) + ( 23.15L - m ) * ( 23.15L - m ) ) / 3.0L;
+	UNIT_TEST( u, utility::are_nearly_equal( stats.get_variance().get_exact_value(), variance ) );
+	UNIT_TEST( u, utility::are_nearly_equal( stats.get_standard_deviation().get_exact_value(), std::sqrt( variance ) ) );
+	UNIT_TEST( u, stats.get_variance().get_digit_count() == 3 );
+
+	significant_stats first;
+	significant_stats second;
+	first.add( a );
+	first.add( b );
+	second.add( c );
+	second.add( d );
+	first.merge( second );
+	UNIT_TEST( u, first.size() == 4 );
+	UNIT_TEST( u, utility::are_nearly_equal( first.get_mean().get_exact_value(), stats.get_mean().get_exact_value() ) );
+	UNIT_TEST( u, utility::are_nearly_equal( first.get_variance().get_exact_value(), variance ) );
+	UNIT_TEST( u, first.get_minimum().to_string() == "19.9" );
+	UNIT_TEST( u, first.get_least_sigdig_exponent() == stats.get_least_sigdig_exponent() );
+
+	significant_column column;
+	column.push_back( a );
+	column.push_back( b );
+	column.push_back( c );
+	column.push_back( d );
+	significant_stats from_column;
+	from_column.add( column.view() );
+	UNIT_TEST( u, utility::are_nearly_equal( from_column.get_variance().get_exact_value(), variance ) );
+	from_column.clear();
+	UNIT_TEST( u, from_column.empty() );
+}
+
+// ----------------------------------------------------------------------------
+
+significant_column MakeMatrixValues( std::size_t count, unsigned int seed )
+{
+	significant_column column;
+	unsigned int state = seed;
+	for ( std::size_t ii = 0; ii < count; ++ii )
+	{
+		state = state * 1103515245U + 12345U;
+		const long double value = static_cast< long double >( ( state >> 8 ) % 19999 ) * 0.001L + 0.001L;
+		const unsigned int digits = 2 + ( state >> 4 ) % 4;
+		column.push_back( measured_value( value, digits ) );
+	}
+	return column;
+}
+
+// ----------------------------------------------------------------------------
+
+calculated_value ChainDotProduct( const column_view & left, std::size_t left_first, std::size_t left_step,
+	const column_view & right, std::size_t right_first, std::size_t right_step, std::size_t count )
+{
+	calculated_value sum = left.get( left_first ) * right.get( right_first );
+	for ( std::size_t ii = 1; ii < count; ++ii )
+	{
+		sum = sum + left.get( left_first + ii * left_step ) * right.get( right_first + ii * right_step );
+	}
+	return sum;
+}
+
+// ----------------------------------------------------------------------------
+
+void TestLinearAlgebra()
+{
+    ut::UnitTestSet & uts = ut::UnitTestSet::GetIt();
+    ut::UnitTest * u = uts.AddUnitTest( "Linear_Algebra" );
+
+	significant_column x;
+	x.push_back( measured_value( "1.25" ) );
+	x.push_back( measured_value( "-3.0" ) );
+	x.push_back( measured_value( "0.0042" ) );
+	significant_column y;
+	y.push_back( measured_value( "2.0" ) );
+	y.push_back( measured_value( "4.125" ) );
+	y.push_back( measured_value( "150" ) );
+	const calculated_value dot = linear_algebra::dot( x.view(), y.view() );
+	const calculated_value expected = ChainDotProduct( x.view(), 0, 1, y.view(), 0, 1, 3 );
+	UNIT_TEST( u, dot.get_exact_value() == expected.get_exact_value() );
+	UNIT_TEST( u, dot.get_digit_count() == expected.get_digit_count() );
+	UNIT_TEST( u, dot.get_least_sigdig_exponent() == expected.get_least_sigdig_exponent() );
+
+	// The factors' exponents add up to just under the highest exponent, which is past the end of the lookup table.
+	significant_column huge_x;
+	huge_x.push_back( measured_value( "3.0E+2466" ) );
+	significant_column huge_y;
+	huge_y.push_back( measured_value( "3.0E+2465" ) );
+	const calculated_value huge = linear_algebra::dot( huge_x.view(), huge_y.view() );
+	UNIT_TEST( u, huge.get_most_sigdig_exponent() == 4931 );
+	UNIT_TEST( u, huge.get_digit_count() == 2 );
+
+	const std::size_t rows = 70;
+	const std::size_t inner = 75;
+	const std::size_t columns = 67;
+	const significant_column a = MakeMatrixValues( rows * inner, 21 );
+	const significant_column b = MakeMatrixValues( inner * columns, 33 );
+	const matrix_view left( a.view(), rows, inner );
+	const matrix_view right( b.view(), inner, columns );
+	significant_column product;
+	linear_algebra::gemm( left, right, product );
+	UNIT_TEST( u, product.size() == rows * columns );
+	bool same = true;
+	for ( std::size_t row = 0; row < rows; row += 7 )
+	{
+		for ( std::size_t column = 0; column < columns; column += 11 )
+		{
+			const calculated_value chained = ChainDotProduct( a.view(), row * inner, 1, b.view(), column, columns, inner );
+			const calculated_value element = product.get( row * columns + column );
+			same = same && ( element.get_exact_value() == chained.get_exact_value() )
+				&& ( element.get_digit_count() == chained.get_digit_count() )
+				&& ( element.get_most_sigdig_exponent() == chained.get_most_sigdig_exponent() );
+		}
+	}
+	UNIT_TEST( u, same );
+
+	const significant_column v = MakeMatrixValues( inner, 45 );
+	significant_column mv;
+	linear_algebra::gemv( left, v.view(), mv );
+	UNIT_TEST( u, mv.size() == rows );
+	const calculated_value chained = ChainDotProduct( a.view(), 5 * inner, 1, v.view(), 0, 1, inner );
+	UNIT_TEST( u, mv.get( 5 ).get_exact_value() == chained.get_exact_value() );
+	UNIT_TEST( u, mv.get( 5 ).get_digit_count() == chained.get_digit_count() );
+
+	bool caught = false;
+	try
+	{
+		linear_algebra::gemm( right, right, product );
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+	caught = false;
+	try
+	{
+		const matrix_view wrong( a.view(), rows, inner + 1 );
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+}
+
+// ----------------------------------------------------------------------------
+
+void TestPolynomial()
+{
+    ut::UnitTestSet & uts = ut::UnitTestSet::GetIt();
+    ut::UnitTest * u = uts.AddUnitTest( "Polynomial" );
+
+	const polynomial empty;
+	bool caught = false;
+	try
+	{
+		empty.evaluate( measured_value( "1.0" ) );
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+
+	// A thermocouple style curve with defined coefficients.
+	const defined_value d0( 0.5L );
+	const defined_value d1( 25.08355L );
+	const defined_value d2( 0.07860106L );
+	const polynomial defined_curve( std::vector< defined_value >{ d0, d1, d2 } );
+	UNIT_TEST( u, defined_curve.get_term_count() == 3 );
+
+	// A curve with measured coefficients and one defined coefficient.
+	const measured_value m0( "1.20" );
+	const defined_value m1( 3L );
+	const measured_value m2( "0.0452" );
+	const measured_value m3( "0.00031" );
+	polynomial mixed_curve;
+	mixed_curve.add_term( m0 );
+	mixed_curve.add_term( m1 );
+	mixed_curve.add_term( m2 );
+	mixed_curve.add_term( m3 );
+
+	significant_column readings;
+	readings.push_back( measured_value( "1.234" ) );
+	readings.push_back( measured_value( "12.5" ) );
+	readings.push_back( measured_value( "0.98" ) );
+	readings.push_back( measured_value( "40.07" ) );
+	significant_column defined_results;
+	significant_column mixed_results;
+	defined_curve.evaluate( readings.view(), defined_results );
+	mixed_curve.evaluate( readings.view(), mixed_results );
+	UNIT_TEST( u, defined_results.size() == readings.size() );
+
+	bool same = true;
+	for ( std::size_t ii = 0; ii < readings.size(); ++ii )
+	{
+		const calculated_value x = readings.get( ii );
+		const calculated_value defined_chain = ( d2 * x + d1 ) * x + d0;
+		const calculated_value mixed_chain = ( ( m3 * x + m2 ) * x + m1 ) * x + m0;
+		const calculated_value defined_result = defined_results.get( ii );
+		const calculated_value mixed_result = mixed_results.get( ii );
+		same = same && ( defined_result.get_exact_value() == defined_chain.get_exact_value() )
+			&& ( defined_result.get_digit_count() == defined_chain.get_digit_count() )
+			&& ( defined_result.get_most_sigdig_exponent() == defined_chain.get_most_sigdig_exponent() )
+			&& ( mixed_result.get_exact_value() == mixed_chain.get_exact_value() )
+			&& ( mixed_result.get_digit_count() == mixed_chain.get_digit_count() )
+			&& ( mixed_result.get_most_sigdig_exponent() == mixed_chain.get_most_sigdig_exponent() )
+			&& ( mixed_curve.evaluate( x ).to_string() == mixed_chain.to_string() );
+	}
+	UNIT_TEST( u, same );
+
+	const polynomial constant( std::vector< defined_value >{ d1 } );
+	const calculated_value flat = constant.evaluate( measured_value( "2.50" ) );
+	UNIT_TEST( u, flat.get_exact_value() == d1.get_value() );
+	UNIT_TEST( u, flat.get_digit_count() == 3 );
+}
+
+// ----------------------------------------------------------------------------
+
+void TestInterpolationTable()
+{
+    ut::UnitTestSet & uts = ut::UnitTestSet::GetIt();
+    ut::UnitTest * u = uts.AddUnitTest( "Interpolation_Table" );
+
+	significant_column x;
+	significant_column y;
+	const char * xs[] = { "0.0", "10.0", "20.0", "30.5", "45.00" };
+	const char * ys[] = { "1.00", "3.52", "7.1", "12.45", "20.013" };
+	for ( std::size_t ii = 0; ii < 5; ++ii )
+	{
+		x.push_back( measured_value( xs[ ii ] ) );
+		y.push_back( measured_value( ys[ ii ] ) );
+	}
+	const interpolation_table table( x.view(), y.view() );
+	UNIT_TEST( u, table.size() == 5 );
+	UNIT_TEST( u, table.get_lowest_x() == 0.0L );
+	UNIT_TEST( u, table.get_highest_x() == 45.0L );
+
+	significant_column sorted;
+	const char * queries[] = { "0.75", "4.2", "9.99", "12.5", "19.25", "25.0", "33.3", "44.12" };
+	for ( const char * query : queries )
+	{
+		sorted.push_back( measured_value( query ) );
+	}
+	significant_column unsorted;
+	for ( std::size_t ii = 0; ii < sorted.size(); ++ii )
+	{
+		unsorted.push_back( sorted.get( ( ii * 5 ) % sorted.size() ) );
+	}
+
+	significant_column sorted_results;
+	significant_column unsorted_results;
+	table.interpolate( sorted.view(), sorted_results );
+	table.interpolate( unsorted.view(), unsorted_results );
+	bool same = true;
+	for ( std::size_t ii = 0; ii < sorted.size(); ++ii )
+	{
+		const calculated_value value = sorted.get( ii );
+		std::size_t segment = 0;
+		while ( x.get( segment + 1 ).get_exact_value() <= value.get_exact_value() )
+		{
+			++segment;
+		}
+		const calculated_value x0 = x.get( segment );
+		const calculated_value x1 = x.get( segment + 1 );
+		const calculated_value y0 = y.get( segment );
+		const calculated_value y1 = y.get( segment + 1 );
+		const calculated_value expected = y0 + ( value - x0 ) * ( y1 - y0 ) / ( x1 - x0 );
+		const calculated_value single = table.interpolate( value );
+		const calculated_value swept = sorted_results.get( ii );
+		same = same && ( single.get_exact_value() == expected.get_exact_value() )
+			&& ( single.get_digit_count() == expected.get_digit_count() )
+			&& ( single.get_most_sigdig_exponent() == expected.get_most_sigdig_exponent() )
+			&& ( swept.to_string() == single.to_string() )
+			&& ( swept.get_exact_value() == single.get_exact_value() );
+	}
+	UNIT_TEST( u, same );
+	bool same_unsorted = true;
+	for ( std::size_t ii = 0; ii < unsorted.size(); ++ii )
+	{
+		same_unsorted = same_unsorted && ( unsorted_results.get( ii ).get_exact_value() ==
+			table.interpolate( unsorted.get( ii ) ).get_exact_value() );
+	}
+	UNIT_TEST( u, same_unsorted );
+
+	bool caught = false;
+	try
+	{
+		table.interpolate( measured_value( "46" ) );
+	}
+	catch ( const std::domain_error & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+	caught = false;
+	try
+	{
+		significant_column reversed;
+		reversed.push_back( x.get( 1 ) );
+		reversed.push_back( x.get( 0 ) );
+		const interpolation_table bad( reversed.view(), reversed.view() );
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+
+	// A zero offset at a breakpoint, or a zero rise on a flat segment, keeps every digit of y0.
+	significant_column flat_x;
+	significant_column flat_y;
+	const char * flat_xs[] = { "1.00", "2.00", "3.00" };
+	const char * flat_ys[] = { "10.00", "20.00", "20.00" };
+	for ( std::size_t ii = 0; ii < 3; ++ii )
+	{
+		flat_x.push_back( measured_value( flat_xs[ ii ] ) );
+		flat_y.push_back( measured_value( flat_ys[ ii ] ) );
+	}
+	const interpolation_table flat( flat_x.view(), flat_y.view() );
+	UNIT_TEST( u, flat.interpolate( measured_value( "1.00" ) ).to_string() == "10.00" );
+	UNIT_TEST( u, flat.interpolate( measured_value( "2.50" ) ).to_string() == "20.00" );
+	significant_column flat_queries;
+	flat_queries.push_back( measured_value( "1.00" ) );
+	flat_queries.push_back( measured_value( "2.50" ) );
+	significant_column flat_results;
+	flat.interpolate( flat_queries.view(), flat_results );
+	UNIT_TEST( u, flat_results.get( 0 ).to_string() == "10.00" );
+	UNIT_TEST( u, flat_results.get( 1 ).get_least_sigdig_exponent() == -2 );
+}
+
+// ----------------------------------------------------------------------------
+
+void TestDecimalNumber()
+{
+    ut::UnitTestSet & uts = ut::UnitTestSet::GetIt();
+    ut::UnitTest * u = uts.AddUnitTest( "Decimal_Number" );
+
+	UNIT_TEST( u, decimal64::get_lowest_exponent() == -398 );
+	UNIT_TEST( u, decimal64::get_highest_exponent() == 369 );
+	UNIT_TEST( u, decimal64().is_zero() );
+	UNIT_TEST( u, decimal64().get_bits() == 0x31C0000000000000ULL );
+
+	// These are the encodings from the IEEE 754 BID format.
+	const decimal64 one( false, 1, 0 );
+	UNIT_TEST( u, one.get_bits() == 0x31C0000000000001ULL );
+	const decimal64 minus_seven( true, 7, 0 );
+	UNIT_TEST( u, minus_seven.get_bits() == 0xB1C0000000000007ULL );
+	const decimal64 largest( false, 9999999999999999ULL, 369 );
+	UNIT_TEST( u, largest.get_bits() == 0x77FB86F26FC0FFFFULL );
+	UNIT_TEST( u, decimal64::from_bits( largest.get_bits() ).get_coefficient() == 9999999999999999ULL );
+	UNIT_TEST( u, decimal64::from_bits( largest.get_bits() ).get_exponent() == 369 );
+
+	const decimal64 a = decimal64::from_string( "-0.00120" );
+	UNIT_TEST( u, a.is_negative() );
+	UNIT_TEST( u, a.get_coefficient() == 120 );
+	UNIT_TEST( u, a.get_exponent() == -5 );
+	UNIT_TEST( u, a.get_digit_count() == 3 );
+	UNIT_TEST( u, a.count_significant_digits() == 3 );
+	UNIT_TEST( u, a.get_most_significant_exponent() == -3 );
+	UNIT_TEST( u, a.to_string() == "-0.00120" );
+	UNIT_TEST( u, a.to_string( format_style::decimal_exponent ) == "-1.20e-03" );
+
+	const char * strings[] = { "1200", "1.20", "120.0", "0.000345", "9.80665", "6.02214e+23",
+		"1.0e-5", "100", "3.141592653589793", "1", "1.20e+3", "0.00", "0e+2" };
+	bool same_digits = true;
+	for ( const char * s : strings )
+	{
+		long double value = 0.0L;
+		unsigned int digits = 0;
+		int exponent = 0;
+		utility::count_digits_in_string( s, value, digits, exponent );
+		const decimal64 d = decimal64::from_string( s );
+		same_digits = same_digits && ( d.count_significant_digits() == digits )
+			&& ( d.get_most_significant_exponent() == exponent )
+			&& ( d.to_long_double() == value );
+	}
+	UNIT_TEST( u, same_digits );
+	UNIT_TEST( u, decimal64::from_string( "1.20" ) == decimal64::from_string( "1.2" ) );
+	UNIT_TEST( u, decimal64::from_string( "1.20" ).to_string() != decimal64::from_string( "1.2" ).to_string() );
+	UNIT_TEST( u, decimal64::from_string( "-3" ) < decimal64::from_string( "-2.99" ) );
+	UNIT_TEST( u, decimal64::from_string( "0.1" ) > decimal64::from_string( "0.0999" ) );
+	UNIT_TEST( u, decimal64::from_string( "0" ) == decimal64::from_string( "-0.00" ) );
+	UNIT_TEST( u, decimal64::from_string( "2.5e+3" ).to_string() == "2500" );
+
+	const decimal64 b = decimal64::from_string( "2.34567" );
+	UNIT_TEST( u, b.round_to_digits( 3 ).to_string() == "2.35" );
+	UNIT_TEST( u, b.round_to_digits( 3, rounding_style::truncate ).to_string() == "2.34" );
+	UNIT_TEST( u, b.round_to_digits( 1, rounding_style::ceiling ).to_string() == "3" );
+	UNIT_TEST( u, decimal64::from_string( "-2.31" ).round_to_digits( 2, rounding_style::floor ).to_string() == "-2.4" );
+	UNIT_TEST( u, decimal64::from_string( "-2.31" ).round_to_digits( 2, rounding_style::ceiling ).to_string() == "-2.3" );
+	UNIT_TEST( u, decimal64::from_string( "-2.31" ).round_to_digits( 2, rounding_style::from_zero ).to_string() == "-2.4" );
+	UNIT_TEST( u, decimal64::from_string( "9.996" ).round_to_digits( 3 ).to_string() == "10.0" );
+	UNIT_TEST( u, decimal64::from_value( 2.0L / 3.0L, 4 ).to_string() == "0.6667" );
+	UNIT_TEST( u, decimal64::from_value( 12345.0L, 2 ).to_string() == "12000" );
+
+	const measured_value m( decimal64::from_string( "0.0450" ) );
+	UNIT_TEST( u, m.get_digit_count() == 3 );
+	UNIT_TEST( u, m.get_most_sigdig_exponent() == -2 );
+	UNIT_TEST( u, m.get_least_sigdig_exponent() == -4 );
+	const measured_value hundreds( decimal64::from_string( "1200" ) );
+	UNIT_TEST( u, hundreds.get_digit_count() == 2 );
+	UNIT_TEST( u, hundreds.get_most_sigdig_exponent() == 3 );
+	UNIT_TEST( u, hundreds.get_least_sigdig_exponent() == 2 );
+	const measured_value thousands( decimal64::from_string( "1.20E+3" ) );
+	UNIT_TEST( u, thousands.get_digit_count() == 3 );
+	UNIT_TEST( u, thousands.get_least_sigdig_exponent() == 1 );
+	const measured_value zero( decimal64::from_string( "0.00" ) );
+	UNIT_TEST( u, zero.get_digit_count() == 3 );
+	UNIT_TEST( u, zero.get_most_sigdig_exponent() == 0 );
+	UNIT_TEST( u, zero.get_least_sigdig_exponent() == -2 );
+	const measured_value zero_hundreds( decimal64::from_string( "0E+2" ) );
+	UNIT_TEST( u, zero_hundreds.get_digit_count() == 1 );
+	UNIT_TEST( u, zero_hundreds.get_least_sigdig_exponent() == 2 );
+
+	bool caught = false;
+	try
+	{
+		decimal64::from_string( "12345678901234567" );
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+	caught = false;
+	try
+	{
+		decimal64::from_bits( 0x7800000000000000ULL );
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+
+#ifdef __SIZEOF_INT128__
+	UNIT_TEST( u, decimal128::get_lowest_exponent() == -6176 );
+	UNIT_TEST( u, decimal128::get_highest_exponent() == 6111 );
+	const decimal128 c = decimal128::from_string( "1.234567890123456789012345678901234" );
+	UNIT_TEST( u, c.count_significant_digits() == 34 );
+	UNIT_TEST( u, c.get_exponent() == -33 );
+	UNIT_TEST( u, c.to_string() == "1.234567890123456789012345678901234" );
+	UNIT_TEST( u, c.round_to_digits( 20 ).to_string() == "1.2345678901234567890" );
+	UNIT_TEST( u, decimal128::from_bits( c.get_bits() ) == c );
+	UNIT_TEST( u, static_cast< unsigned long long >( c.get_bits() >> 64 ) ==
+		( 0x2FFE000000000000ULL | static_cast< unsigned long long >( c.get_coefficient() >> 64 ) ) );
+#endif
+}
+
+// ----------------------------------------------------------------------------
+
+void TestScaledIntegerSums()
+{
+    ut::UnitTestSet & uts = ut::UnitTestSet::GetIt();
+    ut::UnitTest * u = uts.AddUnitTest( "Scaled_Integer_Sums" );
+
+	// A day of readings from one sensor, all with the last digit in the hundredths place.
+	const std::size_t count = 86400;
+	calculated_value total = measured_value( "0.00" ) + measured_value( "0.00" );
+	long long expected_units = 0;
+	for ( std::size_t ii = 0; ii < count; ++ii )
+	{
+		const long long units = 2000 + static_cast< long long >( ( ii * 7919 ) % 1000 );
+		expected_units += units;
+		measured_value reading( static_cast< long double >( units ) / 100.0L, 4 );
+		total += reading;
+	}
+	UNIT_TEST( u, total.get_least_sigdig_exponent() == -2 );
+	UNIT_TEST( u, total.get_exact_value() == static_cast< long double >( expected_units ) / 100.0L );
+	UNIT_TEST( u, total.get_digit_count() == utility::count_significant_digits( expected_units ) + 2 );
+	UNIT_TEST( u, total.get_most_sigdig_exponent() ==
+		utility::calculate_exponent( static_cast< long double >( expected_units ) / 100.0L ) );
+
+	const measured_value a( "0.3" );
+	const measured_value b( "0.1" );
+	const calculated_value sum = a + b;
+	UNIT_TEST( u, sum.get_exact_value() == 0.4L );
+	UNIT_TEST( u, sum.get_digit_count() == 1 );
+	const calculated_value difference = a - b - b - b;
+	UNIT_TEST( u, difference.get_exact_value() == 0.0L );
+	UNIT_TEST( u, difference.get_digit_count() == 1 );
+	UNIT_TEST( u, difference.get_least_sigdig_exponent() == -1 );
+	const calculated_value carry = measured_value( "9.9" ) + measured_value( "0.2" );
+	UNIT_TEST( u, carry.get_digit_count() == 3 );
+	UNIT_TEST( u, carry.get_most_sigdig_exponent() == 1 );
+	UNIT_TEST( u, carry.to_string() == "10.1" );
+
+	// Values which are not whole numbers of units still take the long double path.
+	const calculated_value third = measured_value( "1.00" ) / measured_value( "3.00" );
+	const calculated_value mixed = third + measured_value( "1.00" );
+	UNIT_TEST( u, mixed.get_exact_value() == 1.0L / 3.0L + 1.0L );
+
+	significant_column readings;
+	significant_column offsets;
+	for ( std::size_t ii = 0; ii < 100; ++ii )
+	{
+		readings.push_back( measured_value( static_cast< long double >( 1000 + ii * 37 ) / 100.0L, 4 ) );
+		offsets.push_back( measured_value( static_cast< long double >( 7 + ii ) / 100.0L, 2 ) );
+	}
+	significant_column sums;
+	batch::add( readings.view(), offsets.view(), sums );
+	bool same = true;
+	for ( std::size_t ii = 0; ii < readings.size(); ++ii )
+	{
+		const calculated_value expected = readings.get( ii ) + offsets.get( ii );
+		same = same && ( sums.get( ii ).get_exact_value() == expected.get_exact_value() )
+			&& ( sums.get( ii ).get_digit_count() == expected.get_digit_count() );
+	}
+	UNIT_TEST( u, same );
+}
+
+// ----------------------------------------------------------------------------
+
+void TestRoundToDigits()
+{
+    ut::UnitTestSet & uts = ut::UnitTestSet::GetIt();
+    ut::UnitTest * u = uts.AddUnitTest( "Round_To_Digits" );
+
+	UNIT_TEST( u, utility::round_to_digits( 2.34567L, 3u ) == std::strtold( "2.35", nullptr ) );
+	UNIT_TEST( u, utility::round_to_digits( 2.34567L, 3u, rounding_style::truncate ) == std::strtold( "2.34", nullptr ) );
+	UNIT_TEST( u, utility::round_to_digits( -2.31L, 2u, rounding_style::floor ) == std::strtold( "-2.4", nullptr ) );
+	UNIT_TEST( u, utility::round_to_digits( 98765.0L, 2u ) == 99000.0L );
+	UNIT_TEST( u, utility::round_to_digits( 0.0L, 4u ) == 0.0L );
+
+	// Every rounding style and number of digits must match the string path exactly.
+	unsigned long long state = 88172645463325252ULL;
+	significant_column column;
+	bool same = true;
+	for ( std::size_t ii = 0; ii < 2000; ++ii )
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		const int place = static_cast< int >( state % 40 ) - 20;
+		long double value = static_cast< long double >( state >> 11 ) / 9007199254740992.0L
+			* std::pow( 10.0L, place );
+		if ( ii % 3 == 0 )
+		{
+			value = std::round( value * 1000.0L ) / 1000.0L;
+		}
+		if ( ii % 2 == 1 )
+		{
+			value = -value;
+		}
+		if ( value == 0.0L )
+		{
+			continue;
+		}
+		const measured_value m( value, 20 );
+		column.push_back( m );
+		for ( unsigned int digits = 1; digits <= 20; ++digits )
+		{
+			for ( unsigned int rounding = 0; rounding < 5; ++rounding )
+			{
+				const rounding_style style = static_cast< rounding_style >( rounding );
+				const std::string text = m.to_string( digits, format_style::decimal_fixed, style );
+				const long double expected = std::strtold( text.c_str(), nullptr );
+				same = same && ( m.get_value( digits, style ) == expected )
+					&& ( utility::round_to_digits( value, m.get_most_sigdig_exponent(), digits, style ) == expected );
+			}
+		}
+	}
+	UNIT_TEST( u, same );
+
+	std::vector< long double > rounded( column.size() );
+	std::vector< unsigned int > digits( column.size(), 4 );
+	utility::round_to_digits( column.get_values(), column.get_most_sigdig_exponents(), digits.data(),
+		column.size(), rounding_style::ceiling, rounded.data() );
+	bool same_column = true;
+	for ( std::size_t ii = 0; ii < column.size(); ++ii )
+	{
+		same_column = same_column && ( rounded[ ii ] == column.get( ii ).get_value( 4, rounding_style::ceiling ) );
+	}
+	UNIT_TEST( u, same_column );
+}
+
+// ----------------------------------------------------------------------------
+
+void TestFormatSpec()
+{
+    ut::UnitTestSet & uts = ut::UnitTestSet::GetIt();
+    ut::UnitTest * u = uts.AddUnitTest( "Format_Spec" );
+
+	const measured_value m( "-12.3456" );
+	UNIT_TEST( u, ( m.to_string< format_style::decimal_fixed, rounding_style::round_half >() ) == m.to_string() );
+	UNIT_TEST( u, ( m.to_string< format_style::decimal_exponent, rounding_style::ceiling >( 3 ) ) ==
+		m.to_string( 3, format_style::decimal_exponent, rounding_style::ceiling ) );
+	UNIT_TEST( u, ( m.to_string< format_style::decimal_fixed, rounding_style::floor >( 4, true ) ) ==
+		m.to_string( 4, format_style::decimal_fixed, rounding_style::floor, true ) );
+
+	const char * strings[] = { "0.00120", "-4.5", "987650", "1.0", "-0.999", "31.4159", "2.5E+03", "600" };
+	significant_column column;
+	for ( const char * s : strings )
+	{
+		column.push_back( measured_value( s ) );
+	}
+	bool same = true;
+	for ( unsigned int formatting = 1; formatting <= 2; ++formatting )
+	{
+		for ( unsigned int rounding = 0; rounding < 5; ++rounding )
+		{
+			const format_style f = static_cast< format_style >( formatting );
+			const rounding_style r = static_cast< rounding_style >( rounding );
+			const format_spec spec( f, r, ( rounding % 2 ) == 1 );
+			std::vector< std::string > results;
+			spec.format( column.view(), results );
+			same = same && ( results.size() == column.size() );
+			for ( std::size_t ii = 0; ii < column.size(); ++ii )
+			{
+				const calculated_value value = column.get( ii );
+				const std::string expected = value.to_string( f, r, spec.shows_decimal() );
+				same = same && ( results[ ii ] == expected ) && ( spec.format( value ) == expected )
+					&& ( spec.format( value, 2 ) == value.to_string( 2, f, r, spec.shows_decimal() ) );
+			}
+		}
+	}
+	UNIT_TEST( u, same );
+
+	bool caught = false;
+	try
+	{
+		const format_spec bad( static_cast< format_style >( 7 ) );
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+	caught = false;
+	try
+	{
+		const format_spec hexadecimal( format_style::hexadecimal_exponent, rounding_style::truncate );
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+}
+
+// ----------------------------------------------------------------------------
+
+void TestValueFormatter()
+{
+    ut::UnitTestSet & uts = ut::UnitTestSet::GetIt();
+    ut::UnitTest * u = uts.AddUnitTest( "Value_Formatter" );
+
+	const measured_value m( "-12.3456" );
+	const defined_value d( "0.00250" );
+	const format_spec spec( format_style::decimal_exponent, rounding_style::ceiling, true );
+	char chars[ 64 ];
+	std::size_t size = spec.write( m, chars, sizeof( chars ) );
+	UNIT_TEST( u, std::string( chars, size ) == spec.format( m ) );
+	size = spec.write( m, 2, chars, sizeof( chars ) );
+	UNIT_TEST( u, std::string( chars, size ) == spec.format( m, 2 ) );
+	size = spec.write( d, chars, sizeof( chars ) );
+	UNIT_TEST( u, std::string( chars, size ) == d.to_string( format_style::decimal_exponent, rounding_style::ceiling, true ) );
+
+	bool caught = false;
+	try
+	{
+		spec.write( m, chars, 3 );
+	}
+	catch ( const std::length_error & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+
+#ifdef SIGDIG_FORMAT_NAMESPACE
+	using SIGDIG_FORMAT_NAMESPACE::format;
+	const calculated_value c = m * measured_value( "2.0" );
+	UNIT_TEST( u, format( "{}", m ) == m.to_string() );
+	UNIT_TEST( u, format( "{}", c ) == c.to_string() );
+	UNIT_TEST( u, format( "{}", d ) == d.to_string() );
+	UNIT_TEST( u, format( "{:e}", m ) == m.to_string( format_style::decimal_exponent ) );
+	UNIT_TEST( u, format( "{:.3ue}", m ) == m.to_string( 3, format_style::decimal_exponent, rounding_style::ceiling ) );
+	UNIT_TEST( u, format( "{:#.2t}", m ) == m.to_string( 2, format_style::decimal_fixed, rounding_style::truncate, true ) );
+	UNIT_TEST( u, format( "[{:.1z}]", d ) == "[" + d.to_string( 1, format_style::decimal_fixed, rounding_style::from_zero ) + "]" );
+	UNIT_TEST( u, format( "{} and {:d}", m, c ) ==
+		m.to_string() + " and " + c.to_string( format_style::decimal_fixed, rounding_style::floor ) );
+
+	caught = false;
+	try
+	{
+		const std::string bad = SIGDIG_FORMAT_NAMESPACE::vformat( "{:.3q}", SIGDIG_FORMAT_NAMESPACE::make_format_args( m ) );
+	}
+	catch ( const SIGDIG_FORMAT_NAMESPACE::format_error & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+	caught = false;
+	try
+	{
+		const std::string bad = SIGDIG_FORMAT_NAMESPACE::vformat( "{:a}", SIGDIG_FORMAT_NAMESPACE::make_format_args( m ) );
+	}
+	catch ( const SIGDIG_FORMAT_NAMESPACE::format_error & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+#endif
+}
+
+// ----------------------------------------------------------------------------
+
+/// Returns true if both values have the same value and significant digits.
+bool AreSameValues( const significant_value & left, const significant_value & right )
+{
+	return ( left.get_exact_value() == right.get_exact_value() )
+		&& ( left.get_digit_count() == right.get_digit_count() )
+		&& ( left.get_most_sigdig_exponent() == right.get_most_sigdig_exponent() )
+		&& ( left.get_least_sigdig_exponent() == right.get_least_sigdig_exponent() );
+}
+
+// ----------------------------------------------------------------------------
+
+void TestScalarArithmetic()
+{
+    ut::UnitTestSet & uts = ut::UnitTestSet::GetIt();
+    ut::UnitTest * u = uts.AddUnitTest( "Scalar_Arithmetic" );
+
+	const measured_value m( "12.34" );
+	UNIT_TEST( u, AreSameValues( m * 1000, m * defined_value( 1000.0L ) ) );
+	UNIT_TEST( u, AreSameValues( m / 4, m / defined_value( 4.0L ) ) );
+	UNIT_TEST( u, AreSameValues( m - 2.5, m - defined_value( 2.5L ) ) );
+	UNIT_TEST( u, AreSameValues( m + 3U, m + defined_value( 3.0L ) ) );
+	UNIT_TEST( u, AreSameValues( m + 0.25F, m + defined_value( 0.25L ) ) );
+	UNIT_TEST( u, AreSameValues( m * -7LL, m * defined_value( -7.0L ) ) );
+	UNIT_TEST( u, ( m * 1000 ).get_digit_count() == 4 );
+	UNIT_TEST( u, ( m + 100 ).get_least_sigdig_exponent() == -2 );
+
+	UNIT_TEST( u, AreSameValues( 2 * m, defined_value( 2.0L ) * m ) );
+	UNIT_TEST( u, AreSameValues( 10.0 - m, defined_value( 10.0L ) - m ) );
+	UNIT_TEST( u, AreSameValues( 1 / m, defined_value( 1.0L ) / m ) );
+	UNIT_TEST( u, AreSameValues( 5L + m, defined_value( 5.0L ) + m ) );
+
+	const calculated_value start = m * measured_value( "2.000" );
+	calculated_value c1 = start;
+	calculated_value c2 = start;
+	c1 *= 3;
+	c2 *= defined_value( 3.0L );
+	UNIT_TEST( u, AreSameValues( c1, c2 ) );
+	c1 /= 8U;
+	c2 /= defined_value( 8.0L );
+	UNIT_TEST( u, AreSameValues( c1, c2 ) );
+	c1 += 0.5;
+	c2 += defined_value( 0.5L );
+	UNIT_TEST( u, AreSameValues( c1, c2 ) );
+	c1 -= 20;
+	c2 -= defined_value( 20.0L );
+	UNIT_TEST( u, AreSameValues( c1, c2 ) );
+
+	bool caught = false;
+	try
+	{
+		c1 /= 0;
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+	caught = false;
+	try
+	{
+		const calculated_value bad = m * std::numeric_limits< double >::quiet_NaN();
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+}
+
+// ----------------------------------------------------------------------------
+
+void TestDeferredMetadata()
+{
+    ut::UnitTestSet & uts = ut::UnitTestSet::GetIt();
+    ut::UnitTest * u = uts.AddUnitTest( "Deferred_Metadata" );
+
+	const long double values[] = { 0.0L, 1.0L, -12.5L, 0.00034L, 6.02214076E23L, -1.0E-300L, 999999.0L };
+	for ( long double value : values )
+	{
+		const measured_value eager( value );
+		const measured_value deferred( value, deferred_metadata() );
+		UNIT_TEST( u, deferred.is_metadata_deferred() );
+		UNIT_TEST( u, deferred.get_exact_value() == value );
+		const measured_value copy( deferred );
+		UNIT_TEST( u, copy.is_metadata_deferred() );
+		// Reading a const value calculates the metadata without storing it, so readers never write.
+		UNIT_TEST( u, AreSameValues( deferred, eager ) );
+		UNIT_TEST( u, deferred.is_metadata_deferred() );
+		UNIT_TEST( u, copy.to_string() == eager.to_string() );
+		UNIT_TEST( u, copy.is_metadata_deferred() );
+		measured_value stored( value, deferred_metadata() );
+		stored.resolve_metadata();
+		UNIT_TEST( u, !stored.is_metadata_deferred() );
+		UNIT_TEST( u, AreSameValues( stored, eager ) );
+
+		// Operators and functions must fill in the metadata before using it.
+		UNIT_TEST( u, AreSameValues( measured_value( value, deferred_metadata() ) * 3, eager * 3 ) );
+		UNIT_TEST( u, AreSameValues( eager + measured_value( value, deferred_metadata() ), eager + eager ) );
+		UNIT_TEST( u, AreSameValues( measured_value( value, deferred_metadata() ).absolute(), eager.absolute() ) );
+		UNIT_TEST( u, measured_value( value, deferred_metadata() ) == eager );
+		UNIT_TEST( u, eager == measured_value( value, deferred_metadata() ) );
+		UNIT_TEST( u, !( measured_value( value, deferred_metadata() ) < eager ) );
+		UNIT_TEST( u, measured_value( value, deferred_metadata() ).get_value() == eager.get_value() );
+	}
+
+	calculated_value c( "1.50" );
+	c.assign( 250.0L, deferred_metadata() );
+	UNIT_TEST( u, c.is_metadata_deferred() );
+	c *= 2;
+	UNIT_TEST( u, !c.is_metadata_deferred() );
+	UNIT_TEST( u, AreSameValues( c, calculated_value( 250.0L ) * 2 ) );
+	c = calculated_value( 0.125L, deferred_metadata() );
+	UNIT_TEST( u, c.is_metadata_deferred() );
+	UNIT_TEST( u, c.get_most_sigdig_exponent() == -1 );
+	UNIT_TEST( u, c.get_least_sigdig_exponent() == -3 );
+
+	bool caught = false;
+	try
+	{
+		const measured_value bad( std::numeric_limits< long double >::infinity(), deferred_metadata() );
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+}
+
+// ----------------------------------------------------------------------------
+
+void TestTrivialCopies()
+{
+    ut::UnitTestSet & uts = ut::UnitTestSet::GetIt();
+    ut::UnitTest * u = uts.AddUnitTest( "Trivial_Copies" );
+
+	const measured_value sources[] = { measured_value( "1.250" ), measured_value( "-0.0030" ),
+		measured_value( 42.0L, deferred_metadata() ) };
+	std::vector< measured_value > copies( sources, sources + 3 );
+	std::vector< measured_value > moved( 3, measured_value( 0L ) );
+	std::memcpy( static_cast< void * >( moved.data() ), copies.data(), sizeof( measured_value ) * copies.size() );
+	bool same = true;
+	for ( std::size_t ii = 0; ii < 3; ++ii )
+	{
+		same = same && AreSameValues( moved[ ii ], sources[ ii ] );
+	}
+	UNIT_TEST( u, same );
+
+	const defined_value defined( 2.5L );
+	defined_value defined_copy( 0.0L );
+	std::memcpy( static_cast< void * >( &defined_copy ), &defined, sizeof( defined_value ) );
+	UNIT_TEST( u, defined_copy == defined );
+
+	measured_value assigned( 0L );
+	assigned.assign( sources[ 0 ] );
+	UNIT_TEST( u, AreSameValues( assigned, sources[ 0 ] ) );
+	calculated_value calculated = sources[ 0 ] * sources[ 1 ];
+	calculated_value calculated_copy( 0L );
+	calculated_copy = calculated;
+	UNIT_TEST( u, AreSameValues( calculated_copy, calculated ) );
+}
+
+// ----------------------------------------------------------------------------
+
+void TestDependencyGraph()
+{
+    ut::UnitTestSet & uts = ut::UnitTestSet::GetIt();
+    ut::UnitTest * u = uts.AddUnitTest( "Dependency_Graph" );
+
+	typedef dependency_graph::operation operation;
+	const measured_value p1( "12.5" );
+	const measured_value p2( "20.25" );
+	const measured_value t( "3.0" );
+	dependency_graph graph;
+	const dependency_graph::node_id in1 = graph.add_input( p1 );
+	const dependency_graph::node_id in2 = graph.add_input( p2 );
+	const dependency_graph::node_id in3 = graph.add_input( t );
+	const dependency_graph::node_id two = graph.add_constant( defined_value( 2.0L ) );
+	const dependency_graph::node_id half = graph.add_constant( defined_value( 0.5L ) );
+	// Operations on only constants become constants.
+	const dependency_graph::node_id one = graph.add_operation( operation::multiply, two, half );
+	UNIT_TEST( u, graph.is_constant( one ) );
+	UNIT_TEST( u, graph.get_constant( one ).get_value() == 1.0L );
+
+	const dependency_graph::node_id rise = graph.add_operation( operation::subtract, in2, in1 );
+	const dependency_graph::node_id rate = graph.add_operation( operation::divide, rise, in3 );
+	const dependency_graph::node_id doubled = graph.add_operation( operation::multiply, two, rate );
+	const dependency_graph::node_id other = graph.add_operation( operation::negate, in3 );
+	UNIT_TEST( u, AreSameValues( graph.get_value( rate ), ( p2 - p1 ) / t ) );
+	UNIT_TEST( u, AreSameValues( graph.get_value( doubled ), defined_value( 2.0L ) * ( ( p2 - p1 ) / t ) ) );
+	UNIT_TEST( u, AreSameValues( graph.get_value( other ), -t ) );
+	UNIT_TEST( u, !graph.is_dirty() );
+
+	// Changing p1 only reaches rise, rate, and doubled.
+	const measured_value p1b( "10.5" );
+	graph.stage_input( in1, p1b );
+	UNIT_TEST( u, graph.is_dirty() );
+	UNIT_TEST( u, graph.propagate() == 3 );
+	UNIT_TEST( u, AreSameValues( graph.get_value( doubled ), defined_value( 2.0L ) * ( ( p2 - p1b ) / t ) ) );
+	UNIT_TEST( u, AreSameValues( graph.get_value( other ), -t ) );
+
+	// Staging both inputs still calculates each dependent once.
+	const measured_value p2b( "30.75" );
+	const measured_value tb( "4.00" );
+	graph.stage_input( in2, p2b );
+	graph.stage_input( in3, tb );
+	UNIT_TEST( u, graph.propagate() == 4 );
+	UNIT_TEST( u, AreSameValues( graph.get_value( rate ), ( p2b - p1b ) / tb ) );
+	UNIT_TEST( u, AreSameValues( graph.get_value( other ), -tb ) );
+
+	// Setting an input to the same value changes nothing.
+	graph.stage_input( in3, tb );
+	UNIT_TEST( u, !graph.is_dirty() );
+
+	// Dividing by zero leaves the node dirty until the input is fixed.
+	graph.stage_input( in3, measured_value( "0.0" ) );
+	bool caught = false;
+	try
+	{
+		graph.propagate();
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+	UNIT_TEST( u, graph.is_dirty() );
+	graph.set_input( in3, t );
+	UNIT_TEST( u, !graph.is_dirty() );
+	UNIT_TEST( u, AreSameValues( graph.get_value( rate ), ( p2b - p1b ) / t ) );
+
+	caught = false;
+	try
+	{
+		graph.stage_input( rate, p1 );
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+	caught = false;
+	try
+	{
+		graph.get_value( graph.size() );
+	}
+	catch ( const std::out_of_range & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+	caught = false;
+	try
+	{
+		graph.add_operation( operation::divide, in1,
+			graph.add_operation( operation::subtract, one, one ) );
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+}
+
+// ----------------------------------------------------------------------------
+
+void TestOperationCounters()
+{
+    ut::UnitTestSet & uts = ut::UnitTestSet::GetIt();
+    ut::UnitTest * u = uts.AddUnitTest( "Operation_Counters" );
+
+	const counter_snapshot before = counter_snapshot::take();
+	const measured_value m( "12.50" );
+	const calculated_value c = m * m;
+	const std::string text = c.to_string() + c.to_string( format_style::decimal_exponent );
+	bool caught = false;
+	try
+	{
+		calculated_value bad( 1.5L, 0 );
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+	const counter_snapshot change = counter_snapshot::take() - before;
+
+	if ( counter_snapshot::is_enabled() )
+	{
+		UNIT_TEST( u, change.get( operation_counter::measured_value_constructions ) >= 1 );
+		UNIT_TEST( u, change.get( operation_counter::calculated_value_constructions ) >= 1 );
+		UNIT_TEST( u, change.get( operation_counter::exponent_calculations ) >= 1 );
+		UNIT_TEST( u, change.get( operation_counter::decimal_fixed_strings ) >= 1 );
+		UNIT_TEST( u, change.get( operation_counter::decimal_exponent_strings ) >= 1 );
+		UNIT_TEST( u, change.get( operation_counter::invalid_digit_counts ) == 1 );
+	}
+	else
+	{
+		for ( std::size_t ii = 0; ii < counter_snapshot::counter_count; ++ii )
+		{
+			UNIT_TEST( u, change.get( static_cast< operation_counter >( ii ) ) == 0 );
+		}
+	}
+
+	UNIT_TEST( u, std::strcmp( counter_snapshot::get_name( operation_counter::exponent_calculations ),
+		"exponent_calculations" ) == 0 );
+	const std::string json = change.to_json();
+	UNIT_TEST( u, json.front() == '{' );
+	UNIT_TEST( u, json.back() == '}' );
+	UNIT_TEST( u, json.find( "\"invalid_digit_counts\":" ) != std::string::npos );
+	const std::string prometheus = change.to_prometheus();
+	UNIT_TEST( u, prometheus.find( "# TYPE sigdig_exponent_calculations_total counter\n" ) != std::string::npos );
+	UNIT_TEST( u, prometheus.find( "\nsigdig_measured_value_constructions_total " ) != std::string::npos );
+}
+
+// ----------------------------------------------------------------------------
+
+void TestPrecisionTelemetry()
+{
+    ut::UnitTestSet & uts = ut::UnitTestSet::GetIt();
+    ut::UnitTest * u = uts.AddUnitTest( "Precision_Telemetry" );
+
+	const unsigned int tag = precision_telemetry::find_tag( "cancellation" );
+	UNIT_TEST( u, tag != precision_telemetry::untagged );
+	UNIT_TEST( u, precision_telemetry::find_tag( "cancellation" ) == tag );
+	const unsigned int inner_tag = precision_telemetry::find_tag( "scaling" );
+	const precision_histograms before = precision_telemetry::take();
+	UNIT_TEST( u, before.get_tag_name( tag ) == "cancellation" );
+	UNIT_TEST( u, before.get_tag_name( precision_telemetry::untagged ) == "untagged" );
+	{
+		precision_telemetry::scope outer( tag );
+		// Subtracting nearly equal values leaves 1 digit of 5.
+		const measured_value a( "1.2345" );
+		const measured_value b( "1.2344" );
+		const calculated_value difference = a - b;
+		UNIT_TEST( u, difference.get_digit_count() == 1 );
+		{
+			precision_telemetry::scope inner( inner_tag );
+			const calculated_value product = a * measured_value( "2.0" );
+			UNIT_TEST( u, product.get_digit_count() == 2 );
+		}
+		calculated_value running( "1.2345" );
+		running -= b;
+	}
+	const precision_histograms after = precision_telemetry::take();
+	const unsigned long long cancelled = after.get_count( tag, digit_operation::subtract, 5, 1 ) -
+		before.get_count( tag, digit_operation::subtract, 5, 1 );
+	const unsigned long long shortened = after.get_count( inner_tag, digit_operation::multiply, 5, 2 ) -
+		before.get_count( inner_tag, digit_operation::multiply, 5, 2 );
+	if ( precision_telemetry::is_enabled() )
+	{
+		UNIT_TEST( u, cancelled == 2 );
+		UNIT_TEST( u, shortened == 1 );
+		UNIT_TEST( u, after.get_loss_count( tag, digit_operation::subtract ) >= 2 );
+		UNIT_TEST( u, after.get_loss_count( tag, digit_operation::multiply ) ==
+			before.get_loss_count( tag, digit_operation::multiply ) );
+		UNIT_TEST( u, after.to_json().find( "\"subtract\":[[5,1," ) != std::string::npos );
+	}
+	else
+	{
+		UNIT_TEST( u, cancelled == 0 );
+		UNIT_TEST( u, shortened == 0 );
+		UNIT_TEST( u, after.get_loss_count( tag, digit_operation::subtract ) == 0 );
+	}
+	const std::string json = after.to_json();
+	UNIT_TEST( u, json.find( "{\"tag\":\"cancellation\"" ) != std::string::npos );
+
+	bool caught = false;
+	try
+	{
+		precision_telemetry::scope unknown( static_cast< unsigned int >( after.get_tag_count() ) + 100 );
+	}
+	catch ( const std::out_of_range & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+	caught = false;
+	try
+	{
+		after.get_count( tag, digit_operation::add, 35, 1 );
+	}
+	catch ( const std::out_of_range & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+}
@@ -0,0 +1,286 @@
+// Copyright Richard D. Sposato (c) 2022
+//
+// Permission to use, copy, modify, distribute and sell this software for any  purpose is hereby granted under
+// the terms stated in the MIT License, provided that the above copyright notice appear in all copies and that
+// both that copyright notice and this permission notice appear in supporting documentation.
+
+#ifdef __CYGWIN__
+	#undef _REENT_ONLY
+#endif
+
+#include "test_functions.hpp"
+
+#include <utility.hpp>
+#include <defined_value.hpp>
+#include <measured_value.hpp>
+#include <calculated_value.hpp>
+#include <significant_column.hpp>
+#include <tolerance_index.hpp>
+#include <tolerance_sort.hpp>
+#include <tolerance_hash_map.hpp>
+#include <significant_hash.hpp>
+
+#include <UnitTest.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+using namespace ut;
+using namespace sigdig;
+
+// ----------------------------------------------------------------------------
+
+significant_column MakeMixedColumn( std::size_t count, unsigned int seed )
+{
+	significant_column column;
+	unsigned int state = seed;
+	for ( std::size_t ii = 0; ii < count; ++ii )
+	{
+		state = state * 1103515245U + 12345U;
+		const long double value = static_cast< long double >( ( state >> 8 ) % 20000 ) * 0.01L - 100.0L;
+		const unsigned int digits = 1 + ( state >> 4 ) % 5;
+		column.push_back( measured_value( value, digits ) );
+	}
+	return column;
+}
+
+// ----------------------------------------------------------------------------
+
+void TestToleranceIndex()
+{
+    ut::UnitTestSet & uts = ut::UnitTestSet::GetIt();
+    ut::UnitTest * u = uts.AddUnitTest( "Tolerance_Index" );
+
+	const tolerance_index none;
+	std::vector< std::size_t > matches;
+	none.find_equal( measured_value( "1.0" ), matches );
+	UNIT_TEST( u, none.empty() );
+	UNIT_TEST( u, matches.empty() );
+
+	const significant_column stored = MakeMixedColumn( 1500, 7 );
+	const significant_column probes = MakeMixedColumn( 300, 11 );
+	const tolerance_index index( stored.view() );
+	UNIT_TEST( u, index.size() == stored.size() );
+
+	bool same = true;
+	for ( std::size_t ii = 0; ii < probes.size(); ++ii )
+	{
+		const calculated_value probe = probes.get( ii );
+		std::vector< std::size_t > expected;
+		for ( std::size_t jj = 0; jj < stored.size(); ++jj )
+		{
+			if ( stored.get( jj ).equals( probe ) )
+			{
+				expected.push_back( jj );
+			}
+		}
+		matches.clear();
+		index.find_equal( probe, matches );
+		std::sort( matches.begin(), matches.end() );
+		same = same && ( matches == expected ) && ( index.count_equal( probe ) == expected.size() );
+	}
+	UNIT_TEST( u, same );
+
+	std::vector< tolerance_index::match > pairs;
+	index.join( probes.view(), pairs );
+	std::size_t expected_pairs = 0;
+	for ( std::size_t ii = 0; ii < probes.size(); ++ii )
+	{
+		for ( std::size_t jj = 0; jj < stored.size(); ++jj )
+		{
+			expected_pairs += stored.get( jj ).equals( probes.get( ii ) ) ? 1 : 0;
+		}
+	}
+	UNIT_TEST( u, pairs.size() == expected_pairs );
+	bool all_equal = true;
+	for ( const tolerance_index::match & pair : pairs )
+	{
+		all_equal = all_equal && stored.get( pair.first ).equals( probes.get( pair.second ) );
+	}
+	UNIT_TEST( u, all_equal );
+
+	significant_column small;
+	small.push_back( measured_value( "1.2" ) );
+	small.push_back( measured_value( "1.25" ) );
+	small.push_back( measured_value( "3" ) );
+	const tolerance_index small_index( small.view() );
+	matches.clear();
+	small_index.find_equal( defined_value( 1.248L ), matches );
+	std::sort( matches.begin(), matches.end() );
+	UNIT_TEST( u, matches.size() == 2 );
+	UNIT_TEST( u, matches[ 0 ] == 0 );
+	UNIT_TEST( u, matches[ 1 ] == 1 );
+	matches.clear();
+	small_index.find_overlapping( 10.0L, 20.0L, matches );
+	UNIT_TEST( u, matches.empty() );
+}
+
+// ----------------------------------------------------------------------------
+
+void TestToleranceSort()
+{
+    ut::UnitTestSet & uts = ut::UnitTestSet::GetIt();
+    ut::UnitTest * u = uts.AddUnitTest( "Tolerance_Sort" );
+
+	const significant_column large = MakeMixedColumn( tolerance_sort::parallel_threshold + 1000, 3 );
+	std::vector< std::size_t > serial;
+	std::vector< std::size_t > parallel;
+	tolerance_sort::sort( large.view(), serial, 1 );
+	tolerance_sort::sort( large.view(), parallel, 4 );
+	UNIT_TEST( u, serial.size() == large.size() );
+	UNIT_TEST( u, serial == parallel );
+	UNIT_TEST( u, !tolerance_sort::is_sorted( large.view() ) );
+
+	significant_column column = MakeMixedColumn( 800, 5 );
+	tolerance_sort::sort( column );
+	UNIT_TEST( u, column.size() == 800 );
+	UNIT_TEST( u, tolerance_sort::is_sorted( column.view() ) );
+
+	std::vector< std::size_t > starts;
+	tolerance_sort::group_equal( column.view(), starts );
+	UNIT_TEST( u, !starts.empty() );
+	UNIT_TEST( u, starts[ 0 ] == 0 );
+	bool mutually_equal = true;
+	bool next_differs = true;
+	for ( std::size_t gg = 0; gg < starts.size(); ++gg )
+	{
+		const std::size_t last = ( gg + 1 < starts.size() ) ? starts[ gg + 1 ] : column.size();
+		for ( std::size_t ii = starts[ gg ]; ii < last; ++ii )
+		{
+			for ( std::size_t jj = ii + 1; jj < last; ++jj )
+			{
+				mutually_equal = mutually_equal && column.get( ii ).equals( column.get( jj ) );
+			}
+		}
+		if ( last < column.size() )
+		{
+			bool equals_all = true;
+			for ( std::size_t ii = starts[ gg ]; ii < last; ++ii )
+			{
+				equals_all = equals_all && column.get( ii ).equals( column.get( last ) );
+			}
+			next_differs = next_differs && !equals_all;
+		}
+	}
+	UNIT_TEST( u, mutually_equal );
+	UNIT_TEST( u, next_differs );
+
+	significant_column other = MakeMixedColumn( 400, 9 );
+	tolerance_sort::sort( other );
+	std::vector< tolerance_sort::match > matches;
+	tolerance_sort::merge_join( column.view(), other.view(), matches );
+	std::size_t expected = 0;
+	for ( std::size_t ii = 0; ii < column.size(); ++ii )
+	{
+		for ( std::size_t jj = 0; jj < other.size(); ++jj )
+		{
+			expected += column.get( ii ).equals( other.get( jj ) ) ? 1 : 0;
+		}
+	}
+	UNIT_TEST( u, matches.size() == expected );
+	bool all_equal = true;
+	for ( const tolerance_sort::match & pair : matches )
+	{
+		all_equal = all_equal && column.get( pair.first ).equals( other.get( pair.second ) );
+	}
+	UNIT_TEST( u, all_equal );
+
+	bool caught = false;
+	try
+	{
+		tolerance_sort::merge_join( large.view(), other.view(), matches );
+	}
+	catch ( const std::invalid_argument & )
+	{
+		caught = true;
+	}
+	UNIT_TEST( u, caught );
+}
+
+// ----------------------------------------------------------------------------
+
+void TestToleranceHashMap()
+{
+    ut::UnitTestSet & uts = ut::UnitTestSet::GetIt();
+    ut::UnitTest * u = uts.AddUnitTest( "Tolerance_Hash_Map" );
+
+	std::unordered_set< measured_value, std::hash< measured_value >, same_representation > exact;
+	exact.insert( measured_value( "1.20" ) );
+	exact.insert( measured_value( "1.20" ) );
+	exact.insert( measured_value( "1.2" ) );
+	UNIT_TEST( u, exact.size() == 2 );
+	UNIT_TEST( u, std::hash< defined_value >()( defined_value( 3.5L ) ) == std::hash< defined_value >()( defined_value( 3.5L ) ) );
+
+	tolerance_hash_map map;
+	UNIT_TEST( u, map.empty() );
+	UNIT_TEST( u, map.find( measured_value( "1.0" ) ) == tolerance_hash_map::npos );
+
+	const significant_column column = MakeMixedColumn( 2000, 13 );
+	std::vector< std::size_t > groups;
+	map.group( column.view(), groups );
+	UNIT_TEST( u, groups.size() == column.size() );
+	UNIT_TEST( u, map.size() < column.size() );
+	int widest = column.view().get_least_sigdig_exponent( 0 );
+	for ( std::size_t ii = 1; ii < column.size(); ++ii )
+	{
+		widest = std::max( widest, column.view().get_least_sigdig_exponent( ii ) );
+	}
+	UNIT_TEST( u, map.get_cell_exponent() == widest );
+
+	bool in_first_equal_group = true;
+	for ( std::size_t ii = 0; ii < column.size(); ++ii )
+	{
+		const calculated_value value = column.get( ii );
+		std::size_t expected = tolerance_hash_map::npos;
+		for ( std::size_t gg = 0; ( gg < map.size() ) && ( expected == tolerance_hash_map::npos ); ++gg )
+		{
+			if ( map.get_key( gg ).equals( value ) )
+			{
+				expected = gg;
+			}
+		}
+		in_first_equal_group = in_first_equal_group && ( groups[ ii ] == expected ) && ( map.find( value ) == expected );
+	}
+	UNIT_TEST( u, in_first_equal_group );
+
+	const measured_value probe( "12.3" );
+	std::vector< std::size_t > found;
+	map.find_all( probe, found );
+	std::size_t expected_count = 0;
+	for ( std::size_t gg = 0; gg < map.size(); ++gg )
+	{
+		expected_count += map.get_key( gg ).equals( probe ) ? 1 : 0;
+	}
+	UNIT_TEST( u, found.size() == expected_count );
+	UNIT_TEST( u, std::is_sorted( found.begin(), found.end() ) );
+
+	tolerance_hash_map widening;
+	const std::size_t fine = widening.find_or_insert( measured_value( "1.234" ) );
+	UNIT_TEST( u, widening.get_cell_exponent() == -3 );
+	const std::size_t coarse = widening.find_or_insert( measured_value( "3.1E+2" ) );
+	UNIT_TEST( u, fine == 0 );
+	UNIT_TEST( u, coarse == 1 );
+	UNIT_TEST( u, widening.get_cell_exponent() == 1 );
+	UNIT_TEST( u, widening.find( measured_value( "1.2" ) ) == 0 );
+	UNIT_TEST( u, widening.find( defined_value( 305.0L ) ) == 1 );
+	UNIT_TEST( u, widening.find( defined_value( 2.0L ) ) == tolerance_hash_map::npos );
+	UNIT_TEST( u, widening.find_or_insert( measured_value( "314" ) ) == 1 );
+	widening.clear();
+	UNIT_TEST( u, widening.empty() );
+
+	// Cell numbers this far from zero are past what a long double holds exactly.
+	tolerance_hash_map huge;
+	const measured_value big( "1234567890123456789012.5" );
+	UNIT_TEST( u, huge.find_or_insert( big ) == 0 );
+	UNIT_TEST( u, huge.find_or_insert( big ) == 0 );
+	UNIT_TEST( u, huge.find_or_insert( measured_value( "1.5" ) ) == 1 );
+	UNIT_TEST( u, huge.find( big ) == 0 );
+	UNIT_TEST( u, huge.find( measured_value( "1234567890123456700000.0" ) ) == tolerance_hash_map::npos );
+	found.clear();
+	huge.find_all( big, found );
+	UNIT_TEST( u, found.size() == 1 );
+}
+
+// ----------------------------------------------------------------------------